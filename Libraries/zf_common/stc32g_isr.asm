@@ -1,13 +1,28 @@
 
+	CSEG AT 018BH	;SPI DMAж
+	LJMP 004BH		;SPI ж (SPI ʹжϷʽ  DMA)
+
+	CSEG AT 0193H	;UART1 DMA TXж
+	LJMP 0023H		;UART1 ж
+	
 	CSEG AT 019BH	;UART1 DMA RXж
 	LJMP 0023H		;UART1 ж
 	
+	CSEG AT 01A3H	;UART2 DMA TXж
+	LJMP 0043H		;UART2 ж
+	
 	CSEG AT 01ABH	;UART2 DMA RXж
 	LJMP 0043H		;UART2 ж
 	
+	CSEG AT 01B3H	;UART3 DMA TXж
+	LJMP 008BH		;UART3 ж
+	
 	CSEG AT 01BBH	;UART3 DMA RXж
 	LJMP 008BH		;UART3 ж
 	
+	CSEG AT 01C3H	;UART4 DMA TXж
+	LJMP 0093H		;UART4 ж
+	
 	CSEG AT 01CBH	;UART4 DMA RXж
 	LJMP 0093H		;UART4 ж
 
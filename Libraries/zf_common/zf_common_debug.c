@@ -50,6 +50,16 @@ uint8                       debug_uart_buffer[DEBUG_RING_BUFFER_LEN];
 
 fifo_struct                 debug_uart_fifo;
 
+#if DEBUG_UART_TX_ASYNC                                                         //  debug uart 첽
+static uint8 xdata          debug_tx_buffer[DEBUG_TX_BUFFER_LEN];               // ͻλ (DMA ֻܷ xdata)
+static vuint16              debug_tx_head = 0;                                  // дλ
+static vuint16              debug_tx_tail = 0;                                  // λ (ڷ͵Ķε)
+static vuint16              debug_tx_count = 0;                                 // еֽ (ڷ͵)
+static vuint16              debug_tx_chunk = 0;                                 // ڷ͵Ķγ 0-DMA 
+static uint8                debug_tx_policy = DEBUG_TX_OVERFLOW_POLICY;
+static debug_tx_stat_struct debug_tx_stat;
+#endif
+
 //static debug_output_struct  debug_output_info;
 static volatile uint8       zf_debug_init_flag = 1;
 static volatile uint8       zf_debug_assert_enable = 1;
@@ -229,6 +239,200 @@ static volatile uint8       zf_debug_assert_enable = 1;
 //}
 
 
+#if DEBUG_UART_TX_ASYNC                                                         //  ֻ첽Ͳű
+//-------------------------------------------------------------------------------------------------------------------
+//      һ DMA 
+// ˵     void
+// ز     void
+// ʹʾ     debug_tx_start();
+// עϢ     ļڲ Ҫڹжϻ DMA TX же
+//              DMA һʱ ʹӷλõдλû򻺳ĩβ
+//-------------------------------------------------------------------------------------------------------------------
+static void debug_tx_start (void)
+{
+    uint16 len;
+
+    if(debug_tx_chunk != 0 || debug_tx_count == 0)
+    {
+        return;
+    }
+
+    len = DEBUG_TX_BUFFER_LEN - debug_tx_tail;                                  // ĩβ
+    if(len > debug_tx_count)
+    {
+        len = debug_tx_count;
+    }
+
+    debug_tx_chunk = len;
+    debug_tx_stat.chunks ++;
+    uart_write_buffer_dma(DEBUG_UART_INDEX, &debug_tx_buffer[debug_tx_tail], len);
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//      ѯ DMA ɲһ
+// ˵     void
+// ز     void
+// ʹʾ     debug_tx_poll();
+// עϢ     ļڲ Ҫڹжʱ
+//              ȴڳռʱʹ  DMA TX ж޷ִʱ (жϻͬж) Ҳܼ
+//-------------------------------------------------------------------------------------------------------------------
+static void debug_tx_poll (void)
+{
+    if(debug_tx_chunk != 0 && uart_query_dma_tx(DEBUG_UART_INDEX))
+    {
+        debug_tx_dma_handler();
+    }
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//      debug  DMA ɴ isr.c жӦжϷ
+// ˵     void
+// ز     void
+// ʹʾ     uart1_dma_tx_irq_handler = debug_tx_dma_handler;
+// עϢ     Ҫ DEBUG_UART_TX_ASYNC 궨ſʹ debug_init ûص
+//              ͷѷ͵һ Ȼһ
+//-------------------------------------------------------------------------------------------------------------------
+void debug_tx_dma_handler (void)
+{
+    debug_tx_tail += debug_tx_chunk;
+    if(debug_tx_tail >= DEBUG_TX_BUFFER_LEN)
+    {
+        debug_tx_tail = 0;
+    }
+    debug_tx_count -= debug_tx_chunk;
+    debug_tx_stat.sent += debug_tx_chunk;
+    debug_tx_chunk = 0;
+
+    debug_tx_start();
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//      д debug ͻλ
+// ˵     *buff       Ҫ͵
+// ˵     len         Ҫ͵ĳ
+// ز     uint16      д뻺ĳ (ģʽ»ʱС len)
+// ʹʾ     debug_tx_write(buff, 10);
+// עϢ     Ҫ DEBUG_UART_TX_ASYNC 궨ſʹ
+//              д  DMA ں̨
+//              ʱʽ Ųµ ȴڳռ
+//              ѭжжԵ (ڼرж) жʹöģʽ
+//-------------------------------------------------------------------------------------------------------------------
+uint16 debug_tx_write (const uint8 *buff, uint16 len)
+{
+    uint16 written = 0;
+    uint16 space;
+    uint8 waited = 0;
+    bit flag;
+
+    while(len)
+    {
+        flag = EA;
+        EA = 0;
+
+        space = DEBUG_TX_BUFFER_LEN - debug_tx_count;
+        if(space == 0)
+        {
+            if(DEBUG_TX_OVERFLOW_DROP == debug_tx_policy)
+            {
+                debug_tx_stat.dropped += len;
+                EA = flag;
+                break;
+            }
+
+            if(!waited && debug_tx_stat.blocked != 0xFFFF)
+            {
+                debug_tx_stat.blocked ++;
+            }
+            waited = 1;
+            debug_tx_poll();
+            EA = flag;                                                          // ȴڼж
+            continue;
+        }
+
+        if(space > len)
+        {
+            space = len;
+        }
+        if(space > DEBUG_TX_BUFFER_LEN - debug_tx_head)                         // дĩβ
+        {
+            space = DEBUG_TX_BUFFER_LEN - debug_tx_head;
+        }
+        memcpy(&debug_tx_buffer[debug_tx_head], buff, space);
+
+        debug_tx_head += space;
+        if(debug_tx_head >= DEBUG_TX_BUFFER_LEN)
+        {
+            debug_tx_head = 0;
+        }
+        debug_tx_count += space;
+        debug_tx_stat.queued += space;
+        if(debug_tx_count > debug_tx_stat.peak)
+        {
+            debug_tx_stat.peak = debug_tx_count;
+        }
+        buff += space;
+        len -= space;
+        written += space;
+
+        debug_tx_start();
+        EA = flag;
+    }
+
+    return written;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//      ȴ debug ͻȫ
+// ˵     void
+// ز     void
+// ʹʾ     debug_tx_flush();
+// עϢ     Ҫ DEBUG_UART_TX_ASYNC 궨ſʹ
+//              ڸλԵҪȷѾĵط жʱҲԵ
+//-------------------------------------------------------------------------------------------------------------------
+void debug_tx_flush (void)
+{
+    bit flag;
+
+    while(debug_tx_count != 0)
+    {
+        flag = EA;
+        EA = 0;
+        debug_tx_poll();
+        EA = flag;
+    }
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//       debug ͻʽ
+// ˵     policy      DEBUG_TX_OVERFLOW_DROP- DEBUG_TX_OVERFLOW_BLOCK-ȴ
+// ز     void
+// ʹʾ     debug_tx_set_policy(DEBUG_TX_OVERFLOW_BLOCK);
+// עϢ     Ҫ DEBUG_UART_TX_ASYNC 궨ſʹ ĬֵΪ DEBUG_TX_OVERFLOW_POLICY
+//-------------------------------------------------------------------------------------------------------------------
+void debug_tx_set_policy (uint8 policy)
+{
+    debug_tx_policy = policy;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//      ȡ debug ͳ
+// ˵     *stat        ͳ
+// ز     void
+// ʹʾ     debug_tx_get_stat(&stat);
+// עϢ     Ҫ DEBUG_UART_TX_ASYNC 궨ſʹ
+//-------------------------------------------------------------------------------------------------------------------
+void debug_tx_get_stat (debug_tx_stat_struct *stat)
+{
+    bit flag;
+
+    flag = EA;
+    EA = 0;
+    debug_tx_stat.pending = debug_tx_count;
+    memcpy(stat, &debug_tx_stat, sizeof(debug_tx_stat_struct));
+    EA = flag;
+}
+#endif
+
 //-------------------------------------------------------------------------------------------------------------------
 //      Դڷͻ
 // ˵     *buff       ݴŵָ
@@ -236,9 +440,18 @@ static volatile uint8       zf_debug_assert_enable = 1;
 // ز     uint32      ʣδ͵ĳ
 // ʹʾ
 // עϢ     Ҫ DEBUG_UART_USE_INTERRUPT 궨ſʹ
+//               DEBUG_UART_TX_ASYNC ʱд뷢ͻ󷵻 ĳȼδ͵ĳ
 //-------------------------------------------------------------------------------------------------------------------
 uint32 debug_send_buffer(const uint8 *buff, uint32 len)
 {
+#if DEBUG_UART_TX_ASYNC
+	if(len > 0xFFFF)
+	{
+		return len - debug_tx_write(buff, 0xFFFF);
+	}
+
+	return len - debug_tx_write(buff, (uint16)len);
+#else
 	if(len > 0xFFFF)
 	{
 		uart_write_buffer(DEBUG_UART_INDEX, buff, 0xFFFF);
@@ -250,6 +463,7 @@ uint32 debug_send_buffer(const uint8 *buff, uint32 len)
 	}
     
     return 0;
+#endif
 }
 
 
@@ -302,7 +516,11 @@ void debug_interrupr_handler (uint8 dat)
 //ضprintf  ֻuint16
 char putchar(char c)
 {
+#if DEBUG_UART_TX_ASYNC
+    debug_tx_write((const uint8 *)&c, 1);//д뷢ͻ  DMA ں̨
+#else
     uart_write_byte(DEBUG_UART_INDEX, c);//ԼʵֵĴڴӡһֽݵĺ滻
+#endif
 
     return c;
 }
@@ -364,6 +582,9 @@ void debug_assert_handler (uint8 pass, char *file, int line)
 
 
 		printf("\r\n %s file %s line %d\r\n", log_str, file, line);
+#if DEBUG_UART_TX_ASYNC
+		debug_tx_flush();                                       // Կܷڹжϻж ȴ
+#endif
 
 
 		system_delay_ms(500);
@@ -464,6 +685,33 @@ void debug_init (void)
         DEBUG_UART_TX_PIN,                                                      //  zf_common_debug.h в鿴Ӧֵ
         DEBUG_UART_RX_PIN);                                                     //  zf_common_debug.h в鿴Ӧֵ
 
+#if DEBUG_UART_TX_ASYNC                                                         //  ֻ첽Ͳű
+    debug_tx_head   = 0;
+    debug_tx_tail   = 0;
+    debug_tx_count  = 0;
+    debug_tx_chunk  = 0;
+    debug_tx_policy = DEBUG_TX_OVERFLOW_POLICY;
+    memset(&debug_tx_stat, 0, sizeof(debug_tx_stat_struct));
+
+	// ô DMA ɻص
+	if(uartx == UART_1)
+    {
+        uart1_dma_tx_irq_handler = debug_tx_dma_handler;
+    }
+    else if(uartx == UART_2)
+    {
+        uart2_dma_tx_irq_handler = debug_tx_dma_handler;
+    }
+    else if(uartx == UART_3)
+    {
+        uart3_dma_tx_irq_handler = debug_tx_dma_handler;
+    }
+    else if(uartx == UART_4)
+    {
+        uart4_dma_tx_irq_handler = debug_tx_dma_handler;
+    }
+#endif
+
 #if DEBUG_UART_USE_INTERRUPT                                                    //  ֻôжϲű
     fifo_init(&debug_uart_fifo, FIFO_DATA_8BIT, debug_uart_buffer, DEBUG_RING_BUFFER_LEN);
     uart_rx_interrupt(DEBUG_UART_INDEX, 1);                                     // ʹܶӦڽж
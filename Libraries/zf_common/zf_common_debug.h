@@ -53,6 +53,16 @@
 
 #define DEBUG_UART_USE_INTERRUPT    (1)                                         // Ƿ debug uart ж
 
+// debug uart 첽 printf / debug_send_buffer ֻд뷢ͻλ
+//  DMA  ÿηɺ DMA TX жһ (ĩβƴ)
+// رպָΪÿεõȴ DMA 
+#define DEBUG_UART_TX_ASYNC         (1)                                         // Ƿ debug uart 첽
+#define DEBUG_TX_BUFFER_LEN         (1024)                                      // ͻλС (xdata)
+
+#define DEBUG_TX_OVERFLOW_DROP      (0)                                         // ʱ ( ж)
+#define DEBUG_TX_OVERFLOW_BLOCK     (1)                                         // ʱȴڳռ (ݲʧ)
+#define DEBUG_TX_OVERFLOW_POLICY    (DEBUG_TX_OVERFLOW_DROP)                    // Ĭ  debug_tx_set_policy() ޸
+
 //-------------------------------------------------------------------------------------------------------------------
 //      
 // ˵     x           жǷ񴥷 0- 1-
@@ -92,6 +102,25 @@
 //    void (*output_screen_clear)     (void);
 //}debug_output_struct;
 
+#if DEBUG_UART_TX_ASYNC                                                          //  debug uart 첽
+typedef struct
+{
+    uint32 queued;                                                              // д뻺ֽ
+    uint32 sent;                                                                // DMA ɵֽ
+    uint32 dropped;                                                             // ֽ
+    uint32 chunks;                                                              // DMA Ͷ
+    uint16 blocked;                                                             // ȴĴ ( 65535 )
+    uint16 peak;                                                                // ʹ (byte)
+    uint16 pending;                                                             // ǰеֽ (ڷ͵)
+}debug_tx_stat_struct;
+
+uint16      debug_tx_write              (const uint8 *buff, uint16 len);
+void        debug_tx_flush              (void);
+void        debug_tx_set_policy         (uint8 policy);
+void        debug_tx_get_stat           (debug_tx_stat_struct *stat);
+void        debug_tx_dma_handler        (void);
+#endif
+
 uint32      debug_send_buffer(const uint8 *buff, uint32 len);
 #if DEBUG_UART_USE_INTERRUPT                                                    //  debug uart ж
 #define     DEBUG_RING_BUFFER_LEN   (64)                                        // 廷λС Ĭ 64byte
@@ -112,6 +112,15 @@
 #include "quaternion.h"
 #include "oled.h"
 #include "ui.h"
+#include "adc_filter.h"
+#include "median.h"
+#include "snapshot.h"
+#include "track_metrics.h"
+#include "fastmath.h"
+#include "gyro_bias.h"
+#include "scheduler.h"
+#include "timebase.h"
+#include "profiler.h"
 
 #endif
 
@@ -42,6 +42,11 @@ void (*uart2_irq_handler)(uint8 dat) = NULL;
 void (*uart3_irq_handler)(uint8 dat) = NULL;
 void (*uart4_irq_handler)(uint8 dat) = NULL;
 
+void (*uart1_dma_tx_irq_handler)(void) = NULL;
+void (*uart2_dma_tx_irq_handler)(void) = NULL;
+void (*uart3_dma_tx_irq_handler)(void) = NULL;
+void (*uart4_dma_tx_irq_handler)(void) = NULL;
+
 void (*tim0_irq_handler)(void) = NULL;
 void (*tim1_irq_handler)(void) = NULL;
 void (*tim2_irq_handler)(void) = NULL;
@@ -55,3 +60,5 @@ void (*int2_irq_handler)(void) = NULL;
 void (*int3_irq_handler)(void) = NULL;
 void (*int4_irq_handler)(void) = NULL;
 
+void (*spi_dma_irq_handler)(void) = NULL;
+
@@ -87,6 +87,11 @@ extern void (*uart2_irq_handler)(uint8 dat);
 extern void (*uart3_irq_handler)(uint8 dat);
 extern void (*uart4_irq_handler)(uint8 dat);
 
+extern void (*uart1_dma_tx_irq_handler)(void);
+extern void (*uart2_dma_tx_irq_handler)(void);
+extern void (*uart3_dma_tx_irq_handler)(void);
+extern void (*uart4_dma_tx_irq_handler)(void);
+
 extern void (*tim0_irq_handler)(void);
 extern void (*tim1_irq_handler)(void);
 extern void (*tim2_irq_handler)(void);
@@ -100,6 +105,8 @@ extern void (*int2_irq_handler)(void);
 extern void (*int3_irq_handler)(void);
 extern void (*int4_irq_handler)(void);
 
+extern void (*spi_dma_irq_handler)(void);
+
 #define ZF_ENABLE           (1)
 #define ZF_DISABLE          (0)
 
@@ -134,6 +134,62 @@ int16 imu660rb_acc_x = 0, imu660rb_acc_y = 0, imu660rb_acc_z = 0;
 
 	}
 
+	#if (IMU660RB_USE_DMA)
+
+	#define IMU660RB_DMA_BUFFER_SIZE    (1 + IMU660RB_FIFO_READ_MAX * 7)    // ֽ + һ FIFO ȡֽ
+
+	static uint8 xdata imu660rb_dma_tx_buffer[IMU660RB_DMA_BUFFER_SIZE];   // ֽ Ϊ 0
+	static uint8 xdata imu660rb_dma_rx_buffer[IMU660RB_DMA_BUFFER_SIZE];   //  0 ֽǷֽڼյЧ
+	static vuint8 imu660rb_dma_state = 0;                                   // 0- 1-ڴ
+	static uint8 imu660rb_dma_words = 0;                                    // ڶȡ FIFO 
+
+	void (*imu660rb_dma_callback)(void) = NULL;
+
+	//-------------------------------------------------------------------------------------------------------------------
+	//      IMU660RB DMA ɴ
+	// ˵     void
+	// ز     void
+	// ʹʾ     spi_dma_irq_handler = imu660rb_dma_handler;
+	// עϢ     ڲ  DMA_SPI жִ Ƭѡ imu660rb_dma_callback
+	//             صпֱһ DMA ȡ
+	//-------------------------------------------------------------------------------------------------------------------
+	static void imu660rb_dma_handler (void)
+	{
+		IMU660RB_CS(1);
+		imu660rb_dma_state = 0;
+
+		if(imu660rb_dma_callback != NULL)
+		{
+			imu660rb_dma_callback();
+		}
+	}
+
+	//-------------------------------------------------------------------------------------------------------------------
+	//      IMU660RB DMA 
+	// ˵     reg             Ĵַ
+	// ˵     len             ݳ
+	// ز     uint8           1-һδδ 0-
+	// ʹʾ     imu660rb_read_registers_dma(IMU660RB_GYRO_ADDRESS, 12);
+	// עϢ     ڲ ݴ imu660rb_dma_rx_buffer[1] ʼ
+	//-------------------------------------------------------------------------------------------------------------------
+	static uint8 imu660rb_read_registers_dma(uint8 reg, uint16 len)
+	{
+		uint8 return_state = 1;
+
+		if(!imu660rb_dma_state)
+		{
+			imu660rb_dma_state = 1;
+			imu660rb_dma_tx_buffer[0] = reg | IMU660RB_SPI_R;
+			IMU660RB_CS(0);
+			spi_dma_transfer_8bit(IMU660RB_SPI, imu660rb_dma_tx_buffer, imu660rb_dma_rx_buffer, len + 1);
+			return_state = 0;
+		}
+
+		return return_state;
+	}
+
+	#endif
+
 #elif (IMU660RB_USE_INTERFACE==SOFT_SPI)
 	
 	
@@ -314,6 +370,73 @@ static uint8 imu660rb_self_check (void)
     return return_state;
 }
 
+//-------------------------------------------------------------------------------------------------------------------
+//       IMU660RB Ǻͼٶȼ
+// ˵     dat              IMU660RB_GYRO_ADDRESS ʼ 12 ֽ
+// ز     void
+// ʹʾ     imu660rb_parse_acc_gyro(dat);
+// עϢ     ڲ
+//-------------------------------------------------------------------------------------------------------------------
+static void imu660rb_parse_acc_gyro (const uint8 *dat)
+{
+    imu660rb_gyro_x = (int16)(((uint16)dat[1]<<8 | dat[0]));
+    imu660rb_gyro_y = (int16)(((uint16)dat[3]<<8 | dat[2]));
+    imu660rb_gyro_z = (int16)(((uint16)dat[5]<<8 | dat[4]));
+    imu660rb_acc_x = (int16)(((uint16)dat[7]<<8 | dat[6]));
+    imu660rb_acc_y = (int16)(((uint16)dat[9]<<8 | dat[8]));
+    imu660rb_acc_z = (int16)(((uint16)dat[11]<<8 | dat[10]));
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//       IMU660RB FIFO 
+// ˵     dat              IMU660RB_FIFO_DATA_OUT_TAG ʼ
+// ˵     words            ÿ 7 ֽ
+// ˵     sample          
+// ز     uint8           ǲ
+// ʹʾ     num = imu660rb_parse_fifo(dat, words, sample);
+// עϢ     ڲ
+//-------------------------------------------------------------------------------------------------------------------
+static uint8 imu660rb_parse_fifo (const uint8 *dat, uint8 words, imu660rb_sample_struct *sample)
+{
+    const uint8 *word;
+    uint8 i;
+    uint8 num = 0;
+
+    for(i = 0; i < words; i ++)
+    {
+        word = &dat[i * 7];
+        switch(word[0] >> 3)                                                    // 5λΪǩ
+        {
+            case IMU660RB_FIFO_TAG_GYRO:
+            {
+                imu660rb_gyro_x = (int16)(((uint16)word[2]<<8 | word[1]));
+                imu660rb_gyro_y = (int16)(((uint16)word[4]<<8 | word[3]));
+                imu660rb_gyro_z = (int16)(((uint16)word[6]<<8 | word[5]));
+                sample[num].gyro_x = imu660rb_gyro_x;
+                sample[num].gyro_y = imu660rb_gyro_y;
+                sample[num].gyro_z = imu660rb_gyro_z;
+                sample[num].acc_x = imu660rb_acc_x;
+                sample[num].acc_y = imu660rb_acc_y;
+                sample[num].acc_z = imu660rb_acc_z;
+                num ++;
+            }
+            break;
+
+            case IMU660RB_FIFO_TAG_ACC:
+            {
+                imu660rb_acc_x = (int16)(((uint16)word[2]<<8 | word[1]));
+                imu660rb_acc_y = (int16)(((uint16)word[4]<<8 | word[3]));
+                imu660rb_acc_z = (int16)(((uint16)word[6]<<8 | word[5]));
+            }
+            break;
+
+            default: break;
+        }
+    }
+
+    return num;
+}
+
 //-------------------------------------------------------------------------------------------------------------------
 //      ȡ IMU660RB ٶȼ
 // ˵     void
@@ -349,6 +472,169 @@ void imu660rb_get_gyro (void)
     imu660rb_gyro_z = (int16)(((uint16)dat[5]<<8 | dat[4]));
 }
 
+//-------------------------------------------------------------------------------------------------------------------
+//      ȡ IMU660RB Ǻͼٶȼ (һȡ)
+// ˵     void
+// ز     void
+// ʹʾ     imu660rb_get_acc_gyro();                                        // ִиúֱӲ鿴Ӧı
+// עϢ      (0x22-0x27) ٶȼ (0x28-0x2D) Ĵַʼʱ CTRL3_C ѿַ
+//              0x22 ʼһζ12ֽڣֻһֽںһƬѡȷֱȡǺͼٶȼһδ
+//             ͬһδжᱻжϻָ
+//-------------------------------------------------------------------------------------------------------------------
+void imu660rb_get_acc_gyro (void)
+{
+    uint8 dat[12];
+
+    imu660rb_read_registers(IMU660RB_GYRO_ADDRESS, dat, 12);
+    imu660rb_parse_acc_gyro(dat);
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//       IMU660RB FIFO  INT1 ˮλж
+// ˵     void
+// ز     void
+// ʹʾ     imu660rb_fifo_init();                                           //  imu660rb_init() ɹ֮
+// עϢ      416Hz ٶȼ 104Hz д FIFO (ģʽ 󸲸)
+//             FIFO δﵽ IMU660RB_FIFO_WATERMARK ʱ INT1 ͵ƽ ˮλºָߵƽ
+//             INT1 Ϊ͵ƽЧ Ƭⲿж½ش
+//             ʱл·ģʽ FIFO ⲿж֮ǰ ֤һδﵽˮλʱܲ½
+//-------------------------------------------------------------------------------------------------------------------
+void imu660rb_fifo_init (void)
+{
+    imu660rb_write_register(IMU660RB_INT1_CTRL, 0x00);                          // ڼر INT1
+    imu660rb_write_register(IMU660RB_FIFO_CTRL4, 0x00);                         // ·ģʽ  FIFO
+    imu660rb_write_register(IMU660RB_CTRL1_XL, (IMU660RB_ACC_SAMPLE & 0x0F) | IMU660RB_FIFO_ACC_ODR);   // ̲ ֻ޸
+    imu660rb_write_register(IMU660RB_CTRL2_G, (IMU660RB_GYR_SAMPLE & 0x0F) | IMU660RB_FIFO_GYR_ODR);
+    imu660rb_write_register(IMU660RB_CTRL3_C, 0x64);                            //  0x44  INT ŵ͵ƽЧ
+    imu660rb_write_register(IMU660RB_FIFO_CTRL1, IMU660RB_FIFO_WATERMARK & 0xFF);
+    imu660rb_write_register(IMU660RB_FIFO_CTRL2, (IMU660RB_FIFO_WATERMARK >> 8) & 0x01);
+    imu660rb_write_register(IMU660RB_FIFO_CTRL3, IMU660RB_FIFO_GYR_ODR | (IMU660RB_FIFO_ACC_ODR >> 4)); // д FIFO ͬ
+    imu660rb_write_register(IMU660RB_FIFO_CTRL4, 0x06);                         // ģʽ
+    imu660rb_write_register(IMU660RB_INT1_CTRL, 0x08);                          // INT1  FIFO ˮλж
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//      ȡ IMU660RB FIFO δ
+// ˵     void
+// ز     uint16          FIFO δ (ÿΪһǻٶȼƲ)
+// ʹʾ     uint16 count = imu660rb_fifo_count();
+// עϢ
+//-------------------------------------------------------------------------------------------------------------------
+uint16 imu660rb_fifo_count (void)
+{
+    uint8 dat[2];
+
+    imu660rb_read_registers(IMU660RB_FIFO_STATUS1, dat, 2);
+    return ((uint16)(dat[1] & 0x03) << 8) | dat[0];
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//      ȡ IMU660RB FIFO
+// ˵     sample            IMU660RB_FIFO_READ_MAX 
+// ˵     sample_num       ζǲ
+// ز     uint16          ȡ FIFO ʣ
+// ʹʾ     remain = imu660rb_fifo_read(sample, &num);
+// עϢ      IMU660RB_FIFO_READ_MAX  ȫһδж
+//             FIFO Ĵ 0x78-0x7E  0x7E ַԶص 0x78 Կȡ
+//             ÿһ ٶȼֻ¼ٶֵ еļٶΪ֮ǰһ
+//             һֵͬʱд imu660rb_gyro_x ȫֱ  imu660rb_get_acc_gyro() ͬ
+//-------------------------------------------------------------------------------------------------------------------
+uint16 imu660rb_fifo_read (imu660rb_sample_struct *sample, uint8 *sample_num)
+{
+    uint8 dat[IMU660RB_FIFO_READ_MAX * 7];
+    uint16 count;
+    uint8 words;
+
+    count = imu660rb_fifo_count();
+    words = (count > IMU660RB_FIFO_READ_MAX) ? IMU660RB_FIFO_READ_MAX : (uint8)count;
+    if(words)
+    {
+        imu660rb_read_registers(IMU660RB_FIFO_DATA_OUT_TAG, dat, (uint32)words * 7);
+    }
+
+    *sample_num = imu660rb_parse_fifo(dat, words, sample);
+    return count - words;
+}
+
+#if (IMU660RB_USE_DMA)
+//-------------------------------------------------------------------------------------------------------------------
+//      IMU660RB DMA ȡǷڽ
+// ˵     void
+// ز     uint8           1-ڴ 0-
+// ʹʾ     if(!imu660rb_dma_busy()) { ... }
+// עϢ     DMA ڼ䲻ܵдĴĺ
+//-------------------------------------------------------------------------------------------------------------------
+uint8 imu660rb_dma_busy (void)
+{
+    return imu660rb_dma_state;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//       DMA ȡ IMU660RB Ǻͼٶȼ
+// ˵     void
+// ز     uint8           1-һδδ 0-
+// ʹʾ     imu660rb_get_acc_gyro_dma();                                    // ɺڻصе imu660rb_get_acc_gyro_dma_finish()
+// עϢ      imu660rb_get_acc_gyro() ȡͬ 12 ֽ 
+//             13 ֽ SPI 7.5MHz Լ 14us ڼ CPU ȴ
+//-------------------------------------------------------------------------------------------------------------------
+uint8 imu660rb_get_acc_gyro_dma (void)
+{
+    return imu660rb_read_registers_dma(IMU660RB_GYRO_ADDRESS, 12);
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//      DMA ȡɺǺͼٶȼ
+// ˵     void
+// ز     void
+// ʹʾ     imu660rb_get_acc_gyro_dma_finish();                             //  imu660rb_dma_callback е
+// עϢ     д imu660rb_gyro_x ȫֱ
+//-------------------------------------------------------------------------------------------------------------------
+void imu660rb_get_acc_gyro_dma_finish (void)
+{
+    imu660rb_parse_acc_gyro(&imu660rb_dma_rx_buffer[1]);
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//       DMA ȡ IMU660RB FIFO
+// ˵     void
+// ز     uint8           ȡ 0-FIFO ˮλһδδ û
+// ʹʾ     imu660rb_fifo_read_dma();                                       // ɺڻصе imu660rb_fifo_read_dma_finish()
+// עϢ     ȡ FIFO δ (3 ֽ) ﵽ IMU660RB_FIFO_WATERMARK  DMA ȡ
+//             ɻصٴεüɼȡ ֱ FIFO ˮλ (INT1 ָߵƽ)
+//-------------------------------------------------------------------------------------------------------------------
+uint8 imu660rb_fifo_read_dma (void)
+{
+    uint16 count;
+
+    if(imu660rb_dma_state)
+    {
+        return 0;
+    }
+
+    count = imu660rb_fifo_count();
+    if(count < IMU660RB_FIFO_WATERMARK)
+    {
+        return 0;
+    }
+
+    imu660rb_dma_words = (count > IMU660RB_FIFO_READ_MAX) ? IMU660RB_FIFO_READ_MAX : (uint8)count;
+    imu660rb_read_registers_dma(IMU660RB_FIFO_DATA_OUT_TAG, (uint16)imu660rb_dma_words * 7);
+    return imu660rb_dma_words;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//      DMA ȡɺ FIFO 
+// ˵     sample            IMU660RB_FIFO_READ_MAX 
+// ز     uint8           ǲ
+// ʹʾ     num = imu660rb_fifo_read_dma_finish(sample);                    //  imu660rb_dma_callback е
+// עϢ      imu660rb_fifo_read() ͬ ÿһ
+//-------------------------------------------------------------------------------------------------------------------
+uint8 imu660rb_fifo_read_dma_finish (imu660rb_sample_struct *sample)
+{
+    return imu660rb_parse_fifo(&imu660rb_dma_rx_buffer[1], imu660rb_dma_words, sample);
+}
+#endif
+
 //-------------------------------------------------------------------------------------------------------------------
 //       IMU660RB ٶȼתΪʵ
 // ˵     gyro_value      ļٶȼ
@@ -409,6 +695,10 @@ uint8 imu660rb_init (void)
 	
     spi_init(IMU660RB_SPI, SPI_MODE0, IMU660RB_SPI_SPEED, IMU660RB_SPC_PIN, IMU660RB_SDI_PIN, IMU660RB_SDO_PIN, SPI_CS_NULL);   //  IMU660RB  SPI ˿
     gpio_init(IMU660RB_CS_PIN, GPO, GPIO_HIGH, GPO_PUSH_PULL);                  //  IMU660RB  CS ˿
+#if (IMU660RB_USE_DMA)
+    spi_dma_init(IMU660RB_SPI);                                                 // ȡʹ DMA
+    spi_dma_irq_handler = imu660rb_dma_handler;
+#endif
 //    imu660rb_read_register(IMU660RB_CHIP_ID);                                   // ȡһ豸ID 豸ΪSPIģʽ
 	
 #elif (IMU660RB_USE_INTERFACE==SOFT_SPI)
@@ -60,7 +60,10 @@
 #include "zf_common_typedef.h"
 #include "zf_device_type.h"
 
-#define IMU660RB_USE_INTERFACE       SOFT_SPI                        	// Ĭʹ SPI ʽ
+#define IMU660RB_USE_INTERFACE       SOFT_SPI                        	// Ĭʹ SPI ʽ (복ϵĽһ)
+// Ϊ HARDWARE_SPI ʹ DMA ȡ (IMU660RB_USE_DMA) SPI0 3ǹ̶ģҪ:
+//   SCK  P40 -> P43    MOSI P41 -> P40    MISO P42 -> P41    CS   P43 -> P42
+// ֱл IMU (imu660rb_init Լʧ)
 #if (IMU660RB_USE_INTERFACE==HARDWARE_SPI)
 //====================================================Ӳ SPI ====================================================
 	#define IMU660RB_SPI_SPEED          ((uint32)10 * 1000 * 1000U)  	// Ӳ SPI 
@@ -70,6 +73,7 @@
 	#define IMU660RB_SDO_PIN            SPI0_CH3_MISO_P41              	// Ӳ SPI MISO 
 	#define IMU660RB_CS_PIN             (IO_P42)                       	// CS Ƭѡ
 	#define IMU660RB_CS(x)              ((x) ? (gpio_high(IMU660RB_CS_PIN)) : (gpio_low(IMU660RB_CS_PIN)))
+	#define IMU660RB_USE_DMA            (1)                             	// 1-ṩ DMA ȡ (ռ DMA_SPI  spi_dma_irq_handler) 0-ʹ
 //====================================================Ӳ SPI ====================================================
 #elif (IMU660RB_USE_INTERFACE==SOFT_SPI)
 //==================================================== SPI ====================================================
@@ -77,12 +81,14 @@
 	#define IMU660RB_SDI_PIN            (P41)                           //  SPI MOSI 
 	#define IMU660RB_SDO_PIN            (P42)                           //  SPI MISO 
 	#define IMU660RB_CS_PIN             (P43)                        	//  SPI CS   
+	#define IMU660RB_USE_DMA            (0)                             	//  SPI ʹ DMA
 //==================================================== SPI ====================================================
 #elif (IMU660RB_USE_INTERFACE==SOFT_IIC)
 //==================================================== IIC ====================================================
 	#define IMU660RB_SOFT_IIC_DELAY     (0)                             //  IIC ʱʱ ֵԽС IIC ͨԽ
 	#define IMU660RB_SCL_PIN            (IO_P40)                        //  IIC SCL   IMU660RB  SCL 
 	#define IMU660RB_SDA_PIN            (IO_P41)                        //  IIC SDA   IMU660RB  SDA 
+	#define IMU660RB_USE_DMA            (0)                             //  IIC ʹ DMA
 //==================================================== IIC ====================================================
 #endif
 
@@ -95,6 +101,10 @@
 
 #define IMU660RB_CHIP_ID            (0x0F)
 
+#define IMU660RB_FIFO_CTRL1         (0x07)
+#define IMU660RB_FIFO_CTRL2         (0x08)
+#define IMU660RB_FIFO_CTRL3         (0x09)
+#define IMU660RB_FIFO_CTRL4         (0x0A)
 #define IMU660RB_INT1_CTRL          (0x0D)
 #define IMU660RB_CTRL1_XL           (0x10)
 #define IMU660RB_CTRL2_G            (0x11)
@@ -107,6 +117,8 @@
 
 #define IMU660RB_ACC_ADDRESS        (0x28)
 #define IMU660RB_GYRO_ADDRESS       (0x22)
+#define IMU660RB_FIFO_STATUS1       (0x3A)
+#define IMU660RB_FIFO_DATA_OUT_TAG  (0x78)
 
 #define IMU660RB_ACC_SAMPLE         (0x3C)                      // ٶȼ
 // Ϊ:0x30 ٶΪ:2G      ȡļٶȼ 16393תΪλݣλg(m/s^2)
@@ -122,17 +134,45 @@
 // Ϊ:0x5C Ϊ:2000dps ȡݳ14.3    תΪλݣλΪ/s
 // Ϊ:0x51 Ϊ:4000dps ȡݳ7.1     תΪλݣλΪ/s
 
+//================================================FIFO ɼ================================================
+#define IMU660RB_FIFO_GYR_ODR       (0x60)                      // FIFO ģʽ 416Hz (CTRL2_G 4λ ÿFIFOΪһǲ)
+#define IMU660RB_FIFO_ACC_ODR       (0x40)                      // FIFO ģʽٶȼ 104Hz (CTRL1_XL 4λ ֻ̬ Ҫͬ)
+#define IMU660RB_FIFO_WATERMARK     (5)                         // FIFO ˮλ () 416Hz  + 104Hz ٶȼ ÿ 9.6ms  5 
+#define IMU660RB_FIFO_READ_MAX      (16)                        // һȡ ÿ 7 ֽ (1 ֽڱǩ + 6 ֽ)
+#define IMU660RB_FIFO_TAG_GYRO      (0x01)                      // FIFO ǩ 
+#define IMU660RB_FIFO_TAG_ACC       (0x02)                      // FIFO ǩ ٶȼ
+//================================================FIFO ɼ================================================
+
+typedef struct
+{
+    int16 gyro_x, gyro_y, gyro_z;                               // ԭʼ
+    int16 acc_x, acc_y, acc_z;                                  // ٶȼԭʼ (FIFO иǲ֮ǰһ)
+}imu660rb_sample_struct;
 
 
 //================================================ IMU963RB ȫֱ================================================
 extern int16 imu660rb_gyro_x, imu660rb_gyro_y, imu660rb_gyro_z;                   //       gyro ()
 extern int16 imu660rb_acc_x, imu660rb_acc_y, imu660rb_acc_z;                      // ٶȼ     acc (accelerometer ٶȼ)
+#if (IMU660RB_USE_DMA)
+extern void (*imu660rb_dma_callback)(void);                                       // DMA ȡɻص  DMA_SPI же
+#endif
 //================================================ IMU963RB ȫֱ================================================
 
 
 //================================================ IMU963RB ================================================
 void  imu660rb_get_acc            (void);                                         // ȡ IMU660RB ٶȼ
 void  imu660rb_get_gyro           (void);                                         // ȡ IMU660RB 
+void  imu660rb_get_acc_gyro       (void);                                         // һζȡ IMU660RB Ǻͼٶȼ
+void  imu660rb_fifo_init          (void);                                         //  IMU660RB FIFO  INT1 ˮλж
+uint16 imu660rb_fifo_count        (void);                                         // ȡ IMU660RB FIFO δ
+uint16 imu660rb_fifo_read         (imu660rb_sample_struct *sample, uint8 *sample_num);  // ȡ IMU660RB FIFO
+#if (IMU660RB_USE_DMA)
+uint8 imu660rb_dma_busy           (void);                                         // IMU660RB DMA ȡǷڽ
+uint8 imu660rb_get_acc_gyro_dma   (void);                                         //  DMA ȡ IMU660RB Ǻͼٶȼ
+void  imu660rb_get_acc_gyro_dma_finish (void);                                    // DMA ȡɺǺͼٶȼ
+uint8 imu660rb_fifo_read_dma      (void);                                         //  DMA ȡ IMU660RB FIFO
+uint8 imu660rb_fifo_read_dma_finish (imu660rb_sample_struct *sample);             // DMA ȡɺ FIFO 
+#endif
 float imu660rb_acc_transition     (int16 acc_value);                              //  IMU660RB ٶȼתΪʵ
 float imu660rb_gyro_transition    (int16 gyro_value);                             //  IMU660RB תΪʵ
 uint8 imu660rb_init               (void);                                         // ʼ IMU660RB
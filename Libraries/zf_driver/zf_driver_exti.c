@@ -34,7 +34,112 @@
 ********************************************************************************************************************/
 
 
+#include "zf_driver_gpio.h"
 #include "zf_driver_exti.h"
 
+#pragma warning disable = 183
+#pragma warning disable = 177
 
-// TO DO
\ No newline at end of file
+//-------------------------------------------------------------------------------------------------------------------
+//      ⲿжʹ
+// ˵     pin             ⲿжͨ
+// ز     void
+// ʹʾ     exti_enable(INT2_P36);
+// עϢ
+//-------------------------------------------------------------------------------------------------------------------
+void exti_enable (exti_pin_enum pin)
+{
+	if(INT0_P32 == pin)
+	{
+		EX0 = 1;
+	}
+	else if(INT1_P33 == pin)
+	{
+		EX1 = 1;
+	}
+	else if(INT2_P36 == pin)
+	{
+		INTCLKO |= 0x10;
+	}
+	else if(INT3_P37 == pin)
+	{
+		INTCLKO |= 0x20;
+	}
+	else if(INT4_P30 == pin)
+	{
+		INTCLKO |= 0x40;
+	}
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//      ⲿжʧ
+// ˵     pin             ⲿжͨ
+// ز     void
+// ʹʾ     exti_disable(INT2_P36);
+// עϢ
+//-------------------------------------------------------------------------------------------------------------------
+void exti_disable (exti_pin_enum pin)
+{
+	if(INT0_P32 == pin)
+	{
+		EX0 = 0;
+	}
+	else if(INT1_P33 == pin)
+	{
+		EX1 = 0;
+	}
+	else if(INT2_P36 == pin)
+	{
+		INTCLKO &= ~0x10;
+	}
+	else if(INT3_P37 == pin)
+	{
+		INTCLKO &= ~0x20;
+	}
+	else if(INT4_P30 == pin)
+	{
+		INTCLKO &= ~0x40;
+	}
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//      ⲿжϳʼ
+// ˵     pin             ⲿжͨ Ź̶  exti_pin_enum
+// ˵     trigger         ʽ INT2 INT3 INT4 ֻ½ش
+// ز     void
+// ʹʾ     exti_init(INT2_P36, EXTI_TRIGGER_FALLING);
+// עϢ     Ϊ룬Ѿλжϱ־ʹж
+//             жϷ isr.c Уͨ int0_irq_handler ~ int4_irq_handler ص
+//-------------------------------------------------------------------------------------------------------------------
+void exti_init (exti_pin_enum pin, exti_trigger_enum trigger)
+{
+	if(INT0_P32 == pin)
+	{
+		gpio_init(IO_P32, GPI, GPIO_HIGH, GPI_PULL_UP);
+		IT0 = (EXTI_TRIGGER_FALLING == trigger);                                // 1-½ 0-˫
+		INT0_CLEAR_FLAG;
+	}
+	else if(INT1_P33 == pin)
+	{
+		gpio_init(IO_P33, GPI, GPIO_HIGH, GPI_PULL_UP);
+		IT1 = (EXTI_TRIGGER_FALLING == trigger);
+		INT1_CLEAR_FLAG;
+	}
+	else if(INT2_P36 == pin)
+	{
+		gpio_init(IO_P36, GPI, GPIO_HIGH, GPI_PULL_UP);
+		INT2_CLEAR_FLAG;
+	}
+	else if(INT3_P37 == pin)
+	{
+		gpio_init(IO_P37, GPI, GPIO_HIGH, GPI_PULL_UP);
+		INT3_CLEAR_FLAG;
+	}
+	else if(INT4_P30 == pin)
+	{
+		gpio_init(IO_P30, GPI, GPIO_HIGH, GPI_PULL_UP);
+		INT4_CLEAR_FLAG;
+	}
+
+	exti_enable(pin);
+}
\ No newline at end of file
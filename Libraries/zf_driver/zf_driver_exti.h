@@ -39,6 +39,32 @@
 #include "zf_common_typedef.h"
 
 
-// TO DO
+typedef enum                                                                    // ö ⲿжͨ (Ź̶)
+{
+	INT0_P32,                                                                   // ֧½غ˫
+	INT1_P33,                                                                   // ֧½غ˫
+	INT2_P36,                                                                   // ֧½
+	INT3_P37,                                                                   // ֧½
+	INT4_P30,                                                                   // ֧½
+}exti_pin_enum;
 
-#endif
\ No newline at end of file
+typedef enum                                                                    // ö ⲿжϴʽ
+{
+	EXTI_TRIGGER_FALLING,                                                       // ½ش
+	EXTI_TRIGGER_BOTH,                                                          // غ½ض ( INT0 INT1)
+}exti_trigger_enum;
+
+
+#define INT0_CLEAR_FLAG 	IE0 = 0    				// ⲿж0жϱ־λ жϷУӲԶ㡣
+#define INT1_CLEAR_FLAG 	IE1 = 0    				// ⲿж1жϱ־λ жϷУӲԶ㡣
+#define INT2_CLEAR_FLAG		AUXINTIF &= ~(1<<4) 	// ⲿж2жϱ־λ жϷУӲԶ㡣
+#define INT3_CLEAR_FLAG		AUXINTIF &= ~(1<<5) 	// ⲿж3жϱ־λ жϷУӲԶ㡣
+#define INT4_CLEAR_FLAG		AUXINTIF &= ~(1<<6)		// ⲿж4жϱ־λ жϷУӲԶ㡣
+
+
+void exti_enable  (exti_pin_enum pin);
+void exti_disable (exti_pin_enum pin);
+
+void exti_init (exti_pin_enum pin, exti_trigger_enum trigger);
+
+#endif
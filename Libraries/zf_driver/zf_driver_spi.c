@@ -734,5 +734,47 @@ void spi_init(spi_index_enum spi_n, spi_mode_enum mode, uint32 baud, spi_pin_enu
     }
 }
 
+//-------------------------------------------------------------------------------------------------------------------
+//      SPI DMA ʼ
+// ˵     spi_n           SPI ģ ֻ֧ SPI_0
+// ز     void
+// ʹʾ     spi_dma_init(SPI_0);                                            //  spi_init() ֮
+// עϢ     DMA ͬʱͺͽ ɽ DMA_SPI ж (isr.c)  spi_dma_irq_handler
+//             Ƭѡ DMA  Ҫǰ  spi_dma_irq_handler 
+//-------------------------------------------------------------------------------------------------------------------
+void spi_dma_init (spi_index_enum spi_n)
+{
+	// ˶Ϣ ʾλ
+	// SPI_1 SPI_2 봮ڹüĴ û SPI DMA ͨ
+	zf_assert(SPI_0 == spi_n);
+
+	DMA_SPI_STA  = 0x00;	// DMA״̬
+	DMA_SPI_CFG  = 0xE0;	// DMAжϣDMAͺͽգжȼDMAȼ
+	DMA_SPI_CFG2 = 0x00;	// ԶSS
+	DMA_SPI_CR   = 0x00;	// ʱʹSPI DMA
+}
 
-
+//-------------------------------------------------------------------------------------------------------------------
+//      SPI DMA 8bit ݴ ͬʱе
+// ˵     spi_n           SPI ģ ֻ֧ SPI_0
+// ˵     write_buffer    ͵ݻַ  xdata 
+// ˵     read_buffer     յݻַ  xdata 
+// ˵     len             ֽ (Ϊ0)
+// ز     void
+// ʹʾ     spi_dma_transfer_8bit(SPI_0, tx_buff, rx_buff, 13);
+// עϢ      ɽ DMA_SPI ж жйر SPI DMA
+//             ֮ǰҪٴ ҲҪ SPI_0 д
+//-------------------------------------------------------------------------------------------------------------------
+void spi_dma_transfer_8bit (spi_index_enum spi_n, const uint8 xdata *write_buffer, uint8 xdata *read_buffer, uint16 len)
+{
+	zf_assert(SPI_0 == spi_n);
+
+	DMA_SPI_STA  = 0x00;									// DMA״̬
+	DMA_SPI_TXAL = (uint8)((uint16)write_buffer);			// ÷ͻַ
+	DMA_SPI_TXAH = (uint8)((uint16)write_buffer >> 8);		// ÷ͻַ
+	DMA_SPI_RXAL = (uint8)((uint16)read_buffer);			// ýջַ
+	DMA_SPI_RXAH = (uint8)((uint16)read_buffer >> 8);		// ýջַ
+	DMA_SPI_AMT  = (uint8)(len - 1);						// ôֽ
+	DMA_SPI_AMTH = (uint8)((len - 1) >> 8);					// ôֽ
+	DMA_SPI_CR   = 0xC1;									// ʹSPI DMAģʽʼ䣬FIFO
+}
@@ -195,6 +195,9 @@ void        spi_transfer_16bit              (spi_index_enum spi_n, const uint16
 
 void        spi_init                        (spi_index_enum spi_n, spi_mode_enum mode, uint32 baud, spi_pin_enum sck_pin, spi_pin_enum mosi_pin, spi_pin_enum miso_pin, gpio_pin_enum cs_pin);
 
+void        spi_dma_init                    (spi_index_enum spi_n);
+void        spi_dma_transfer_8bit           (spi_index_enum spi_n, const uint8 xdata *write_buffer, uint8 xdata *read_buffer, uint16 len);
+
 
 
 #endif
@@ -123,6 +123,7 @@ void uart_write_buffer(uart_index_enum uart_n, const uint8 *buff, uint16 len)
         buff += tmp_len;                                    // ָָ
         
         //	DMA_URXT_CFG(uart_n)  = 0x00; 		            // DMAȼ
+        DMA_URXT_CFG(uart_n) &= ~0x80;                      // ѯȴر uart_write_buffer_dma ķж
         DMA_URXT_STA(uart_n) = 0;				            // ձ־λ
 
         DMA_URXT_AMT(uart_n)  = (tmp_len - 1) & 0xff;		// ôֽ(8λ)n+1
@@ -136,6 +137,47 @@ void uart_write_buffer(uart_index_enum uart_n, const uint8 *buff, uint16 len)
         DMA_URXT_CR(uart_n) = 0x00;				            // رDMA TX
 	}
 }
+//-------------------------------------------------------------------------------------------------------------------
+//       DMA 飨ȴɣ
+// ˵     uart_n       ͨ
+// ˵     buff        Ҫ͵ַ  xdata  ǰ޸
+// ˵     len         ݳ (1 - 65535)
+// ز     void
+// ʹʾ     uart_write_buffer_dma(UART_1, tx_buff, 10);     //1̨10tx_buff顣
+// עϢ      DMA TX ж ɺ isr.c жӦڵж  uartx_dma_tx_irq_handler
+//              ǰٶԸôڵñ uart_write_buffer
+//-------------------------------------------------------------------------------------------------------------------
+void uart_write_buffer_dma(uart_index_enum uart_n, const uint8 xdata *buff, uint16 len)
+{
+    DMA_URXT_CR(uart_n)   = 0x00;				            // رDMA TX
+    DMA_URXT_STA(uart_n)  = 0;				                // ձ־λ
+    DMA_URXT_CFG(uart_n)  = 0x80;                           // DMA TXжϣжȼ
+
+    DMA_URXT_AMT(uart_n)  = (len - 1) & 0xff;		        // ôֽ(8λ)n+1
+    DMA_URXT_AMTH(uart_n) = (len - 1) >> 8;		            // ôֽ(8λ)n+1
+    DMA_URXT_TXAH(uart_n) = (uint8)((uint16)buff >> 8);
+    DMA_URXT_TXAL(uart_n) = (uint8)((uint16)buff);
+    DMA_URXT_CR(uart_n)   = 0xC0; 			                // ʹDMA TX
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//      ѯ DMA Ƿ
+// ˵     uart_n       ͨ
+// ز     uint8       1ɣɱ־   0δ
+// ʹʾ     if(uart_query_dma_tx(UART_1)) {...}
+// עϢ     ڹжʱѯ uart_write_buffer_dma ķ״̬ ־󲻻ٽ DMA TX ж
+//-------------------------------------------------------------------------------------------------------------------
+uint8 uart_query_dma_tx(uart_index_enum uart_n)
+{
+    if(DMA_URXT_STA(uart_n) & 0x01)
+    {
+        DMA_URXT_STA(uart_n) &= ~0x01;
+        return 1;
+    }
+
+    return 0;
+}
+
 //-------------------------------------------------------------------------------------------------------------------
 //      ڷַ
 // ˵     uart_n       ͨ
@@ -140,6 +140,8 @@ void 	uart_rx_start_buff		(uart_index_enum uart_n);
 void    uart_write_byte         (uart_index_enum uart_n, const uint8 dat);
 void    uart_write_buffer       (uart_index_enum uart_n, const uint8 *buff, uint16 len);
 void    uart_write_string       (uart_index_enum uart_n, const char *str);
+void    uart_write_buffer_dma   (uart_index_enum uart_n, const uint8 xdata *buff, uint16 len);
+uint8   uart_query_dma_tx       (uart_index_enum uart_n);
 
 uint8   uart_read_byte          (uart_index_enum uart_n);
 uint8   uart_query_byte         (uart_index_enum uart_n, uint8 *dat);
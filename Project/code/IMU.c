@@ -3,6 +3,34 @@
 
 struct IMUData imu;
 struct MahonyAHRS_t ahrs;
+struct MahonyAHRS_Fixed_t ahrs_fixed;
+
+static uint16 imu_dt_us = DT_US;          // 姿态解算使用的采样周期 (us)
+static uint32 imu_dt_ref_stamp = 0;       // 采样周期测量起点的时间戳
+static uint8 imu_dt_ref_valid = 0;        // 1-测量起点有效
+#if(IMU_USE_FIFO)
+static uint16 imu_dt_samples = 0;         // 测量起点之后读出的采样数
+#endif
+
+#if(IMU_USE_FIFO)
+static imu660rb_sample_struct imu_fifo_buf[IMU660RB_FIFO_READ_MAX];   // FIFO 一次读出的采样
+#endif
+
+#if(IMU660RB_USE_DMA && IMU_USE_FIFO)
+static uint16 imu_dma_total = 0;          // 本批DMA读取已积分的采样数
+#endif
+
+#if(IMU660RB_USE_DMA)
+static uint32 imu_dma_stamp = 0;          // 本次DMA读取启动时的时间戳
+#endif
+
+#if(IMU660RB_USE_DMA)
+static void imu_dma_complete(void);
+#endif
+
+// IMU数据快照 (imu_update 完成后发布)
+static struct IMUData imu_snap_bank[2];
+static snapshot_t imu_snap = {{&imu_snap_bank[0], &imu_snap_bank[1]}, sizeof(struct IMUData), 0, 0};
 
 //-------------------------------------------------------------------------------------------------------------------
 // 函数简介     角度归一化到-180~180度范围
@@ -41,10 +69,26 @@ uint8 imu_init(void)
 
         // 初始化Mahony姿态解算器
         Mahony_Init(&ahrs);
+        Mahony_Fixed_Init(&ahrs_fixed);
+
+        // 陀螺仪零偏: EEPROM 中有零偏时直接使用，否则上电后保持静止等待冷启动标定
+        if(gyro_bias_init())
+        {
+            printf("Gyro bias loaded from EEPROM\r\n");
+        }
+        else
+        {
+            printf("Gyro bias calibrating, keep still...\r\n");
+        }
 
         // 获取初始数据，用于预对准
         imu_get_data();
 
+#if(IMU660RB_USE_DMA)
+        // 之后的读取由 imu_update() 启动 DMA，在传输完成中断中解算
+        imu660rb_dma_callback = imu_dma_complete;
+#endif
+
         // 使用加速度计初始值对准姿态（可选）
         // 如果传感器水平放置，可以跳过这一步
         printf("IMU init success!\r\n");
@@ -57,71 +101,372 @@ uint8 imu_init(void)
     return result;
 }
 
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     原始数据转换为物理单位
+// 参数说明     void
+// 返回参数     void
+// 使用示例     imu_convert_data();
+// 备注信息     imu660rb_acc_x 等全局变量 -> imu.acc/gyro，角速度扣除零偏
+//-------------------------------------------------------------------------------------------------------------------
+static void imu_convert_data(void)
+{
+    imu.acc_x = imu660rb_acc_transition(imu660rb_acc_x);
+    imu.acc_y = imu660rb_acc_transition(imu660rb_acc_y);
+    imu.acc_z = imu660rb_acc_transition(imu660rb_acc_z);
+
+    imu.gyro_x = imu660rb_gyro_transition(imu660rb_gyro_x) - gyro_bias_lsb(0) / MAHONY_GYRO_LSB;
+    imu.gyro_y = imu660rb_gyro_transition(imu660rb_gyro_y) - gyro_bias_lsb(1) / MAHONY_GYRO_LSB;
+    imu.gyro_z = imu660rb_gyro_transition(imu660rb_gyro_z) - gyro_bias_lsb(2) / MAHONY_GYRO_LSB;
+}
+
 //-------------------------------------------------------------------------------------------------------------------
 // 函数简介     获取IMU原始数据
 // 参数说明     void
 // 返回参数     void
 // 使用示例     imu_get_data();
 // 备注信息     从imu660rb获取加速度计和陀螺仪数据并转换为物理单位
+//              陀螺仪和加速度计在一次12字节连续读取中读出，读取时刻记录在 imu.stamp
 //-------------------------------------------------------------------------------------------------------------------
 void imu_get_data(void)
 {
-    // 获取原始数据
-    imu660rb_get_acc();
-    imu660rb_get_gyro();
+    // 获取原始数据 (陀螺仪+加速度计一次读取)
+    imu660rb_get_acc_gyro();
+    imu.stamp = timebase_now_us();
 
     // 转换为物理单位
-    imu.acc_x = imu660rb_acc_transition(imu660rb_acc_x);
-    imu.acc_y = imu660rb_acc_transition(imu660rb_acc_y);
-    imu.acc_z = imu660rb_acc_transition(imu660rb_acc_z);
+    imu_convert_data();
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     开始FIFO批量采集
+// 参数说明     void
+// 返回参数     void
+// 使用示例     imu_fifo_start();
+// 备注信息     清空FIFO后开启外部中断，FIFO达到水位时进入中断调用 imu_update()
+//              INT1 在FIFO低于水位前一直保持低电平，必须先清空FIFO再开中断，否则不会再有下降沿
+//              调用前先设置 IMU_FIFO_INT_PIN 对应的 intx_irq_handler
+//-------------------------------------------------------------------------------------------------------------------
+void imu_fifo_start(void)
+{
+#if(IMU_USE_FIFO)
+    imu660rb_fifo_init();
+    exti_init(IMU_FIFO_INT_PIN, EXTI_TRIGGER_FALLING);
+#endif
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     用读取时间戳测量采样周期
+// 参数说明     stamp           本次读取的时间戳 (us)
+// 参数说明     num             本次读取的采样数
+// 返回参数     void
+// 使用示例     imu_dt_update(imu.stamp, 1);
+// 备注信息     FIFO: 测量起点之后读出的采样累计到 IMU_DT_WINDOW 个时，用经过的时间除以采样数
+//              非FIFO: 与上一次读取的时间戳之差
+//              测量值超出 DT_US ±IMU_DT_TOLERANCE 时保持原来的周期
+//-------------------------------------------------------------------------------------------------------------------
+static void imu_dt_update(uint32 stamp, uint16 num)
+{
+    uint32 dt;
+
+    if(imu_dt_ref_valid)
+    {
+#if(IMU_USE_FIFO)
+        imu_dt_samples += num;
+        if(imu_dt_samples < IMU_DT_WINDOW)
+        {
+            return;
+        }
+        dt = (stamp - imu_dt_ref_stamp) / imu_dt_samples;
+#else
+        dt = stamp - imu_dt_ref_stamp;
+#endif
+        if(dt + IMU_DT_TOLERANCE >= DT_US && dt <= DT_US + IMU_DT_TOLERANCE)
+        {
+            imu_dt_us = (uint16)dt;
+        }
+    }
+
+#if(IMU_USE_FIFO)
+    imu_dt_samples = 0;
+#endif
+    imu_dt_ref_stamp = stamp;
+    imu_dt_ref_valid = 1;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     一个采样的姿态解算
+// 参数说明     gx gy gz        陀螺仪原始数据
+// 参数说明     ax ay az        加速度计原始数据
+// 返回参数     void
+// 使用示例     imu_ahrs_step(imu660rb_gyro_x, imu660rb_gyro_y, imu660rb_gyro_z, imu660rb_acc_x, imu660rb_acc_y, imu660rb_acc_z);
+// 备注信息     积分一个采样周期 (imu_dt_update 测量的周期)，MAHONY_USE_FIXED 为1时用原始值做Q30定点解算
+//              陀螺仪先经过零偏估计扣除零偏，冷启动标定完成时重置姿态 (清除标定期间零偏积累的偏航误差)
+//-------------------------------------------------------------------------------------------------------------------
+static void imu_ahrs_step(int16 gx, int16 gy, int16 gz, int16 ax, int16 ay, int16 az)
+{
+    int16 gyro[3];
+    int16 acc[3];
+#if(!MAHONY_USE_FIXED)
+    float acc_x, acc_y, acc_z;
+    float norm;
+#endif
+
+    gyro[0] = gx;
+    gyro[1] = gy;
+    gyro[2] = gz;
+    acc[0] = ax;
+    acc[1] = ay;
+    acc[2] = az;
+    if(gyro_bias_update(gyro, acc) == GYRO_BIAS_EVENT_CALIBRATED)
+    {
+        Mahony_Init(&ahrs);
+        Mahony_Fixed_Init(&ahrs_fixed);
+    }
+    gx = gyro[0];
+    gy = gyro[1];
+    gz = gyro[2];
+
+#if(MAHONY_USE_FIXED)
+    // 定点Mahony算法直接使用原始值 (加速度只用方向，陀螺仪按 MAHONY_GYRO_LSB 换算)
+    Mahony_Fixed_Update(&ahrs_fixed, gx, gy, gz, ax, ay, az, imu_dt_us);
+#else
+
+    // 归一化加速度计数据（Mahony算法要求输入归一化后的加速度）
+    acc_x = imu660rb_acc_transition(ax);
+    acc_y = imu660rb_acc_transition(ay);
+    acc_z = imu660rb_acc_transition(az);
+    norm = fast_inv_sqrt(acc_x * acc_x + acc_y * acc_y + acc_z * acc_z);
+
+    // 陀螺仪数据转换为弧度/秒后更新姿态
+    Mahony_Update(&ahrs,
+                  imu660rb_gyro_transition(gx) * DEG_TO_RAD,
+                  imu660rb_gyro_transition(gy) * DEG_TO_RAD,
+                  imu660rb_gyro_transition(gz) * DEG_TO_RAD,
+                  acc_x * norm, acc_y * norm, acc_z * norm, imu_dt_us * 0.000001f);
+#endif
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     发布姿态解算结果
+// 参数说明     void
+// 返回参数     void
+// 使用示例     imu_publish();
+// 备注信息     四元数复制到 imu 并发布快照，imu 中的原始数据和时间戳由调用者先填好
+//-------------------------------------------------------------------------------------------------------------------
+static void imu_publish(void)
+{
+#if(MAHONY_USE_FIXED)
+    // 定点四元数转换到 ahrs
+    Mahony_Fixed_ToFloat(&ahrs_fixed, &ahrs);
+#endif
+
+    // 获取四元数结果
+    imu.q0 = ahrs.q0;
+    imu.q1 = ahrs.q1;
+    imu.q2 = ahrs.q2;
+    imu.q3 = ahrs.q3;
 
-    imu.gyro_x = imu660rb_gyro_transition(imu660rb_gyro_x);
-    imu.gyro_y = imu660rb_gyro_transition(imu660rb_gyro_y);
-    imu.gyro_z = imu660rb_gyro_transition(imu660rb_gyro_z);
+    // 欧拉角改为读取时计算 (imu_get_euler / imu_get_yaw)，这里只标记缓存失效
+    imu.euler_valid = 0;
+    imu.dt_us = imu_dt_us;
+
+    // 发布快照
+    snapshot_publish(&imu_snap, &imu);
 }
 
+#if(IMU660RB_USE_DMA)
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     IMU660RB DMA 读取完成回调
+// 参数说明     void
+// 返回参数     void
+// 使用示例     imu660rb_dma_callback = imu_dma_complete;
+// 备注信息     在 DMA_SPI 中断中调用，完成 imu_update() 启动的读取之后的解算
+//              FIFO 模式下每段读完后重新检查FIFO，仍不低于水位就继续读取，读空后发布本批结果
+//              传输期间到来的水位中断不会启动读取，由这里的重新检查接上，不会丢失下降沿
+//-------------------------------------------------------------------------------------------------------------------
+static void imu_dma_complete(void)
+{
+#if(IMU_USE_FIFO)
+    uint8 num;
+    uint8 i;
+
+    num = imu660rb_fifo_read_dma_finish(imu_fifo_buf);
+    for(i = 0; i < num; i++)
+    {
+        imu_ahrs_step(imu_fifo_buf[i].gyro_x, imu_fifo_buf[i].gyro_y, imu_fifo_buf[i].gyro_z,
+                      imu_fifo_buf[i].acc_x, imu_fifo_buf[i].acc_y, imu_fifo_buf[i].acc_z);
+    }
+    imu_dma_total += num;
+
+    // FIFO 仍不低于水位，继续读取下一段
+    if(imu660rb_fifo_read_dma())
+    {
+        return;
+    }
+
+    if(imu_dma_total == 0)
+    {
+        return;
+    }
+
+    // imu 中的原始数据为本批最后一个采样，时间戳为本批开始读取的时刻
+    imu.stamp = imu_dma_stamp;
+    imu_dt_update(imu_dma_stamp, imu_dma_total);
+    imu_convert_data();
+#else
+    imu660rb_get_acc_gyro_dma_finish();
+    imu.stamp = imu_dma_stamp;
+    imu_dt_update(imu.stamp, 1);
+    imu_convert_data();
+
+    imu_ahrs_step(imu660rb_gyro_x, imu660rb_gyro_y, imu660rb_gyro_z,
+                  imu660rb_acc_x, imu660rb_acc_y, imu660rb_acc_z);
+#endif
+
+    imu_publish();
+}
+#endif
+
 //-------------------------------------------------------------------------------------------------------------------
 // 函数简介     IMU数据更新
 // 参数说明     void
 // 返回参数     void
 // 使用示例     imu_update();
 // 备注信息     获取原始数据并使用Mahony算法进行四元数解算
-//              需要周期调用，建议10ms(100Hz)或根据IMU_SAMPLE_RATE调整
+//              IMU_USE_FIFO 为1时在FIFO水位中断中调用，读空FIFO (低于水位) 并逐个采样积分
+//              IMU_USE_FIFO 为0时需要周期调用，建议10ms(100Hz)或根据IMU_SAMPLE_RATE调整
+//              MAHONY_USE_FIXED 为1时用原始值做Q30定点解算，结果转换到 ahrs 的浮点四元数
+//              IMU660RB_USE_DMA 为1时这里只启动DMA读取后立即返回，解算在 imu_dma_complete() 中完成
+//              上一次传输未完成时本次调用不做任何事
 //-------------------------------------------------------------------------------------------------------------------
 void imu_update(void)
 {
-    float ax, ay, az;
-    float gx, gy, gz;
-    float norm;
+#if(IMU660RB_USE_DMA)
+#if(IMU_USE_FIFO)
+    if(!imu660rb_dma_busy())
+    {
+        imu_dma_total = 0;
+        imu_dma_stamp = timebase_now_us();
+        imu660rb_fifo_read_dma();
+    }
+#else
+    uint32 stamp;
 
-    // 1. 获取IMU原始数据
+    stamp = timebase_now_us();
+    if(imu660rb_get_acc_gyro_dma() == 0)
+    {
+        imu_dma_stamp = stamp;
+    }
+#endif
+#else
+#if(IMU_USE_FIFO)
+    uint16 remain;
+    uint8 num;
+    uint8 i;
+    uint16 total;
+    uint32 stamp;
+
+    // 1-2. 读出FIFO中的全部采样，每个陀螺仪采样积分一次
+    //      剩余字数低于水位时 INT1 恢复高电平，下一次达到水位产生新的下降沿
+    stamp = timebase_now_us();
+    total = 0;
+    do
+    {
+        remain = imu660rb_fifo_read(imu_fifo_buf, &num);
+        for(i = 0; i < num; i++)
+        {
+            imu_ahrs_step(imu_fifo_buf[i].gyro_x, imu_fifo_buf[i].gyro_y, imu_fifo_buf[i].gyro_z,
+                          imu_fifo_buf[i].acc_x, imu_fifo_buf[i].acc_y, imu_fifo_buf[i].acc_z);
+        }
+        total += num;
+    }while(remain >= IMU660RB_FIFO_WATERMARK);
+
+    if(total == 0)
+    {
+        return;
+    }
+
+    // 3. imu 中的原始数据为本批最后一个采样，时间戳为本批开始读取的时刻
+    imu.stamp = stamp;
+    imu_dt_update(stamp, total);
+    imu_convert_data();
+#else
+    // 1. 获取IMU原始数据，用时间戳测量采样周期
     imu_get_data();
+    imu_dt_update(imu.stamp, 1);
 
-    // 2. 归一化加速度计数据（Mahony算法要求输入归一化后的加速度）
-    norm = Fast_InvSqrt(imu.acc_x * imu.acc_x + imu.acc_y * imu.acc_y + imu.acc_z * imu.acc_z);
-    ax = imu.acc_x * norm;
-    ay = imu.acc_y * norm;
-    az = imu.acc_z * norm;
+    // 2. 姿态解算
+    imu_ahrs_step(imu660rb_gyro_x, imu660rb_gyro_y, imu660rb_gyro_z,
+                  imu660rb_acc_x, imu660rb_acc_y, imu660rb_acc_z);
+#endif
 
-    // 3. 陀螺仪数据转换为弧度/秒
-    gx = imu.gyro_x * DEG_TO_RAD;
-    gy = imu.gyro_y * DEG_TO_RAD;
-    gz = imu.gyro_z * DEG_TO_RAD;
+    // 4. 四元数结果复制到 imu 并发布快照
+    imu_publish();
+#endif
+}
 
-    // 4. 使用Mahony算法更新姿态
-    Mahony_Update(&ahrs, gx, gy, gz, ax, ay, az, DT);
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     获取IMU数据快照
+// 参数说明     out             输出 最近一次 imu_update() 完成后的全部IMU数据
+// 返回参数     void
+// 使用示例     imu_get_snapshot(&imu_view);
+// 备注信息     可在主循环或其他中断中调用，不关闭中断
+//-------------------------------------------------------------------------------------------------------------------
+void imu_get_snapshot(struct IMUData *out)
+{
+    snapshot_read(&imu_snap, out);
+}
 
-    // 5. 获取四元数结果
-    imu.q0 = ahrs.q0;
-    imu.q1 = ahrs.q1;
-    imu.q2 = ahrs.q2;
-    imu.q3 = ahrs.q3;
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     计算欧拉角 (按需计算并缓存)
+// 参数说明     data            IMU数据 (一般为 imu_get_snapshot() 得到的副本)
+// 返回参数     void
+// 使用示例     imu_get_euler(&imu_view); printf("%.2f", imu_view.roll);
+// 备注信息     euler_valid 已置位时不重复计算
+//-------------------------------------------------------------------------------------------------------------------
+void imu_get_euler(struct IMUData *data)
+{
+    struct Quaternion_t quat;
+    struct EulerAngle_t euler;
+
+    if(data->euler_valid & IMU_EULER_ALL_VALID)
+    {
+        return;
+    }
 
-    // 6. 转换为欧拉角
-    Mahony_GetEuler(&ahrs, (struct EulerAngle_t *)&imu.roll);
+    quat.q0 = data->q0;
+    quat.q1 = data->q1;
+    quat.q2 = data->q2;
+    quat.q3 = data->q3;
+    Quaternion_ToEuler(&quat, &euler);
+
+    // 归一化角度到-180~180度范围
+    data->roll = angle_normalize(euler.roll);
+    data->pitch = angle_normalize(euler.pitch);
+    data->yaw = angle_normalize(euler.yaw);
+    data->euler_valid = IMU_EULER_YAW_VALID | IMU_EULER_ALL_VALID;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     计算偏航角 (按需计算并缓存)
+// 参数说明     data            IMU数据 (一般为 imu_get_snapshot() 得到的副本)
+// 返回参数     float           偏航角 (度, -180 ~ 180)
+// 使用示例     float yaw = imu_get_yaw(&imu_view);
+// 备注信息     roll/pitch 不计算，之后调用 imu_get_euler() 时再补齐
+//-------------------------------------------------------------------------------------------------------------------
+float imu_get_yaw(struct IMUData *data)
+{
+    struct Quaternion_t quat;
+
+    if(!(data->euler_valid & IMU_EULER_YAW_VALID))
+    {
+        quat.q0 = data->q0;
+        quat.q1 = data->q1;
+        quat.q2 = data->q2;
+        quat.q3 = data->q3;
+        data->yaw = angle_normalize(Quaternion_ToYaw(&quat));
+        data->euler_valid |= IMU_EULER_YAW_VALID;
+    }
 
-    // 7. 归一化角度到-180~180度范围
-    imu.roll = angle_normalize(imu.roll);
-    imu.pitch = angle_normalize(imu.pitch);
-    imu.yaw = angle_normalize(imu.yaw);
+    return data->yaw;
 }
@@ -4,8 +4,37 @@
 #include "zf_common_headfile.h"
 #include "quaternion.h"
 
+// IMU采集方式: 1-FIFO水位中断批量读取 0-调度器按 IMU_UPDATE_PERIOD 每次读一组数据
+// FIFO 方式需要把 IMU660RB 的 INT1 飞线到 IMU_FIFO_INT_PIN (P36)，现有的车都没有这根线，默认使用轮询
+#define IMU_USE_FIFO            (0)
+#define IMU_FIFO_INT_PIN        (INT2_P36)    // IMU660RB INT1 连接的外部中断 如果修改 需要同步修改 main.c 中的 int2_irq_handler
+
+#if(IMU_USE_FIFO)
+#define IMU_SAMPLE_RATE 416                   // 与 IMU660RB_FIFO_GYR_ODR 一致，每个陀螺仪采样积分一次
+#define DT_US (2400UL)                        // 416Hz 档由 6667Hz 内部时钟16分频得到，周期正好 2400us (按416算会有0.16%的积分误差)
+#else
 #define IMU_SAMPLE_RATE 100
-#define DT (1.0f / IMU_SAMPLE_RATE)
+#define DT_US (1000000UL / IMU_SAMPLE_RATE)
+#endif
+#define DT (DT_US * 0.000001f)
+
+// 采样时间戳单位 (us)，imu.stamp 为读取传感器时的 timebase_now_us()
+#define IMU_STAMP_US            (1)
+
+// 姿态解算使用的采样周期由时间戳测量，DT_US 只作为初值和合理范围的中心
+//   FIFO: 采样由传感器内部时钟定时，按 IMU_DT_WINDOW 个采样累计的时间估计实际周期 (读取时刻的抖动被平均掉)
+//   非FIFO: 两次读取的时间戳之差
+// 测量值超出 DT_US 的 ±IMU_DT_TOLERANCE 时不采用 (FIFO溢出、读取停顿、第一次读取)
+#define IMU_DT_WINDOW           (2048)        // FIFO 模式估计周期的采样数 (416Hz 约4.9s)
+#if(IMU_USE_FIFO)
+#define IMU_DT_TOLERANCE        (DT_US / 20)  // 传感器内部时钟误差范围 ±5%
+#else
+#define IMU_DT_TOLERANCE        (DT_US / 2)   // 读取周期抖动范围 ±50%
+#endif
+
+// 欧拉角缓存标志 (IMUData.euler_valid)
+#define IMU_EULER_YAW_VALID     (0x01)    // yaw 已由当前四元数计算
+#define IMU_EULER_ALL_VALID     (0x02)    // roll/pitch/yaw 已由当前四元数计算
 
 struct IMUData
 {
@@ -22,14 +51,48 @@ struct IMUData
     float roll;
     float pitch;
     float yaw;
+    uint8 euler_valid;                    // 欧拉角缓存标志，imu_update() 更新四元数后清零
+    uint32 stamp;                         // 采样时间戳 (读取传感器的时刻，us)
+    uint16 dt_us;                         // 姿态解算使用的采样周期 (us)
 };
 
 extern struct IMUData imu;
 extern struct MahonyAHRS_t ahrs;
+extern struct MahonyAHRS_Fixed_t ahrs_fixed;
 
 uint8 imu_init(void);
 void imu_update(void);
 void imu_get_data(void);
+void imu_fifo_start(void);
 float angle_normalize(float angle);
 
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     获取IMU数据快照
+// 参数说明     out             输出 最近一次 imu_update() 完成后的全部IMU数据
+// 返回参数     void
+// 使用示例     imu_get_snapshot(&imu_view);
+// 备注信息     imu 全局变量在 imu_update() 执行期间是半更新状态，其他上下文读取IMU数据应使用本函数
+//              四元数、角速度、欧拉角来自同一次更新
+//-------------------------------------------------------------------------------------------------------------------
+void imu_get_snapshot(struct IMUData *out);
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     计算欧拉角 (按需计算并缓存)
+// 参数说明     data            IMU数据 (一般为 imu_get_snapshot() 得到的副本)
+// 返回参数     void
+// 使用示例     imu_get_euler(&imu_view); printf("%.2f", imu_view.roll);
+// 备注信息     imu_update() 只更新四元数，roll/pitch/yaw 在第一次读取时由四元数计算 (2次atan2 + 1次asin)
+//              同一份数据再次调用直接返回，不要对正在中断中更新的 imu 全局变量调用
+//-------------------------------------------------------------------------------------------------------------------
+void imu_get_euler(struct IMUData *data);
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     计算偏航角 (按需计算并缓存)
+// 参数说明     data            IMU数据 (一般为 imu_get_snapshot() 得到的副本)
+// 返回参数     float           偏航角 (度, -180 ~ 180)
+// 使用示例     float yaw = imu_get_yaw(&imu_view);
+// 备注信息     航向判断只需要 yaw 时使用，只计算1次atan2
+//-------------------------------------------------------------------------------------------------------------------
+float imu_get_yaw(struct IMUData *data);
+
 #endif
@@ -2,12 +2,36 @@
 // 头文件包含
 //-------------------------------------------------------------------------------------------------------------------
 #include "adc.h"
+#include "myeeprom.h"
 
 //-------------------------------------------------------------------------------------------------------------------
 // 全局变量定义
 //-------------------------------------------------------------------------------------------------------------------
-uint16 adc_val_list[CHANNEL_NUMBER] = {0};                      // ADC原始值数组
+uint16 adc_val_list[CHANNEL_NUMBER] = {0};                      // ADC原始值数组 (已限幅)
+uint16 adc_raw_list[CHANNEL_NUMBER] = {0};                      // ADC滤波后未限幅的值
+uint16 adc_fine_list[CHANNEL_NUMBER] = {0};                     // 过采样抽取后的14位值
 uint8 channel_index = 0;                                        // 当前通道索引
+vuint16 adc_scan_seq = 0;                                       // 后台扫描完成帧计数
+uint32 adc_scan_stamp = 0;                                      // Adc_Getval_Scan 读取的帧完成时刻 (us)
+
+// 后台扫描双缓冲 [缓冲区][通道][样本]，中断写 adc_scan_write_bank，读取 adc_scan_ready_bank
+static uint16 adc_scan_buffer[2][CHANNEL_NUMBER][ADC_SCAN_DEPTH];
+static uint32 adc_scan_buffer_stamp[2];                         // 各缓冲区最后一个通道转换完成的时刻
+static vuint8 adc_scan_write_bank = 0;                          // 中断正在写入的缓冲区
+static vuint8 adc_scan_ready_bank = 0;                          // 最近一次写满的缓冲区
+static vuint8 adc_scan_channel = 0;                             // 正在转换的通道索引
+static vuint8 adc_scan_index = 0;                               // 当前帧内样本索引
+static vuint8 adc_scan_running = 0;                             // 扫描运行标志
+static uint16 adc_scan_seq_used = 0;                            // Adc_Getval_Scan 上次读取的帧计数
+
+// 扫描校准状态 (10ms中断写入，主循环读取)
+static vuint8 adc_calib_active = 0;                             // 校准进行中标志
+static vuint16 adc_calib_frames = 0;                            // 已记录的有效帧数
+static uint16 adc_calib_max[CHANNEL_NUMBER];                    // 记录的峰值
+static uint16 adc_calib_min[CHANNEL_NUMBER];                    // 记录的谷值
+static uint16 adc_calib_history[CHANNEL_NUMBER][3];             // 最近3帧原始值，用于中值去尖峰
+static uint8 adc_calib_fill = 0;                                // 历史缓冲已填入的帧数 (最多3)
+static uint8 adc_calib_pos = 0;                                 // 历史缓冲写入位置
 
 // ADC通道枚举数组 - 按从左到右顺序排列
 adc_channel_enum channel_list[CHANNEL_NUMBER] =
@@ -16,7 +40,7 @@ adc_channel_enum channel_list[CHANNEL_NUMBER] =
 };
 
 // ADC最大最小值校准数组 [偶数索引=最大值, 奇数索引=最小值]
-// 需要根据实际传感器校准修改这些值
+// 需要根据实际传感器校准修改这些值，修改后需调用 Normalization_Update_Scale()
 uint16 max_min_adc[2*CHANNEL_NUMBER] = {
     3532, 0,     // L1: 最大值, 最小值
     3522, 0,     // L2: 最大值, 最小值
@@ -31,6 +55,8 @@ uint16 max_min_adc[2*CHANNEL_NUMBER] = {
 // 返回参数     void
 // 使用示例     Adc_All_Init();
 // 备注信息     初始化5个ADC通道为12位精度
+//              ADC_GETVAL_METHOD 为 ADC_METHOD_SCAN/ADC_METHOD_OVERSAMPLE 时同时启动后台扫描
+//              ADC_GETVAL_METHOD 为 ADC_METHOD_FILTER 时同时填满滑动窗口滤波器
 //-------------------------------------------------------------------------------------------------------------------
 void Adc_All_Init(void)
 {
@@ -39,6 +65,16 @@ void Adc_All_Init(void)
     adc_init(ADC_M3, ADC_12BIT);         // M3 中间传感器
     adc_init(ADC_R4, ADC_12BIT);         // R4 右侧传感器4
     adc_init(ADC_R5, ADC_12BIT);         // R5 右侧传感器5
+
+    // 加载扫描校准结果，EEPROM 中没有有效数据时保留默认值
+    myeeprom_load_adc_calib(max_min_adc, 2*CHANNEL_NUMBER);
+    Normalization_Update_Scale();        // 根据 max_min_adc[] 计算归一化缩放表
+
+#if(ADC_USE_SCAN)
+    Adc_Scan_Start();                    // 启动后台扫描
+#elif(ADC_GETVAL_METHOD == ADC_METHOD_FILTER)
+    Adc_Filter_Init();                   // 填满滑动窗口
+#endif
 }
 
 //-------------------------------------------------------------------------------------------------------------------
@@ -68,9 +104,14 @@ uint16 limit(uint16 adc_val, uint8 index)
 // 返回参数     void
 // 使用示例     Adc_Test();
 // 备注信息     打印所有通道的ADC原始值和平均值滤波后的值
+//              后台扫描模式下测试期间暂停扫描，结束后重新启动
 //-------------------------------------------------------------------------------------------------------------------
 void Adc_Test(void)
 {
+#if(ADC_USE_SCAN)
+    Adc_Scan_Stop();                     // 查询式转换不能与后台扫描同时进行
+#endif
+
     // 打印原始转换值
     for(channel_index = 0; channel_index < CHANNEL_NUMBER; channel_index++)
     {
@@ -88,6 +129,157 @@ void Adc_Test(void)
                adc_mean_filter_convert(channel_list[channel_index], 10));
     }
     system_delay_ms(500);
+
+#if(ADC_USE_SCAN)
+    Adc_Scan_Start();
+#endif
+}
+
+//===================================================================================================================
+// 后台扫描引擎实现
+//===================================================================================================================
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     启动ADC后台扫描
+// 参数说明     void
+// 返回参数     void
+// 使用示例     Adc_Scan_Start();
+// 备注信息     开启ADC转换完成中断，按 channel_list[] 顺序轮流转换5个通道
+//              通道交错采样，一帧内各通道的采样时刻基本一致
+//              扫描运行期间不要调用 adc_convert() 等查询式采样函数
+//-------------------------------------------------------------------------------------------------------------------
+void Adc_Scan_Start(void)
+{
+    adc_scan_write_bank = 0;
+    adc_scan_ready_bank = 0;
+    adc_scan_channel = 0;
+    adc_scan_index = 0;
+    adc_scan_running = 1;
+
+    ADC_CONTR &= ~0x20;                                         // 清完成标志
+    EADC = 1;                                                   // 使能ADC中断
+
+    ADC_CONTR = (ADC_CONTR & 0xF0) | channel_list[0];           // 选择第一个通道
+    ADC_CONTR |= 0x40;                                          // 启动第一次转换
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     停止ADC后台扫描
+// 参数说明     void
+// 返回参数     void
+// 使用示例     Adc_Scan_Stop();
+// 备注信息     等待当前转换结束后关闭ADC中断，之后可以使用查询式采样函数
+//-------------------------------------------------------------------------------------------------------------------
+void Adc_Scan_Stop(void)
+{
+    adc_scan_running = 0;                                       // 中断不再启动下一次转换
+    while(ADC_CONTR & 0x40);                                    // 等待正在进行的转换结束
+    EADC = 0;
+    ADC_CONTR &= ~0x20;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     ADC转换完成中断处理
+// 参数说明     void
+// 返回参数     void
+// 使用示例     Adc_Scan_Isr();
+// 备注信息     在 isr.c 的 ADC 中断中调用，保存结果并启动下一通道转换
+//              每通道写满 ADC_SCAN_DEPTH 个样本后记录完成时刻并切换缓冲区，adc_scan_seq 加1
+//-------------------------------------------------------------------------------------------------------------------
+void Adc_Scan_Isr(void)
+{
+    uint16 value;
+
+    ADC_CONTR &= ~0x20;                                         // 清完成标志
+
+    value = ADC_RES;                                            // 12位结果右对齐
+    value <<= 8;
+    value |= ADC_RESL;
+    adc_scan_buffer[adc_scan_write_bank][adc_scan_channel][adc_scan_index] = value;
+
+    // 切换到下一通道，5个通道轮完后样本索引加1
+    adc_scan_channel++;
+    if(adc_scan_channel >= CHANNEL_NUMBER)
+    {
+        adc_scan_channel = 0;
+        adc_scan_index++;
+        if(adc_scan_index >= ADC_SCAN_DEPTH)
+        {
+            // 当前缓冲区写满，发布为最新帧并切换到另一个缓冲区
+            adc_scan_index = 0;
+            adc_scan_buffer_stamp[adc_scan_write_bank] = timebase_now_us();
+            adc_scan_ready_bank = adc_scan_write_bank;
+            adc_scan_write_bank ^= 1;
+            adc_scan_seq++;
+        }
+    }
+
+    if(adc_scan_running)
+    {
+        ADC_CONTR = (ADC_CONTR & 0xF0) | channel_list[adc_scan_channel];
+        ADC_CONTR |= 0x40;                                      // 启动下一次转换
+    }
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     获取所有ADC值 - 后台扫描最近一帧去极值平均
+// 参数说明     void
+// 返回参数     uint8           1-取到新的扫描帧 0-自上次调用以来没有新帧(adc_val_list[]不变)
+// 使用示例     if(Adc_Getval_Scan()) { Normalization(); }
+// 备注信息     对已采集好的 ADC_SCAN_DEPTH 个样本去掉最大最小后取平均并限幅
+//              同时输出过采样抽取后的14位值 adc_fine_list[] 和该帧的完成时刻 adc_scan_stamp，不额外转换
+//              读取期间如果缓冲区发生切换则重读一次，保证一帧数据来自同一次扫描
+//-------------------------------------------------------------------------------------------------------------------
+uint8 Adc_Getval_Scan(void)
+{
+    uint16 seq;
+    uint16 *sample;
+    uint16 temp, max, min;
+    uint32 sum;
+    uint8 i, j;
+
+    seq = adc_scan_seq;
+    if(seq == adc_scan_seq_used)
+    {
+        return 0;
+    }
+
+    do
+    {
+        seq = adc_scan_seq;
+        adc_scan_stamp = adc_scan_buffer_stamp[adc_scan_ready_bank];
+        for(i = 0; i < CHANNEL_NUMBER; i++)
+        {
+            sample = adc_scan_buffer[adc_scan_ready_bank][i];
+            max = sample[0];
+            min = sample[0];
+            sum = sample[0];
+            for(j = 1; j < ADC_SCAN_DEPTH; j++)
+            {
+                temp = sample[j];
+                if(max < temp)
+                {
+                    max = temp;
+                }
+                if(min > temp)
+                {
+                    min = temp;
+                }
+                sum += temp;
+            }
+
+            // 去掉最大值和最小值后求平均
+            temp = (uint16)((sum - max - min) / (ADC_SCAN_DEPTH - 2));
+            adc_raw_list[i] = temp;
+            adc_val_list[i] = limit(temp, i);
+
+            // 过采样抽取: 4^n 个样本求和右移 n 位，有效分辨率提高 n 位 (依赖样本中的噪声抖动)
+            adc_fine_list[i] = (uint16)(sum >> ADC_OVERSAMPLE_BITS);
+        }
+    }while(seq != adc_scan_seq);
+
+    adc_scan_seq_used = seq;
+    return 1;
 }
 
 //-------------------------------------------------------------------------------------------------------------------
@@ -104,10 +296,8 @@ void Adc_Getval_Fast(void)
 {
     for(channel_index = 0; channel_index < CHANNEL_NUMBER; channel_index++)
     {
-        adc_val_list[channel_index] = limit(
-            adc_sample(channel_list[channel_index]),
-            channel_index
-        );
+        adc_raw_list[channel_index] = adc_sample(channel_list[channel_index]);
+        adc_val_list[channel_index] = limit(adc_raw_list[channel_index], channel_index);
     }
 }
 
@@ -124,11 +314,159 @@ void Adc_Getval_Quick(void)
 {
     for(channel_index = 0; channel_index < CHANNEL_NUMBER; channel_index++)
     {
-        adc_val_list[channel_index] = limit(
-            adc_mid_sample(channel_list[channel_index]),
-            channel_index
-        );
+        adc_raw_list[channel_index] = adc_mid_sample(channel_list[channel_index]);
+        adc_val_list[channel_index] = limit(adc_raw_list[channel_index], channel_index);
+    }
+}
+
+//===================================================================================================================
+// 扫描校准实现
+//===================================================================================================================
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     开始扫描校准
+// 参数说明     void
+// 返回参数     void
+// 使用示例     Adc_Calib_Start();
+// 备注信息     清空记录后置位 adc_calib_active，由10ms中断中的 Adc_Calib_Feed() 开始记录
+//-------------------------------------------------------------------------------------------------------------------
+void Adc_Calib_Start(void)
+{
+    uint8 i;
+
+    adc_calib_active = 0;                                       // 先停止记录再清空
+    for(i = 0; i < CHANNEL_NUMBER; i++)
+    {
+        adc_calib_max[i] = 0;
+        adc_calib_min[i] = 0xFFFF;
+    }
+    adc_calib_frames = 0;
+    adc_calib_fill = 0;
+    adc_calib_pos = 0;
+    adc_calib_active = 1;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     扫描校准记录一帧
+// 参数说明     void
+// 返回参数     void
+// 使用示例     Adc_Calib_Feed();
+// 备注信息     在 Adc_Frame_Update() 取到新帧后调用
+//              每通道取最近3帧 adc_raw_list[] 的中值更新峰谷值，单帧干扰尖峰不会成为峰值或谷值
+//-------------------------------------------------------------------------------------------------------------------
+void Adc_Calib_Feed(void)
+{
+    uint16 mid;
+    uint8 i;
+
+    if(!adc_calib_active)
+    {
+        return;
+    }
+
+    for(i = 0; i < CHANNEL_NUMBER; i++)
+    {
+        adc_calib_history[i][adc_calib_pos] = adc_raw_list[i];
+    }
+    adc_calib_pos++;
+    if(adc_calib_pos >= 3)
+    {
+        adc_calib_pos = 0;
+    }
+    if(adc_calib_fill < 3)
+    {
+        adc_calib_fill++;
+        return;                                                 // 历史不足3帧，暂不记录
+    }
+
+    for(i = 0; i < CHANNEL_NUMBER; i++)
+    {
+        mid = median3(adc_calib_history[i][0], adc_calib_history[i][1], adc_calib_history[i][2]);
+
+        if(mid > adc_calib_max[i])
+        {
+            adc_calib_max[i] = mid;
+        }
+        if(mid < adc_calib_min[i])
+        {
+            adc_calib_min[i] = mid;
+        }
+    }
+    adc_calib_frames++;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     结束扫描校准并保存
+// 参数说明     void
+// 返回参数     uint8           ADC_CALIB_OK 或 ADC_CALIB_ERR_xxx
+// 使用示例     if(Adc_Calib_Finish() == ADC_CALIB_OK) { ... }
+// 备注信息     帧数不少于 ADC_CALIB_MIN_FRAMES 且每通道跨度不小于 ADC_CALIB_MIN_SPAN 才会生效
+//              更新 max_min_adc[] 后重新计算归一化缩放表，再写入 EEPROM
+//              控制中断只使用 Normalization_Update_Scale() 整体发布的缩放表 (含 min)，更新期间仍用旧校准值归一化
+//-------------------------------------------------------------------------------------------------------------------
+uint8 Adc_Calib_Finish(void)
+{
+    uint8 i;
+
+    adc_calib_active = 0;                                       // 停止记录，之后的数据不再变化
+
+    if(adc_calib_frames < ADC_CALIB_MIN_FRAMES)
+    {
+        return ADC_CALIB_ERR_FRAMES;
+    }
+
+    for(i = 0; i < CHANNEL_NUMBER; i++)
+    {
+        if(adc_calib_max[i] < adc_calib_min[i] + ADC_CALIB_MIN_SPAN)
+        {
+            return ADC_CALIB_ERR_SPAN;
+        }
+    }
+
+    for(i = 0; i < CHANNEL_NUMBER; i++)
+    {
+        max_min_adc[2*i] = adc_calib_max[i];
+        max_min_adc[2*i+1] = adc_calib_min[i];
     }
+    Normalization_Update_Scale();
+
+    if(myeeprom_save_adc_calib(max_min_adc, 2*CHANNEL_NUMBER))
+    {
+        return ADC_CALIB_ERR_SAVE;
+    }
+
+    return ADC_CALIB_OK;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     取消扫描校准
+// 参数说明     void
+// 返回参数     void
+// 使用示例     Adc_Calib_Cancel();
+// 备注信息     丢弃本次记录，max_min_adc[] 保持原值
+//-------------------------------------------------------------------------------------------------------------------
+void Adc_Calib_Cancel(void)
+{
+    adc_calib_active = 0;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     获取扫描校准当前记录值
+// 参数说明     index           通道索引 (0 ~ CHANNEL_NUMBER-1)
+// 参数说明     max             输出 当前记录的峰值
+// 参数说明     min             输出 当前记录的谷值
+// 返回参数     void
+// 使用示例     Adc_Calib_Get(0, &max, &min);
+// 备注信息     还没有记录到有效帧时 max 为0，min 为0xFFFF
+//-------------------------------------------------------------------------------------------------------------------
+void Adc_Calib_Get(uint8 index, uint16 *max, uint16 *min)
+{
+    if(index >= CHANNEL_NUMBER)
+    {
+        return;
+    }
+    *max = adc_calib_max[index];
+    *min = adc_calib_min[index];
 }
 
 //===================================================================================================================
@@ -144,34 +482,15 @@ void Adc_Getval_Quick(void)
 //-------------------------------------------------------------------------------------------------------------------
 uint16 adc_mid_sample(adc_channel_enum ch)
 {
-    uint16 i, j, k, tmp;
+    uint16 i, j, k;
 
     // 采样3次
     i = adc_convert(ch);
     j = adc_convert(ch);
     k = adc_convert(ch);
 
-    // 选择中值 (三数排序取中间值)
-    if(i > j)
-    {
-        tmp = i;
-        i = j;
-        j = tmp;
-    }
-    if(k > j)
-    {
-        tmp = j;
-    }
-    else if(k > i)
-    {
-        tmp = k;
-    }
-    else
-    {
-        tmp = i;
-    }
-
-    return tmp;
+    // 选择中值 (3次比较交换)
+    return median3(i, j, k);
 }
 
 //-------------------------------------------------------------------------------------------------------------------
@@ -214,3 +533,76 @@ uint16 adc_sample(adc_channel_enum ch)
     return temp;
 }
 
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     中值+去极值组合滤波 (中值滤波后再去极值平均)
+// 参数说明     ch              ADC通道枚举
+// 返回参数     uint16          滤波后的ADC值
+// 使用示例     uint16 val = adc_sample_b(ADC_L1);
+// 备注信息     连续取8次三次中值，去掉最大最小后对剩余6个取平均，共24次转换
+//              优点: 双重滤波，更强的抗干扰能力
+//-------------------------------------------------------------------------------------------------------------------
+uint16 adc_sample_b(adc_channel_enum ch)
+{
+    uint16 temp, sum, max, min;
+    uint8 i;
+
+    // 第一次中值采样
+    temp = adc_mid_sample(ch);
+    max = temp;
+    min = temp;
+    sum = temp;
+
+    // 继续中值采样7次
+    for(i = 1; i < 8; i++)
+    {
+        temp = adc_mid_sample(ch);
+        if(max < temp)
+        {
+            max = temp;
+        }
+        if(min > temp)
+        {
+            min = temp;
+        }
+        sum += temp;
+    }
+
+    // 去掉最大值和最小值后求平均 (8-2=6)
+    temp = (sum - max - min) / 6;
+
+    return temp;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     排序取中值滤波 (7次采样排序后取中值)
+// 参数说明     ch              ADC通道枚举
+// 返回参数     uint16          中值
+// 使用示例     uint16 val = adc_sample_a(ADC_L1);
+// 备注信息     采样 ADC_Sample_Num(7) 次，排序后取第4个值(中值)
+//-------------------------------------------------------------------------------------------------------------------
+uint16 adc_sample_a(adc_channel_enum ch)
+{
+    uint16 arr[ADC_Sample_Num];
+    uint8 i;
+
+    for(i = 0; i < ADC_Sample_Num; i++)
+    {
+        arr[i] = adc_convert(ch);
+    }
+
+    return sort_seven(arr);
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     7元素排序
+// 参数说明     arr             7元素数组指针
+// 返回参数     uint16          排序后的中值 arr[3]
+// 使用示例     mid = sort_seven(arr);
+// 备注信息     使用16次比较交换的固定排序网络 (冒泡排序需要21次比较)，执行后 arr[] 从小到大排列
+//              只需要中值时 median_of_7() 只要13次比较交换
+//-------------------------------------------------------------------------------------------------------------------
+uint16 sort_seven(uint16 arr[])
+{
+    sort_network_7(arr);
+    return arr[3];
+}
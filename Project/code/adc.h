@@ -20,14 +20,54 @@
 //-------------------------------------------------------------------------------------------------------------------
 #define CHANNEL_NUMBER          (5)       // ADC通道数量
 #define ADC_Sample_Num          (7)       // ADC采样深度
+#define ADC_SCAN_DEPTH          (16)      // 后台扫描每通道每帧样本数
+
+//-------------------------------------------------------------------------------------------------------------------
+// 采样帧数据来源选择 (Adc_Frame_Update 使用)
+//-------------------------------------------------------------------------------------------------------------------
+#define ADC_METHOD_QUICK        (0)       // 中断内轮询: 每通道3次转换取中值 Adc_Getval_Quick()
+#define ADC_METHOD_SCAN         (1)       // 后台中断扫描: 取最近一帧去极值平均 Adc_Getval_Scan()
+#define ADC_METHOD_FILTER       (2)       // 中断内每通道1次转换，滑动窗口滤波 Adc_Getval_Filter() (adc_filter.c)
+#define ADC_METHOD_OVERSAMPLE   (3)       // 后台中断扫描 + 过采样抽取14位，额外输出0-1000精细归一化值
+
+#define ADC_GETVAL_METHOD       ADC_METHOD_OVERSAMPLE   // 当前使用的采样方式
+
+// 是否使用后台扫描引擎
+#define ADC_USE_SCAN            ((ADC_GETVAL_METHOD == ADC_METHOD_SCAN) || (ADC_GETVAL_METHOD == ADC_METHOD_OVERSAMPLE))
+
+//-------------------------------------------------------------------------------------------------------------------
+// 过采样抽取参数
+//-------------------------------------------------------------------------------------------------------------------
+// 4^n 个样本求和后右移 n 位得到 12+n 位结果，一帧 ADC_SCAN_DEPTH 个样本正好对应 n=2 (14位)
+#define ADC_OVERSAMPLE_BITS     (2)       // 过采样增加的有效位数
+#define ADC_FINE_MAX            (4095 << ADC_OVERSAMPLE_BITS)   // 过采样结果满量程
+
+#if(ADC_SCAN_DEPTH != (1 << (2 * ADC_OVERSAMPLE_BITS)))
+#error "ADC_SCAN_DEPTH must be 4^ADC_OVERSAMPLE_BITS"
+#endif
+
+//-------------------------------------------------------------------------------------------------------------------
+// 扫描校准参数
+//-------------------------------------------------------------------------------------------------------------------
+#define ADC_CALIB_MIN_SPAN      (200)     // 校准有效的最小 max-min 跨度，小于此值认为该通道没有扫到导线
+#define ADC_CALIB_MIN_FRAMES    (50)      // 校准至少需要的采样帧数 (约0.5s)
+
+#define ADC_CALIB_OK            (0)       // 校准成功并已保存
+#define ADC_CALIB_ERR_FRAMES    (1)       // 采样帧数不足
+#define ADC_CALIB_ERR_SPAN      (2)       // 有通道跨度不足
+#define ADC_CALIB_ERR_SAVE      (3)       // 写入 EEPROM 失败
 
 //-------------------------------------------------------------------------------------------------------------------
 // 全局变量声明
 //-------------------------------------------------------------------------------------------------------------------
-extern uint16 adc_val_list[CHANNEL_NUMBER];                  // ADC原始值数组
+extern uint16 adc_val_list[CHANNEL_NUMBER];                  // ADC原始值数组 (已限幅)
+extern uint16 adc_raw_list[CHANNEL_NUMBER];                  // ADC滤波后未限幅的值 (校准使用)
+extern uint16 adc_fine_list[CHANNEL_NUMBER];                 // 过采样抽取后的14位值 (后台扫描时有效)
 extern adc_channel_enum channel_list[CHANNEL_NUMBER];        // ADC通道枚举数组
 extern uint8 channel_index;                                  // 当前通道索引
 extern uint16 max_min_adc[2*CHANNEL_NUMBER];                 // ADC最大最小值校准数组
+extern vuint16 adc_scan_seq;                                 // 后台扫描完成帧计数
+extern uint32 adc_scan_stamp;                                 // 最近读取的扫描帧完成时刻 (us，后台扫描时有效)
 
 //-------------------------------------------------------------------------------------------------------------------
 // 函数声明 - 基础功能
@@ -41,6 +81,104 @@ void Adc_Getval_Fast(void);                                 // 获取ADC值 - 
 void Adc_Getval_Quick(void);                                // 获取ADC值 - 快速中值(最快)
 uint16 limit(uint16 adc_val, uint8 index);                   // ADC值限幅函数
 
+//-------------------------------------------------------------------------------------------------------------------
+// 函数声明 - 后台扫描引擎
+//-------------------------------------------------------------------------------------------------------------------
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     启动ADC后台扫描
+// 参数说明     void
+// 返回参数     void
+// 使用示例     Adc_Scan_Start();
+// 备注信息     开启ADC转换完成中断，按 channel_list[] 顺序轮流转换5个通道
+//              每通道采满 ADC_SCAN_DEPTH 个样本为一帧，写满后切换双缓冲
+//              扫描运行期间不要调用 adc_convert() 等查询式采样函数
+//-------------------------------------------------------------------------------------------------------------------
+void Adc_Scan_Start(void);
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     停止ADC后台扫描
+// 参数说明     void
+// 返回参数     void
+// 使用示例     Adc_Scan_Stop();
+// 备注信息     等待当前转换结束后关闭ADC中断，之后可以使用查询式采样函数
+//-------------------------------------------------------------------------------------------------------------------
+void Adc_Scan_Stop(void);
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     ADC转换完成中断处理
+// 参数说明     void
+// 返回参数     void
+// 使用示例     Adc_Scan_Isr();
+// 备注信息     在 isr.c 的 ADC 中断中调用，保存结果并启动下一通道转换
+//-------------------------------------------------------------------------------------------------------------------
+void Adc_Scan_Isr(void);
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     获取所有ADC值 - 后台扫描最近一帧去极值平均
+// 参数说明     void
+// 返回参数     uint8           1-取到新的扫描帧 0-自上次调用以来没有新帧(adc_val_list[]不变)
+// 使用示例     if(Adc_Getval_Scan()) { Normalization(); }
+// 备注信息     对已采集好的 ADC_SCAN_DEPTH 个样本去掉最大最小后取平均并限幅
+//              同一次遍历中样本和右移 ADC_OVERSAMPLE_BITS 位得到14位过采样值
+//              不等待任何转换，结果保存在 adc_val_list[] 和 adc_fine_list[] 数组中，帧完成时刻保存在 adc_scan_stamp
+//-------------------------------------------------------------------------------------------------------------------
+uint8 Adc_Getval_Scan(void);
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数声明 - 扫描校准
+//-------------------------------------------------------------------------------------------------------------------
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     开始扫描校准
+// 参数说明     void
+// 返回参数     void
+// 使用示例     Adc_Calib_Start();
+// 备注信息     清空记录的峰值和谷值，之后每个新采样帧由 Adc_Calib_Feed() 记录
+//              校准期间将车体左右扫过导线，使每个电感都经过最强和最弱位置
+//-------------------------------------------------------------------------------------------------------------------
+void Adc_Calib_Start(void);
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     扫描校准记录一帧
+// 参数说明     void
+// 返回参数     void
+// 使用示例     Adc_Calib_Feed();
+// 备注信息     在 Adc_Frame_Update() 取到新帧后调用，未处于校准状态时直接返回
+//              使用 adc_raw_list[] 连续3帧的中值更新峰谷值，单帧尖峰不会被记录
+//-------------------------------------------------------------------------------------------------------------------
+void Adc_Calib_Feed(void);
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     结束扫描校准并保存
+// 参数说明     void
+// 返回参数     uint8           ADC_CALIB_OK 或 ADC_CALIB_ERR_xxx
+// 使用示例     if(Adc_Calib_Finish() == ADC_CALIB_OK) { ... }
+// 备注信息     检查帧数和每通道跨度，全部合格才写入 max_min_adc[] 并保存到 EEPROM
+//              失败时 max_min_adc[] 保持原值不变
+//-------------------------------------------------------------------------------------------------------------------
+uint8 Adc_Calib_Finish(void);
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     取消扫描校准
+// 参数说明     void
+// 返回参数     void
+// 使用示例     Adc_Calib_Cancel();
+// 备注信息     丢弃本次记录，max_min_adc[] 保持原值
+//-------------------------------------------------------------------------------------------------------------------
+void Adc_Calib_Cancel(void);
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     获取扫描校准当前记录值
+// 参数说明     index           通道索引 (0 ~ CHANNEL_NUMBER-1)
+// 参数说明     max             输出 当前记录的峰值
+// 参数说明     min             输出 当前记录的谷值
+// 返回参数     void
+// 使用示例     Adc_Calib_Get(0, &max, &min);
+// 备注信息     用于校准界面实时显示
+//-------------------------------------------------------------------------------------------------------------------
+void Adc_Calib_Get(uint8 index, uint16 *max, uint16 *min);
+
 //-------------------------------------------------------------------------------------------------------------------
 // 函数声明 - 多重滤波策略
 //-------------------------------------------------------------------------------------------------------------------
@@ -69,7 +207,7 @@ uint16 adc_sample(adc_channel_enum ch);
 // 参数说明     ch              ADC通道枚举
 // 返回参数     uint16          滤波后的ADC值
 // 使用示例     uint16 val = adc_sample_b(ADC_L1);
-// 备注信息     先进行三次中值滤波，连续8次中值后再去极值平均
+// 备注信息     先进行三次中值滤波，连续8次中值后再去极值平均，共24次转换
 //              优点: 双重滤波，更强的抗干扰能力
 //-------------------------------------------------------------------------------------------------------------------
 uint16 adc_sample_b(adc_channel_enum ch);
@@ -84,11 +222,11 @@ uint16 adc_sample_b(adc_channel_enum ch);
 uint16 adc_sample_a(adc_channel_enum ch);
 
 //-------------------------------------------------------------------------------------------------------------------
-// 函数简介     7元素冒泡排序
+// 函数简介     7元素排序
 // 参数说明     arr             7元素数组指针
-// 返回参数     uint16          排序后数组的首地址(中值在arr[0])
-// 使用示例     arr[0] = sort_seven(arr);
-// 备注信息     对7个元素进行冒泡排序，中值位于arr[0]
+// 返回参数     uint16          排序后的中值 arr[3]
+// 使用示例     mid = sort_seven(arr);
+// 备注信息     16次比较交换的固定排序网络 (median.c)，执行后 arr[] 从小到大排列
 //-------------------------------------------------------------------------------------------------------------------
 uint16 sort_seven(uint16 arr[]);
 
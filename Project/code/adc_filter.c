@@ -0,0 +1,243 @@
+//-------------------------------------------------------------------------------------------------------------------
+// 头文件包含
+//-------------------------------------------------------------------------------------------------------------------
+#include "adc_filter.h"
+
+//-------------------------------------------------------------------------------------------------------------------
+// 全局变量定义
+//-------------------------------------------------------------------------------------------------------------------
+adc_filter_t adc_filter_bank[CHANNEL_NUMBER];                   // 每通道一组滑动窗口滤波器
+
+//===================================================================================================================
+// 单通道滤波器
+//===================================================================================================================
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     清空滑动窗口滤波器
+// 参数说明     filter          滤波器指针
+// 返回参数     void
+// 使用示例     adc_filter_reset(&adc_filter_bank[0]);
+// 备注信息     清空后第一个样本直接作为指数滤波初值
+//-------------------------------------------------------------------------------------------------------------------
+void adc_filter_reset(adc_filter_t *filter)
+{
+    filter->sum = 0;
+    filter->ema = 0;
+    filter->pos = 0;
+    filter->count = 0;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     向滑动窗口滤波器写入一个新样本
+// 参数说明     filter          滤波器指针
+// 参数说明     value           新样本
+// 返回参数     void
+// 使用示例     adc_filter_push(&adc_filter_bank[0], adc_convert(ADC_L1));
+// 备注信息     窗口未满时按插入排序放入有序数组
+//              窗口已满时二分查找最旧样本在有序数组中的位置，用新样本替换后
+//              只向一个方向移动到正确位置，移动的元素个数等于新旧样本之间的样本数
+//              相邻两次采样变化不大时通常只移动0-2个元素
+//-------------------------------------------------------------------------------------------------------------------
+void adc_filter_push(adc_filter_t *filter, uint16 value)
+{
+    uint16 old;
+    uint8 low, high, mid;
+    uint8 i;
+
+    if(filter->count < ADC_FILTER_WINDOW)
+    {
+        // 启动阶段: 插入排序
+        i = filter->count;
+        while(i > 0 && filter->sorted[i-1] > value)
+        {
+            filter->sorted[i] = filter->sorted[i-1];
+            i--;
+        }
+        filter->sorted[i] = value;
+
+        if(filter->count == 0)
+        {
+            filter->ema = value << ADC_FILTER_EMA_FRAC;
+        }
+        filter->count++;
+    }
+    else
+    {
+        old = filter->ring[filter->pos];
+        filter->sum -= old;
+
+        // 二分查找最旧样本在有序数组中的位置 (第一个不小于 old 的元素，一定等于 old)
+        low = 0;
+        high = ADC_FILTER_WINDOW - 1;
+        while(low < high)
+        {
+            mid = (low + high) >> 1;
+            if(filter->sorted[mid] < old)
+            {
+                low = mid + 1;
+            }
+            else
+            {
+                high = mid;
+            }
+        }
+        i = low;
+
+        // 用新样本替换旧样本，向大或向小的方向移动到正确位置
+        if(value > old)
+        {
+            while(i < ADC_FILTER_WINDOW - 1 && filter->sorted[i+1] < value)
+            {
+                filter->sorted[i] = filter->sorted[i+1];
+                i++;
+            }
+        }
+        else
+        {
+            while(i > 0 && filter->sorted[i-1] > value)
+            {
+                filter->sorted[i] = filter->sorted[i-1];
+                i--;
+            }
+        }
+        filter->sorted[i] = value;
+    }
+
+    filter->ring[filter->pos] = value;
+    filter->pos++;
+    if(filter->pos >= ADC_FILTER_WINDOW)
+    {
+        filter->pos = 0;
+    }
+    filter->sum += value;
+
+    // 指数滤波 (Q4)，分正负两种情况避免对负数右移
+    if((value << ADC_FILTER_EMA_FRAC) >= filter->ema)
+    {
+        filter->ema += ((value << ADC_FILTER_EMA_FRAC) - filter->ema) >> ADC_FILTER_EMA_SHIFT;
+    }
+    else
+    {
+        filter->ema -= (filter->ema - (value << ADC_FILTER_EMA_FRAC)) >> ADC_FILTER_EMA_SHIFT;
+    }
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     获取滑动中值
+// 参数说明     filter          滤波器指针
+// 返回参数     uint16          窗口内样本的中值
+// 使用示例     uint16 val = adc_filter_median(&adc_filter_bank[0]);
+// 备注信息     启动阶段取已有样本的中值，没有样本时返回0
+//-------------------------------------------------------------------------------------------------------------------
+uint16 adc_filter_median(adc_filter_t *filter)
+{
+    if(filter->count == 0)
+    {
+        return 0;
+    }
+    return filter->sorted[filter->count >> 1];
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     获取滑动去极值平均
+// 参数说明     filter          滤波器指针
+// 返回参数     uint16          去掉最大最小值后的平均值
+// 使用示例     uint16 val = adc_filter_trimmed_mean(&adc_filter_bank[0]);
+// 备注信息     启动阶段样本少于3个时返回普通平均值，没有样本时返回0
+//-------------------------------------------------------------------------------------------------------------------
+uint16 adc_filter_trimmed_mean(adc_filter_t *filter)
+{
+    uint8 n;
+
+    n = filter->count;
+    if(n == 0)
+    {
+        return 0;
+    }
+    if(n < 3)
+    {
+        return (uint16)(filter->sum / n);
+    }
+    return (uint16)((filter->sum - filter->sorted[0] - filter->sorted[n-1]) / (n - 2));
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     获取指数滤波值
+// 参数说明     filter          滤波器指针
+// 返回参数     uint16          指数滤波输出
+// 使用示例     uint16 val = adc_filter_ema(&adc_filter_bank[0]);
+// 备注信息     四舍五入去掉内部小数位
+//-------------------------------------------------------------------------------------------------------------------
+uint16 adc_filter_ema(adc_filter_t *filter)
+{
+    return (filter->ema + (1 << (ADC_FILTER_EMA_FRAC - 1))) >> ADC_FILTER_EMA_FRAC;
+}
+
+//===================================================================================================================
+// 全部通道
+//===================================================================================================================
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     滑动窗口滤波器组初始化
+// 参数说明     void
+// 返回参数     void
+// 使用示例     Adc_Filter_Init();
+// 备注信息     清空全部通道并连续采样填满一个窗口，启动后输出立即有效
+//-------------------------------------------------------------------------------------------------------------------
+void Adc_Filter_Init(void)
+{
+    uint8 i;
+
+    for(i = 0; i < CHANNEL_NUMBER; i++)
+    {
+        adc_filter_reset(&adc_filter_bank[i]);
+    }
+
+    for(i = 0; i < ADC_FILTER_WINDOW; i++)
+    {
+        Adc_Filter_Update();
+    }
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     滑动窗口滤波器组更新
+// 参数说明     void
+// 返回参数     void
+// 使用示例     Adc_Filter_Update();
+// 备注信息     每通道只做一次转换并写入对应滤波器
+//-------------------------------------------------------------------------------------------------------------------
+void Adc_Filter_Update(void)
+{
+    uint8 i;
+
+    for(i = 0; i < CHANNEL_NUMBER; i++)
+    {
+        adc_filter_push(&adc_filter_bank[i], adc_convert(channel_list[i]));
+    }
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     获取所有ADC值 - 滑动窗口滤波
+// 参数说明     void
+// 返回参数     void
+// 使用示例     Adc_Getval_Filter();
+// 备注信息     输出由 ADC_FILTER_OUTPUT 选择，结果保存在 adc_raw_list[] 和 adc_val_list[] 数组中
+//-------------------------------------------------------------------------------------------------------------------
+void Adc_Getval_Filter(void)
+{
+    uint8 i;
+
+    Adc_Filter_Update();
+
+    for(i = 0; i < CHANNEL_NUMBER; i++)
+    {
+#if(ADC_FILTER_OUTPUT == ADC_FILTER_OUT_MEDIAN)
+        adc_raw_list[i] = adc_filter_median(&adc_filter_bank[i]);
+#elif(ADC_FILTER_OUTPUT == ADC_FILTER_OUT_EMA)
+        adc_raw_list[i] = adc_filter_ema(&adc_filter_bank[i]);
+#else
+        adc_raw_list[i] = adc_filter_trimmed_mean(&adc_filter_bank[i]);
+#endif
+        adc_val_list[i] = limit(adc_raw_list[i], i);
+    }
+}
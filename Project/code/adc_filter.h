@@ -0,0 +1,128 @@
+#ifndef _ADC_FILTER_H_
+#define _ADC_FILTER_H_
+
+//-------------------------------------------------------------------------------------------------------------------
+// 头文件包含
+//-------------------------------------------------------------------------------------------------------------------
+#include "zf_common_headfile.h"
+
+//-------------------------------------------------------------------------------------------------------------------
+// 宏定义
+//-------------------------------------------------------------------------------------------------------------------
+#define ADC_FILTER_WINDOW       (9)       // 滑动窗口长度 (奇数，中值取正中间一个)
+#define ADC_FILTER_EMA_SHIFT    (2)       // 指数滤波系数 alpha = 1/2^n (n=2 即 0.25)
+#define ADC_FILTER_EMA_FRAC     (4)       // 指数滤波内部保留的小数位数 (Q4)
+
+//-------------------------------------------------------------------------------------------------------------------
+// 滤波输出选择 (Adc_Getval_Filter 使用)
+//-------------------------------------------------------------------------------------------------------------------
+#define ADC_FILTER_OUT_MEDIAN   (0)       // 滑动中值: 抗脉冲干扰最强
+#define ADC_FILTER_OUT_TRIMMED  (1)       // 滑动去极值平均: 与 adc_sample() 相同的去极值平均
+#define ADC_FILTER_OUT_EMA      (2)       // 指数滤波: 延迟最小
+
+#define ADC_FILTER_OUTPUT       ADC_FILTER_OUT_TRIMMED   // 当前使用的滤波输出
+
+//-------------------------------------------------------------------------------------------------------------------
+// 数据结构
+//-------------------------------------------------------------------------------------------------------------------
+typedef struct
+{
+    uint16 ring[ADC_FILTER_WINDOW];       // 按时间顺序保存的样本 (环形缓冲，用于找出最旧的样本)
+    uint16 sorted[ADC_FILTER_WINDOW];     // 同一批样本按从小到大排序
+    uint32 sum;                           // 窗口内样本和
+    uint16 ema;                           // 指数滤波状态 (Q4)
+    uint8 pos;                            // 环形缓冲下一个写入位置 (即最旧样本位置)
+    uint8 count;                          // 窗口内已有样本数 (启动阶段小于窗口长度)
+} adc_filter_t;
+
+//-------------------------------------------------------------------------------------------------------------------
+// 全局变量声明
+//-------------------------------------------------------------------------------------------------------------------
+extern adc_filter_t adc_filter_bank[CHANNEL_NUMBER];         // 每通道一组滑动窗口滤波器
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数声明 - 单通道滤波器
+//-------------------------------------------------------------------------------------------------------------------
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     清空滑动窗口滤波器
+// 参数说明     filter          滤波器指针
+// 返回参数     void
+// 使用示例     adc_filter_reset(&adc_filter_bank[0]);
+// 备注信息     清空后第一个样本直接作为指数滤波初值
+//-------------------------------------------------------------------------------------------------------------------
+void adc_filter_reset(adc_filter_t *filter);
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     向滑动窗口滤波器写入一个新样本
+// 参数说明     filter          滤波器指针
+// 参数说明     value           新样本
+// 返回参数     void
+// 使用示例     adc_filter_push(&adc_filter_bank[0], adc_convert(ADC_L1));
+// 备注信息     新样本替换窗口中最旧的样本，三种输出同时更新
+//              有序数组只移动新旧样本之间的元素，不重新排序
+//-------------------------------------------------------------------------------------------------------------------
+void adc_filter_push(adc_filter_t *filter, uint16 value);
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     获取滑动中值
+// 参数说明     filter          滤波器指针
+// 返回参数     uint16          窗口内样本的中值
+// 使用示例     uint16 val = adc_filter_median(&adc_filter_bank[0]);
+// 备注信息     直接读有序数组正中间的元素，O(1)
+//-------------------------------------------------------------------------------------------------------------------
+uint16 adc_filter_median(adc_filter_t *filter);
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     获取滑动去极值平均
+// 参数说明     filter          滤波器指针
+// 返回参数     uint16          去掉最大最小值后的平均值
+// 使用示例     uint16 val = adc_filter_trimmed_mean(&adc_filter_bank[0]);
+// 备注信息     由样本和减去有序数组首尾元素得到，O(1)
+//-------------------------------------------------------------------------------------------------------------------
+uint16 adc_filter_trimmed_mean(adc_filter_t *filter);
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     获取指数滤波值
+// 参数说明     filter          滤波器指针
+// 返回参数     uint16          指数滤波输出
+// 使用示例     uint16 val = adc_filter_ema(&adc_filter_bank[0]);
+// 备注信息     y += (x - y) / 2^ADC_FILTER_EMA_SHIFT，内部保留4位小数避免截断误差累积
+//-------------------------------------------------------------------------------------------------------------------
+uint16 adc_filter_ema(adc_filter_t *filter);
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数声明 - 全部通道
+//-------------------------------------------------------------------------------------------------------------------
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     滑动窗口滤波器组初始化
+// 参数说明     void
+// 返回参数     void
+// 使用示例     Adc_Filter_Init();
+// 备注信息     清空全部通道并连续采样填满一个窗口，启动后输出立即有效
+//              需要在 adc_init() 之后调用
+//-------------------------------------------------------------------------------------------------------------------
+void Adc_Filter_Init(void);
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     滑动窗口滤波器组更新
+// 参数说明     void
+// 返回参数     void
+// 使用示例     Adc_Filter_Update();
+// 备注信息     每通道只做一次转换并写入对应滤波器
+//-------------------------------------------------------------------------------------------------------------------
+void Adc_Filter_Update(void);
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     获取所有ADC值 - 滑动窗口滤波
+// 参数说明     void
+// 返回参数     void
+// 使用示例     Adc_Getval_Filter();
+// 备注信息     调用 Adc_Filter_Update() 后按 ADC_FILTER_OUTPUT 选择输出并限幅
+//              每通道每次只转换1次，adc_sample() 为11次
+//              结果保存在 adc_raw_list[] 和 adc_val_list[] 数组中
+//-------------------------------------------------------------------------------------------------------------------
+void Adc_Getval_Filter(void);
+
+#endif
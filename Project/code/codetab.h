@@ -19,11 +19,18 @@
 
 #include "zf_common_typedef.h"
 
+// 字库放在程序存储区 (C251 的 code 存储类型)，其他编译器下为普通 const 数据
+#ifdef __C251__
+#define OLED_FONT_MEM       code
+#else
+#define OLED_FONT_MEM
+#endif
+
 /*==================================================================================================================*/
 /* =============== 6x8 ASCII 字库定义 (每字符6字节，95个字符) =============== */
 /*==================================================================================================================*/
 
-static const uint8 code F6x8[][6] =
+static const uint8 OLED_FONT_MEM F6x8[][6] =
 {
     {0x00, 0x00, 0x00, 0x00, 0x00, 0x00}, /* 0x20: 空格 */
     {0x00, 0x00, 0x00, 0x2f, 0x00, 0x00}, /* 0x21: ! */
@@ -123,7 +130,7 @@ static const uint8 code F6x8[][6] =
 /* =============== 8x16 ASCII 字库定义 =============== */
 /*==================================================================================================================*/
 
-static const uint8 code F8X16[] =
+static const uint8 OLED_FONT_MEM F8X16[] =
 {
     /* 0x20: space */
     0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00, 0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
@@ -12,6 +12,11 @@ int16 encoder_data_dir_R = 0;                                          // 右编
 // 一阶IIR低通滤波器状态变量
 static float last_encoder_L = 0.0f;                                    // 左编码器上次滤波值
 static float last_encoder_R = 0.0f;                                    // 右编码器上次滤波值
+static uint32 last_encoder_stamp = 0;                                  // 上次读取计数的时刻 (us)
+
+// 编码器数据快照 (Encoder_Get_Filtered 完成后发布)
+static encoder_frame_t encoder_snap_bank[2];
+static snapshot_t encoder_snap = {{&encoder_snap_bank[0], &encoder_snap_bank[1]}, sizeof(encoder_frame_t), 0, 0};
 
 //-------------------------------------------------------------------------------------------------------------------
 // 函数简介     编码器初始化
@@ -51,14 +56,17 @@ float iir_lowpass(float new_val, float last_val, float alpha)
 // 使用示例     Encoder_Get_Filtered();
 // 备注信息     获取编码器原始值并经过一阶IIR低通滤波
 //              滤波系数 alpha = 0.2 (可在函数中调整)
-//              在中断中调用，自动完成采集、滤波、清零
+//              在中断中调用，自动完成采集、滤波、清零，读取时刻和与上次读取的时间差随快照发布
 //-------------------------------------------------------------------------------------------------------------------
 void Encoder_Get_Filtered(void)
 {
+    encoder_frame_t frame;
     float temp_L, temp_R;
     float alpha;
+    uint32 stamp;
 
     alpha = 0.2f;
+    stamp = timebase_now_us();
     temp_L = (float)encoder_get_count(ENCODER_DIR_L);
     temp_R = (float)encoder_get_count(ENCODER_DIR_R);
 
@@ -70,4 +78,23 @@ void Encoder_Get_Filtered(void)
 
     encoder_clear_count(ENCODER_DIR_L);
     encoder_clear_count(ENCODER_DIR_R);
+
+    frame.left = encoder_data_dir_L;
+    frame.right = encoder_data_dir_R;
+    frame.stamp = stamp;
+    frame.dt_us = (stamp - last_encoder_stamp > 0xFFFF) ? 0xFFFF : (uint16)(stamp - last_encoder_stamp);
+    last_encoder_stamp = stamp;
+    snapshot_publish(&encoder_snap, &frame);
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     获取编码器数据快照
+// 参数说明     out             输出 最近一次 Encoder_Get_Filtered() 的左右编码器值
+// 返回参数     void
+// 使用示例     Encoder_Get_Snapshot(&enc);
+// 备注信息     可在主循环中调用，不关闭中断
+//-------------------------------------------------------------------------------------------------------------------
+void Encoder_Get_Snapshot(encoder_frame_t *out)
+{
+    snapshot_read(&encoder_snap, out);
 }
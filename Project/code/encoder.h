@@ -25,6 +25,17 @@
 extern int16 encoder_data_dir_L;                                      // 左编码器计数值
 extern int16 encoder_data_dir_R;                                      // 右编码器计数值
 
+//-------------------------------------------------------------------------------------------------------------------
+// 数据结构
+//-------------------------------------------------------------------------------------------------------------------
+typedef struct
+{
+    int16 left;                                                       // 左编码器滤波值
+    int16 right;                                                      // 右编码器滤波值
+    uint32 stamp;                                                     // 读取计数的时刻 (us，timebase_now_us)
+    uint16 dt_us;                                                     // 与上一次读取的时间差 (us)，计数值对应的实际时长
+} encoder_frame_t;
+
 //-------------------------------------------------------------------------------------------------------------------
 // 函数声明
 //-------------------------------------------------------------------------------------------------------------------
@@ -57,4 +68,13 @@ float iir_lowpass(float new_val, float last_val, float alpha);
 //-------------------------------------------------------------------------------------------------------------------
 void Encoder_Get_Filtered(void);
 
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     获取编码器数据快照
+// 参数说明     out             输出 最近一次 Encoder_Get_Filtered() 的左右编码器值
+// 返回参数     void
+// 使用示例     Encoder_Get_Snapshot(&enc);
+// 备注信息     控制中断以外的上下文读取编码器值应使用本函数，左右值来自同一个控制周期
+//-------------------------------------------------------------------------------------------------------------------
+void Encoder_Get_Snapshot(encoder_frame_t *out);
+
 #endif
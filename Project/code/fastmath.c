@@ -0,0 +1,287 @@
+//-------------------------------------------------------------------------------------------------------------------
+// 头文件包含
+//-------------------------------------------------------------------------------------------------------------------
+#include "fastmath.h"
+
+//-------------------------------------------------------------------------------------------------------------------
+// 私有变量
+//-------------------------------------------------------------------------------------------------------------------
+// sin(i * π/128), i = 0 ~ 64 (1/4周期，每圈256段)
+static const float sin_table[65] =
+{
+    0.0000000f, 0.0245412f, 0.0490677f, 0.0735646f, 0.0980171f, 0.1224107f, 0.1467305f, 0.1709619f,
+    0.1950903f, 0.2191012f, 0.2429802f, 0.2667128f, 0.2902847f, 0.3136817f, 0.3368899f, 0.3598950f,
+    0.3826834f, 0.4052413f, 0.4275551f, 0.4496113f, 0.4713967f, 0.4928982f, 0.5141027f, 0.5349976f,
+    0.5555702f, 0.5758082f, 0.5956993f, 0.6152316f, 0.6343933f, 0.6531728f, 0.6715590f, 0.6895405f,
+    0.7071068f, 0.7242471f, 0.7409511f, 0.7572088f, 0.7730105f, 0.7883464f, 0.8032075f, 0.8175848f,
+    0.8314696f, 0.8448536f, 0.8577286f, 0.8700870f, 0.8819213f, 0.8932243f, 0.9039893f, 0.9142098f,
+    0.9238795f, 0.9329928f, 0.9415441f, 0.9495282f, 0.9569403f, 0.9637761f, 0.9700313f, 0.9757021f,
+    0.9807853f, 0.9852776f, 0.9891765f, 0.9924795f, 0.9951847f, 0.9972905f, 0.9987955f, 0.9996988f,
+    1.0000000f,
+};
+
+// atan(i / 32), i = 0 ~ 32 (0 ~ 45°)
+static const float atan_table[33] =
+{
+    0.0000000f, 0.0312398f, 0.0624188f, 0.0934768f, 0.1243550f, 0.1549967f, 0.1853479f, 0.2153577f,
+    0.2449787f, 0.2741675f, 0.3028849f, 0.3310961f, 0.3587707f, 0.3858827f, 0.4124104f, 0.4383366f,
+    0.4636476f, 0.4883340f, 0.5123895f, 0.5358112f, 0.5585993f, 0.5807564f, 0.6022873f, 0.6231993f,
+    0.6435011f, 0.6632030f, 0.6823166f, 0.7008544f, 0.7188300f, 0.7362574f, 0.7531513f, 0.7695265f,
+    0.7853982f,
+};
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     atan2 八分区修正
+// 参数说明     angle           atan(min/max) (0 ~ π/4)
+// 参数说明     y               Y坐标
+// 参数说明     x               X坐标
+// 返回参数     float           弧度值 [-π, π]
+// 备注信息     |y| > |x| 时 atan = π/2 - atan(|x|/|y|)，再按 x、y 的符号修正到所在象限
+//-------------------------------------------------------------------------------------------------------------------
+static float atan2_fold(float angle, float y, float x)
+{
+    float abs_x;
+    float abs_y;
+
+    abs_x = (x >= 0.0f) ? x : -x;
+    abs_y = (y >= 0.0f) ? y : -y;
+    if(abs_y > abs_x)
+    {
+        angle = FAST_HALF_PI - angle;
+    }
+    if(x < 0.0f)
+    {
+        angle = FAST_PI - angle;
+    }
+    if(y < 0.0f)
+    {
+        angle = -angle;
+    }
+
+    return angle;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     计算 min(|x|,|y|) / max(|x|,|y|)
+// 参数说明     y               Y坐标
+// 参数说明     x               X坐标
+// 返回参数     float           比值 [0, 1]，原点返回 -1
+//-------------------------------------------------------------------------------------------------------------------
+static float atan2_ratio(float y, float x)
+{
+    float abs_x;
+    float abs_y;
+
+    abs_x = (x >= 0.0f) ? x : -x;
+    abs_y = (y >= 0.0f) ? y : -y;
+    if(abs_x == 0.0f && abs_y == 0.0f)
+    {
+        return -1.0f;
+    }
+
+    return (abs_y > abs_x) ? (abs_x / abs_y) : (abs_y / abs_x);
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     快速平方根倒数 1/sqrt(x)
+// 参数说明     x               输入值
+// 返回参数     float           1/sqrt(x)，x <= 0 时返回0
+// 使用示例     norm = fast_inv_sqrt(ax * ax + ay * ay + az * az);
+// 备注信息     IEEE754 单精度的位模式近似于 log2(x)，0x5F3759DF - (i >> 1) 即为 -log2(x)/2 的近似
+//              牛顿迭代 y = y * (1.5 - 0.5 * x * y²)，每次迭代误差约平方一次
+//-------------------------------------------------------------------------------------------------------------------
+float fast_inv_sqrt(float x)
+{
+    union
+    {
+        float f;
+        uint32 i;
+    } conv;
+    float half_x;
+    uint8 n;
+
+    if(x <= 0.0f)
+    {
+        return 0.0f;
+    }
+
+    half_x = 0.5f * x;
+    conv.f = x;
+    conv.i = 0x5F3759DFUL - (conv.i >> 1);
+    for(n = 0; n < FAST_INV_SQRT_ITER; n++)
+    {
+        conv.f = conv.f * (1.5f - half_x * conv.f * conv.f);
+    }
+
+    return conv.f;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     快速平方根
+// 参数说明     x               输入值
+// 返回参数     float           sqrt(x)，x <= 0 时返回0
+// 使用示例     float len = fast_sqrt(x * x + y * y);
+// 备注信息     x * (1/sqrt(x))
+//-------------------------------------------------------------------------------------------------------------------
+float fast_sqrt(float x)
+{
+    return x * fast_inv_sqrt(x);
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     快速正弦
+// 参数说明     x               弧度值 (任意范围)
+// 返回参数     float           sin(x)
+// 使用示例     s = fast_sin(angle);
+// 备注信息     弧度换算为圈数后去掉整数部分，乘256得到表格位置:
+//              高2位为象限，低6位为1/4周期表中的序号，小数部分做线性插值
+//-------------------------------------------------------------------------------------------------------------------
+float fast_sin(float x)
+{
+    float turns;
+    float frac;
+    float result;
+    uint16 pos;
+    uint8 index;
+    uint8 quadrant;
+
+    // 换算为 [0, 1) 圈
+    turns = x * (1.0f / (2.0f * FAST_PI));
+    turns -= (float)(int32)turns;
+    if(turns < 0.0f)
+    {
+        turns += 1.0f;
+    }
+
+    turns *= 256.0f;
+    pos = (uint16)turns;
+    frac = turns - (float)pos;
+    quadrant = (uint8)((pos >> 6) & 0x03);
+    index = (uint8)(pos & 0x3F);
+
+    // 第二、四象限沿1/4周期表倒序取值
+    if(quadrant & 0x01)
+    {
+        result = sin_table[64 - index] + frac * (sin_table[63 - index] - sin_table[64 - index]);
+    }
+    else
+    {
+        result = sin_table[index] + frac * (sin_table[index + 1] - sin_table[index]);
+    }
+
+    // 第三、四象限取负
+    if(quadrant & 0x02)
+    {
+        result = -result;
+    }
+
+    return result;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     快速余弦
+// 参数说明     x               弧度值 (任意范围)
+// 返回参数     float           cos(x)
+// 使用示例     c = fast_cos(angle);
+// 备注信息     cos(x) = sin(x + π/2)
+//-------------------------------------------------------------------------------------------------------------------
+float fast_cos(float x)
+{
+    return fast_sin(x + FAST_HALF_PI);
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     快速反正弦
+// 参数说明     x               输入值 (超出 [-1, 1] 时限幅)
+// 返回参数     float           弧度值 [-π/2, π/2]
+// 使用示例     pitch = fast_asin(2.0f * (q0 * q2 - q3 * q1));
+// 备注信息     系数来自 Abramowitz & Stegun 4.4.45，在 x 接近1时仍然准确 (泰勒级数在这里误差最大)
+//              asin(-x) = -asin(x)
+//-------------------------------------------------------------------------------------------------------------------
+float fast_asin(float x)
+{
+    uint8 negative;
+    float result;
+
+    if(x > 1.0f)
+    {
+        x = 1.0f;
+    }
+    if(x < -1.0f)
+    {
+        x = -1.0f;
+    }
+
+    negative = 0;
+    if(x < 0.0f)
+    {
+        negative = 1;
+        x = -x;
+    }
+
+    result = FAST_HALF_PI - fast_sqrt(1.0f - x) *
+             (1.5707288f + x * (-0.2121144f + x * (0.0742610f + x * -0.0187293f)));
+
+    return negative ? -result : result;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     快速反正切 (双参数)
+// 参数说明     y               Y坐标
+// 参数说明     x               X坐标
+// 返回参数     float           弧度值 [-π, π]，原点返回0
+// 使用示例     yaw = fast_atan2(2.0f * (q0 * q3 + q1 * q2), 1.0f - 2.0f * (q2 * q2 + q3 * q3));
+// 备注信息     系数来自 Abramowitz & Stegun 4.4.49
+//              比值限制在 [0, 1]，多项式只需要覆盖 0 ~ 45°
+//-------------------------------------------------------------------------------------------------------------------
+float fast_atan2(float y, float x)
+{
+    float r;
+    float r2;
+    float angle;
+
+    r = atan2_ratio(y, x);
+    if(r < 0.0f)
+    {
+        return 0.0f;
+    }
+
+    r2 = r * r;
+    angle = r * (0.9998660f + r2 * (-0.3302995f + r2 * (0.1801410f + r2 * (-0.0851330f + r2 * 0.0208351f))));
+
+    return atan2_fold(angle, y, x);
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     查表反正切 (双参数)
+// 参数说明     y               Y坐标
+// 参数说明     x               X坐标
+// 返回参数     float           弧度值 [-π, π]，原点返回0
+// 使用示例     yaw = fast_atan2_table(2.0f * (q0 * q3 + q1 * q2), 1.0f - 2.0f * (q2 * q2 + q3 * q3));
+// 备注信息     比值 r ∈ [0, 1] 乘32得到表格位置，相邻两点线性插值
+//              插值误差上限 h²/8 * max|atan''| = (1/32)² / 8 * 0.65 ≈ 8e-5 rad
+//-------------------------------------------------------------------------------------------------------------------
+float fast_atan2_table(float y, float x)
+{
+    float r;
+    float frac;
+    float angle;
+    uint8 index;
+
+    r = atan2_ratio(y, x);
+    if(r < 0.0f)
+    {
+        return 0.0f;
+    }
+
+    r *= 32.0f;
+    index = (uint8)r;
+    if(index > 31)
+    {
+        index = 31;                                             // r = 1 时取最后一段的终点
+    }
+    frac = r - (float)index;
+    angle = atan_table[index] + frac * (atan_table[index + 1] - atan_table[index]);
+
+    return atan2_fold(angle, y, x);
+}
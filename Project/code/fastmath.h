@@ -0,0 +1,97 @@
+#ifndef _FASTMATH_H_
+#define _FASTMATH_H_
+
+//-------------------------------------------------------------------------------------------------------------------
+// 头文件包含
+//-------------------------------------------------------------------------------------------------------------------
+#include "zf_common_headfile.h"
+
+//-------------------------------------------------------------------------------------------------------------------
+// 说明
+//-------------------------------------------------------------------------------------------------------------------
+// 姿态解算和控制算法共用的快速数学函数，替代 math.h 中的库函数 (C251 没有FPU，库函数很慢)
+// 每个函数的备注信息中给出最大误差和单次调用的浮点运算次数，按调用位置对精度的要求选择
+//   运算次数: 乘/加减/除 分别计数，比较和整数运算不计
+
+//-------------------------------------------------------------------------------------------------------------------
+// 宏定义
+//-------------------------------------------------------------------------------------------------------------------
+#define FAST_PI                 (3.14159265f)
+#define FAST_HALF_PI            (1.57079633f)
+#define FAST_INV_SQRT_ITER      (2)       // 平方根倒数牛顿迭代次数: 1-相对误差1.8e-3 2-相对误差5e-6
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数声明
+//-------------------------------------------------------------------------------------------------------------------
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     快速平方根倒数 1/sqrt(x)
+// 参数说明     x               输入值
+// 返回参数     float           1/sqrt(x)，x <= 0 时返回0
+// 使用示例     norm = fast_inv_sqrt(ax * ax + ay * ay + az * az);
+// 备注信息     整数移位得到初值 (相对误差 3.4%)，再做 FAST_INV_SQRT_ITER 次牛顿迭代
+//              每次迭代 3乘1减，没有除法
+//-------------------------------------------------------------------------------------------------------------------
+float fast_inv_sqrt(float x);
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     快速平方根
+// 参数说明     x               输入值
+// 返回参数     float           sqrt(x)，x <= 0 时返回0
+// 使用示例     float len = fast_sqrt(x * x + y * y);
+// 备注信息     x * fast_inv_sqrt(x)，误差与 fast_inv_sqrt 相同，比迭代法少了每次迭代的除法
+//-------------------------------------------------------------------------------------------------------------------
+float fast_sqrt(float x);
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     快速正弦
+// 参数说明     x               弧度值 (任意范围)
+// 返回参数     float           sin(x)
+// 使用示例     s = fast_sin(angle);
+// 备注信息     每圈256段的正弦表线性插值 (只存1/4周期65个点)，最大误差 7.6e-5
+//              3乘4加减 (x < 0 时再加1次)，整数取表
+//-------------------------------------------------------------------------------------------------------------------
+float fast_sin(float x);
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     快速余弦
+// 参数说明     x               弧度值 (任意范围)
+// 返回参数     float           cos(x)
+// 使用示例     c = fast_cos(angle);
+// 备注信息     fast_sin(x + π/2)，误差同 fast_sin，运算次数多1次加法
+//-------------------------------------------------------------------------------------------------------------------
+float fast_cos(float x);
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     快速反正弦
+// 参数说明     x               输入值 (超出 [-1, 1] 时限幅)
+// 返回参数     float           弧度值 [-π/2, π/2]
+// 使用示例     pitch = fast_asin(2.0f * (q0 * q2 - q3 * q1));
+// 备注信息     asin(x) = π/2 - sqrt(1-x) * (a0 + a1*x + a2*x² + a3*x³) 极小化最大误差多项式，最大误差 7.5e-5 rad
+//              多项式 3乘3加，1-x 和 π/2 减去乘积 1乘2加，加上 fast_sqrt
+//-------------------------------------------------------------------------------------------------------------------
+float fast_asin(float x);
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     快速反正切 (双参数)
+// 参数说明     y               Y坐标
+// 参数说明     x               X坐标
+// 返回参数     float           弧度值 [-π, π]，原点返回0
+// 使用示例     yaw = fast_atan2(2.0f * (q0 * q3 + q1 * q2), 1.0f - 2.0f * (q2 * q2 + q3 * q3));
+// 备注信息     比值 r = min/max ∈ [0, 1] 上的9次奇多项式 (极小化最大误差)，再按八分区修正，最大误差 1.2e-5 rad
+//              1除6乘4加，加上最多2次象限修正的加减
+//-------------------------------------------------------------------------------------------------------------------
+float fast_atan2(float y, float x);
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     查表反正切 (双参数)
+// 参数说明     y               Y坐标
+// 参数说明     x               X坐标
+// 返回参数     float           弧度值 [-π, π]，原点返回0
+// 使用示例     yaw = fast_atan2_table(2.0f * (q0 * q3 + q1 * q2), 1.0f - 2.0f * (q2 * q2 + q3 * q3));
+// 备注信息     0 ~ 45° 分32段的反正切表线性插值，最大误差 8e-5 rad (0.005°)
+//              1除2乘3加减，比 fast_atan2 少4次乘法和1次加法，欧拉角输出默认使用
+//-------------------------------------------------------------------------------------------------------------------
+float fast_atan2_table(float y, float x);
+
+#endif
@@ -0,0 +1,351 @@
+//-------------------------------------------------------------------------------------------------------------------
+// 头文件包含
+//-------------------------------------------------------------------------------------------------------------------
+#include "gyro_bias.h"
+#include "myeeprom.h"
+
+//-------------------------------------------------------------------------------------------------------------------
+// 数据结构
+//-------------------------------------------------------------------------------------------------------------------
+typedef struct
+{
+    int16 gyro_ref[3];                    // 窗口首个采样 (统计相对于它的偏差，平方和不会溢出)
+    int16 acc_ref[3];
+    int32 gyro_sum[3];                    // 偏差和
+    int32 gyro_sq[3];                     // 偏差平方和
+    int32 acc_sum[3];
+    int32 acc_sq[3];
+    uint8 gyro_over;                      // 偏差超限的陀螺仪轴 (bit0-X bit1-Y bit2-Z)
+    uint8 acc_over;                       // 偏差超限的加速度计轴
+    uint8 straight;                       // 窗口内直道提示始终为1
+    uint16 count;                         // 窗口内已统计的采样数
+} gyro_bias_window_t;
+
+//-------------------------------------------------------------------------------------------------------------------
+// 私有变量
+//-------------------------------------------------------------------------------------------------------------------
+// IMU 更新上下文中使用
+static gyro_bias_window_t gyro_bias_window;
+static gyro_bias_info_t gyro_bias_state;                        // 零偏和状态 (窗口结束时发布)
+static int32 gyro_bias_residual[3] = {0, 0, 0};                 // 误差扩散余数 (Q8，0 ~ 255)
+static int32 gyro_bias_calib_sum[3] = {0, 0, 0};                // 冷启动静止窗口均值和
+static uint8 gyro_bias_calib_count = 0;                         // 冷启动已连续静止的窗口数
+
+// 控制中断写入
+static vuint8 gyro_bias_straight_hint = 0;
+
+// 主循环中使用
+static int32 gyro_bias_saved[3] = {0, 0, 0};                    // EEPROM 中的零偏
+static uint8 gyro_bias_saved_valid = 0;
+
+// 零偏快照 (窗口结束时发布)
+static gyro_bias_info_t gyro_bias_snap_bank[2];
+static snapshot_t gyro_bias_snap = {{&gyro_bias_snap_bank[0], &gyro_bias_snap_bank[1]}, sizeof(gyro_bias_info_t), 0, 0};
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     计算窗口中一个轴的均值和方差
+// 参数说明     ref             窗口首个采样
+// 参数说明     sum             偏差和
+// 参数说明     sq              偏差平方和
+// 参数说明     mean            输出 均值 (Q8)，为 NULL 时不计算
+// 返回参数     float           方差 (LSB²)
+// 备注信息     每个窗口结束时调用一次
+//-------------------------------------------------------------------------------------------------------------------
+static float gyro_bias_window_stat(int16 ref, int32 sum, int32 sq, int32 *mean)
+{
+    float m;
+
+    if(mean != NULL)
+    {
+        *mean = ((int32)ref << GYRO_BIAS_FRAC_BITS) + ((sum << GYRO_BIAS_FRAC_BITS) >> GYRO_BIAS_WINDOW_SHIFT);
+    }
+
+    m = (float)sum * (1.0f / GYRO_BIAS_WINDOW);
+    return (float)sq * (1.0f / GYRO_BIAS_WINDOW) - m * m;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     窗口结束处理
+// 参数说明     void
+// 返回参数     uint8           GYRO_BIAS_EVENT_NONE / GYRO_BIAS_EVENT_CALIBRATED
+// 备注信息     判断静止/直道，更新零偏后发布快照
+//-------------------------------------------------------------------------------------------------------------------
+static uint8 gyro_bias_window_end(void)
+{
+    gyro_bias_window_t *w;
+    int32 mean[3];
+    int32 diff;
+    float gyro_var[3];
+    float acc_var;
+    uint8 still;
+    uint8 straight;
+    uint8 event;
+    uint8 i;
+
+    w = &gyro_bias_window;
+    event = GYRO_BIAS_EVENT_NONE;
+
+    // 1. 静止: 三轴陀螺仪和加速度计偏差都没有超限，方差都低于阈值
+    still = (w->gyro_over == 0) && (w->acc_over == 0);
+    for(i = 0; i < 3; i++)
+    {
+        gyro_var[i] = gyro_bias_window_stat(w->gyro_ref[i], w->gyro_sum[i], w->gyro_sq[i], &mean[i]);
+        acc_var = gyro_bias_window_stat(w->acc_ref[i], w->acc_sum[i], w->acc_sq[i], NULL);
+        if(gyro_var[i] > GYRO_BIAS_STILL_GYRO_VAR || acc_var > GYRO_BIAS_STILL_ACC_VAR)
+        {
+            still = 0;
+        }
+    }
+
+    // 2. 直道: 整个窗口都有直道提示，Z轴偏差没有超限且方差低于阈值
+    straight = w->straight && !(w->gyro_over & 0x04) && (gyro_var[2] < GYRO_BIAS_STRAIGHT_VAR);
+
+    // 3. 更新零偏
+    if(!gyro_bias_state.ready)
+    {
+        // 冷启动: 连续静止窗口的均值取平均，中途移动则重新开始
+        if(still)
+        {
+            for(i = 0; i < 3; i++)
+            {
+                gyro_bias_calib_sum[i] += mean[i];
+            }
+            gyro_bias_calib_count++;
+
+            if(gyro_bias_calib_count >= GYRO_BIAS_CALIB_WINDOWS)
+            {
+                for(i = 0; i < 3; i++)
+                {
+                    gyro_bias_state.bias[i] = gyro_bias_calib_sum[i] / GYRO_BIAS_CALIB_WINDOWS;
+                }
+                gyro_bias_state.ready = 1;
+                event = GYRO_BIAS_EVENT_CALIBRATED;
+            }
+        }
+        else
+        {
+            gyro_bias_calib_sum[0] = gyro_bias_calib_sum[1] = gyro_bias_calib_sum[2] = 0;
+            gyro_bias_calib_count = 0;
+        }
+    }
+    else if(still)
+    {
+        for(i = 0; i < 3; i++)
+        {
+            gyro_bias_state.bias[i] += (mean[i] - gyro_bias_state.bias[i]) / (1L << GYRO_BIAS_STILL_SHIFT);
+        }
+    }
+    else if(straight)
+    {
+        // 弯道上Z轴均值是转弯角速度，与零偏相差很大，不参与跟踪
+        diff = mean[2] - gyro_bias_state.bias[2];
+        if(diff < GYRO_BIAS_STRAIGHT_STEP && diff > -GYRO_BIAS_STRAIGHT_STEP)
+        {
+            gyro_bias_state.bias[2] += diff / (1L << GYRO_BIAS_STRAIGHT_SHIFT);
+        }
+    }
+
+    // 4. 发布快照
+    gyro_bias_state.still = still;
+    gyro_bias_state.windows++;
+    snapshot_publish(&gyro_bias_snap, &gyro_bias_state);
+
+    return event;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     零偏估计初始化
+// 参数说明     void
+// 返回参数     uint8           1-从 EEPROM 加载了零偏 (热启动) 0-需要冷启动标定
+// 使用示例     gyro_bias_init();
+// 备注信息     EEPROM 中没有有效零偏时零偏为0，等待冷启动标定
+//-------------------------------------------------------------------------------------------------------------------
+uint8 gyro_bias_init(void)
+{
+    memset(&gyro_bias_window, 0, sizeof(gyro_bias_window_t));
+    memset(&gyro_bias_state, 0, sizeof(gyro_bias_info_t));
+
+    if(myeeprom_load_gyro_bias(gyro_bias_state.bias) == 0)
+    {
+        gyro_bias_state.ready = 1;
+        gyro_bias_saved[0] = gyro_bias_state.bias[0];
+        gyro_bias_saved[1] = gyro_bias_state.bias[1];
+        gyro_bias_saved[2] = gyro_bias_state.bias[2];
+        gyro_bias_saved_valid = 1;
+    }
+
+    snapshot_publish(&gyro_bias_snap, &gyro_bias_state);
+
+    return gyro_bias_state.ready;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     输入一个采样并扣除零偏
+// 参数说明     gyro            三轴陀螺仪原始值，返回时已扣除零偏
+// 参数说明     acc             三轴加速度计原始值 (只用于静止判断)
+// 返回参数     uint8           GYRO_BIAS_EVENT_NONE / GYRO_BIAS_EVENT_CALIBRATED
+// 使用示例     if(gyro_bias_update(gyro, acc) == GYRO_BIAS_EVENT_CALIBRATED) { 重置姿态 }
+// 备注信息     每个采样只有整数加减，窗口结束时计算一次均值和方差
+//              扣除时余数累加 Q8 零偏，整数部分从采样中减去，每个采样最多相差1 LSB，平均值等于零偏
+//-------------------------------------------------------------------------------------------------------------------
+uint8 gyro_bias_update(int16 *gyro, const int16 *acc)
+{
+    gyro_bias_window_t *w;
+    int32 d;
+    int32 whole;
+    uint8 event;
+    uint8 i;
+
+    w = &gyro_bias_window;
+    event = GYRO_BIAS_EVENT_NONE;
+
+    // 1. 窗口统计 (扣除零偏之前的原始值)
+    if(w->count == 0)
+    {
+        memset(w, 0, sizeof(gyro_bias_window_t));
+        for(i = 0; i < 3; i++)
+        {
+            w->gyro_ref[i] = gyro[i];
+            w->acc_ref[i] = acc[i];
+        }
+        w->straight = 1;
+    }
+
+    for(i = 0; i < 3; i++)
+    {
+        d = (int32)gyro[i] - w->gyro_ref[i];
+        if(d > GYRO_BIAS_GYRO_DEV_MAX || d < -GYRO_BIAS_GYRO_DEV_MAX)
+        {
+            w->gyro_over |= (uint8)(1 << i);
+        }
+        else
+        {
+            w->gyro_sum[i] += d;
+            w->gyro_sq[i] += d * d;
+        }
+
+        d = (int32)acc[i] - w->acc_ref[i];
+        if(d > GYRO_BIAS_ACC_DEV_MAX || d < -GYRO_BIAS_ACC_DEV_MAX)
+        {
+            w->acc_over |= (uint8)(1 << i);
+        }
+        else
+        {
+            w->acc_sum[i] += d;
+            w->acc_sq[i] += d * d;
+        }
+    }
+
+    if(!gyro_bias_straight_hint)
+    {
+        w->straight = 0;
+    }
+
+    w->count++;
+    if(w->count >= GYRO_BIAS_WINDOW)
+    {
+        event = gyro_bias_window_end();
+        w->count = 0;
+    }
+
+    // 2. 扣除零偏 (误差扩散)
+    for(i = 0; i < 3; i++)
+    {
+        gyro_bias_residual[i] += gyro_bias_state.bias[i];
+        whole = gyro_bias_residual[i] >> GYRO_BIAS_FRAC_BITS;
+        gyro_bias_residual[i] -= whole << GYRO_BIAS_FRAC_BITS;
+
+        d = (int32)gyro[i] - whole;
+        if(d > 32767)
+        {
+            d = 32767;
+        }
+        if(d < -32768)
+        {
+            d = -32768;
+        }
+        gyro[i] = (int16)d;
+    }
+
+    return event;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     获取一个轴的零偏
+// 参数说明     axis            0-X 1-Y 2-Z
+// 返回参数     float           零偏 (LSB)
+// 使用示例     float bias_z = gyro_bias_lsb(2);
+// 备注信息     Q8 转换为浮点
+//-------------------------------------------------------------------------------------------------------------------
+float gyro_bias_lsb(uint8 axis)
+{
+    return (float)gyro_bias_state.bias[axis] * (1.0f / (1 << GYRO_BIAS_FRAC_BITS));
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     设置直道提示
+// 参数说明     straight        1-小车正沿直道行驶 0-其他
+// 返回参数     void
+// 使用示例     gyro_bias_set_straight(1);
+// 备注信息     单字节写入，不需要关中断
+//-------------------------------------------------------------------------------------------------------------------
+void gyro_bias_set_straight(uint8 straight)
+{
+    gyro_bias_straight_hint = straight;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     获取零偏估计状态快照
+// 参数说明     out             输出 最近一个窗口结束时的零偏和状态
+// 返回参数     void
+// 使用示例     gyro_bias_get_snapshot(&bias_view);
+// 备注信息     可在主循环中调用，不关闭中断
+//-------------------------------------------------------------------------------------------------------------------
+void gyro_bias_get_snapshot(gyro_bias_info_t *out)
+{
+    snapshot_read(&gyro_bias_snap, out);
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     零偏保存服务
+// 参数说明     void
+// 返回参数     uint8           1-本次调用写入了 EEPROM 0-没有写入
+// 使用示例     if(gyro_bias_service()) printf("gyro bias saved\r\n");
+// 备注信息     冷启动标定完成后第一个静止窗口保存一次，之后零偏漂移超过 GYRO_BIAS_SAVE_DELTA 再保存
+//              写入失败也记录为已保存，避免每个窗口都擦写一次
+//-------------------------------------------------------------------------------------------------------------------
+uint8 gyro_bias_service(void)
+{
+    gyro_bias_info_t info;
+    int32 diff;
+    uint8 changed;
+    uint8 i;
+
+    gyro_bias_get_snapshot(&info);
+    if(!info.ready || !info.still)
+    {
+        return 0;
+    }
+
+    changed = !gyro_bias_saved_valid;
+    for(i = 0; i < 3; i++)
+    {
+        diff = info.bias[i] - gyro_bias_saved[i];
+        if(diff > GYRO_BIAS_SAVE_DELTA || diff < -GYRO_BIAS_SAVE_DELTA)
+        {
+            changed = 1;
+        }
+    }
+    if(!changed)
+    {
+        return 0;
+    }
+
+    for(i = 0; i < 3; i++)
+    {
+        gyro_bias_saved[i] = info.bias[i];
+    }
+    gyro_bias_saved_valid = 1;
+
+    return (myeeprom_save_gyro_bias(info.bias) == 0);
+}
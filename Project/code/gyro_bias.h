@@ -0,0 +1,115 @@
+#ifndef _GYRO_BIAS_H_
+#define _GYRO_BIAS_H_
+
+//-------------------------------------------------------------------------------------------------------------------
+// 头文件包含
+//-------------------------------------------------------------------------------------------------------------------
+#include "zf_common_headfile.h"
+
+//-------------------------------------------------------------------------------------------------------------------
+// 说明
+//-------------------------------------------------------------------------------------------------------------------
+// 陀螺仪零偏估计: 按 GYRO_BIAS_WINDOW 个采样为一个窗口统计三轴陀螺仪和加速度计的均值、方差
+//   冷启动: EEPROM 中没有零偏时，连续 GYRO_BIAS_CALIB_WINDOWS 个静止窗口的均值作为零偏 (上电后保持小车静止)
+//   热启动: 直接使用 EEPROM 中的零偏，不需要等待标定
+//   在线跟踪: 静止窗口三轴零偏按 1/2^GYRO_BIAS_STILL_SHIFT 向窗口均值靠近
+//             直道窗口 (gyro_bias_set_straight 提示) 只跟踪Z轴，步长更小，且只接受与当前零偏相差不大的均值 (排除弯道)
+// 零偏以 Q8 原始值保存 (1/256 LSB)，扣除时用误差扩散把小数部分分摊到各个采样，长时间平均没有截断误差
+// 零偏变化超过 GYRO_BIAS_SAVE_DELTA 且小车静止时，由主循环 gyro_bias_service() 写入 EEPROM
+
+//-------------------------------------------------------------------------------------------------------------------
+// 宏定义
+//-------------------------------------------------------------------------------------------------------------------
+#define GYRO_BIAS_FRAC_BITS         (8)       // 零偏小数位数 (Q8)
+#define GYRO_BIAS_WINDOW_SHIFT      (8)       // 窗口采样数 2^8 = 256 (416Hz 约0.6s，100Hz 约2.6s)
+#define GYRO_BIAS_WINDOW            (1 << GYRO_BIAS_WINDOW_SHIFT)
+#define GYRO_BIAS_CALIB_WINDOWS     (4)       // 冷启动需要的连续静止窗口数
+
+#define GYRO_BIAS_GYRO_DEV_MAX      (128)     // 陀螺仪偏离窗口首个采样的最大值 (LSB，约9°/s)，超过的轴本窗口不参与估计
+#define GYRO_BIAS_ACC_DEV_MAX       (256)     // 加速度计偏离窗口首个采样的最大值 (LSB，约60mg)，超过则本窗口不是静止
+#define GYRO_BIAS_STILL_GYRO_VAR    (9.0f)    // 静止判断: 陀螺仪每轴方差上限 (LSB²，约0.2°/s rms)
+#define GYRO_BIAS_STILL_ACC_VAR     (100.0f)  // 静止判断: 加速度计每轴方差上限 (LSB²，约2.4mg rms)
+#define GYRO_BIAS_STRAIGHT_VAR      (400.0f)  // 直道判断: Z轴陀螺仪方差上限 (LSB²，约1.4°/s rms)
+#define GYRO_BIAS_STRAIGHT_STEP     (14L << GYRO_BIAS_FRAC_BITS)  // 直道窗口均值与零偏的最大差 (约1°/s)，超过视为弯道
+
+#define GYRO_BIAS_STILL_SHIFT       (3)       // 静止窗口跟踪步长 1/8
+#define GYRO_BIAS_STRAIGHT_SHIFT    (5)       // 直道窗口跟踪步长 1/32
+#define GYRO_BIAS_SAVE_DELTA        (128)     // 与 EEPROM 中的零偏相差超过 0.5 LSB 时重新保存 (Q8)
+
+// gyro_bias_update() 返回值
+#define GYRO_BIAS_EVENT_NONE        (0)
+#define GYRO_BIAS_EVENT_CALIBRATED  (1)       // 本采样完成冷启动标定
+
+//-------------------------------------------------------------------------------------------------------------------
+// 数据结构
+//-------------------------------------------------------------------------------------------------------------------
+typedef struct
+{
+    int32 bias[3];                        // 三轴零偏 (Q8 原始值)
+    uint8 ready;                          // 1-零偏可用 (冷启动标定完成或从 EEPROM 加载) 0-正在冷启动标定
+    uint8 still;                          // 最近一个窗口是否静止
+    uint16 windows;                       // 已完成的窗口数
+} gyro_bias_info_t;
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数声明
+//-------------------------------------------------------------------------------------------------------------------
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     零偏估计初始化
+// 参数说明     void
+// 返回参数     uint8           1-从 EEPROM 加载了零偏 (热启动) 0-需要冷启动标定
+// 使用示例     gyro_bias_init();
+// 备注信息     在 myeeprom_init() 之后、IMU 开始更新之前调用
+//-------------------------------------------------------------------------------------------------------------------
+uint8 gyro_bias_init(void);
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     输入一个采样并扣除零偏
+// 参数说明     gyro            三轴陀螺仪原始值，返回时已扣除零偏
+// 参数说明     acc             三轴加速度计原始值 (只用于静止判断)
+// 返回参数     uint8           GYRO_BIAS_EVENT_NONE / GYRO_BIAS_EVENT_CALIBRATED
+// 使用示例     if(gyro_bias_update(gyro, acc) == GYRO_BIAS_EVENT_CALIBRATED) { 重置姿态 }
+// 备注信息     在 IMU 更新中每个采样调用一次，统计用扣除前的原始值
+//              冷启动标定完成前零偏为0
+//-------------------------------------------------------------------------------------------------------------------
+uint8 gyro_bias_update(int16 *gyro, const int16 *acc);
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     获取一个轴的零偏
+// 参数说明     axis            0-X 1-Y 2-Z
+// 返回参数     float           零偏 (LSB)
+// 使用示例     imu.gyro_z = imu660rb_gyro_transition(imu660rb_gyro_z) - gyro_bias_lsb(2) / MAHONY_GYRO_LSB;
+// 备注信息     与 gyro_bias_update() 在同一个上下文中调用
+//-------------------------------------------------------------------------------------------------------------------
+float gyro_bias_lsb(uint8 axis);
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     设置直道提示
+// 参数说明     straight        1-小车正沿直道行驶 0-其他
+// 返回参数     void
+// 使用示例     gyro_bias_set_straight(sensor_valid && error < 3.0f);
+// 备注信息     在控制中断中每周期调用，一个窗口内始终为1时该窗口才按直道跟踪Z轴零偏
+//-------------------------------------------------------------------------------------------------------------------
+void gyro_bias_set_straight(uint8 straight);
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     获取零偏估计状态快照
+// 参数说明     out             输出 最近一个窗口结束时的零偏和状态
+// 返回参数     void
+// 使用示例     gyro_bias_get_snapshot(&bias_view);
+// 备注信息     可在主循环中调用
+//-------------------------------------------------------------------------------------------------------------------
+void gyro_bias_get_snapshot(gyro_bias_info_t *out);
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     零偏保存服务
+// 参数说明     void
+// 返回参数     uint8           1-本次调用写入了 EEPROM 0-没有写入
+// 使用示例     if(gyro_bias_service()) printf("gyro bias saved\r\n");
+// 备注信息     在主循环中调用，零偏可用、小车静止且与已保存的零偏相差超过 GYRO_BIAS_SAVE_DELTA 时写入 EEPROM
+//              擦写期间 CPU 暂停，只在静止时写入，避免影响行驶中的控制中断
+//-------------------------------------------------------------------------------------------------------------------
+uint8 gyro_bias_service(void);
+
+#endif
@@ -0,0 +1,207 @@
+//-------------------------------------------------------------------------------------------------------------------
+// 头文件包含
+//-------------------------------------------------------------------------------------------------------------------
+#include "median.h"
+
+//-------------------------------------------------------------------------------------------------------------------
+// 宏定义
+//-------------------------------------------------------------------------------------------------------------------
+// 比较交换: 执行后 a <= b (主机性能测试编译时替换为统计比较和交换次数的版本)
+#ifndef MEDIAN_CSWAP
+#define MEDIAN_CSWAP(a, b)      { if((a) > (b)) { uint16 t_ = (a); (a) = (b); (b) = t_; } }
+#endif
+
+//===================================================================================================================
+// 取中值网络
+//===================================================================================================================
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     3个数取中值
+// 参数说明     a b c           三个样本
+// 返回参数     uint16          中值
+// 使用示例     uint16 mid = median3(i, j, k);
+// 备注信息     3次比较交换
+//-------------------------------------------------------------------------------------------------------------------
+uint16 median3(uint16 a, uint16 b, uint16 c)
+{
+    MEDIAN_CSWAP(a, b);
+    MEDIAN_CSWAP(b, c);
+    MEDIAN_CSWAP(a, b);
+    return b;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     5个数取中值
+// 参数说明     v               5元素数组 (执行后顺序改变)
+// 返回参数     uint16          中值
+// 使用示例     uint16 mid = median_of_5(arr);
+// 备注信息     7次比较交换
+//-------------------------------------------------------------------------------------------------------------------
+uint16 median_of_5(uint16 v[])
+{
+    MEDIAN_CSWAP(v[0], v[1]);
+    MEDIAN_CSWAP(v[3], v[4]);
+    MEDIAN_CSWAP(v[0], v[3]);
+    MEDIAN_CSWAP(v[1], v[4]);
+    MEDIAN_CSWAP(v[1], v[2]);
+    MEDIAN_CSWAP(v[2], v[3]);
+    MEDIAN_CSWAP(v[1], v[2]);
+    return v[2];
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     7个数取中值
+// 参数说明     v               7元素数组 (执行后顺序改变)
+// 返回参数     uint16          中值
+// 使用示例     uint16 mid = median_of_7(arr);
+// 备注信息     13次比较交换
+//-------------------------------------------------------------------------------------------------------------------
+uint16 median_of_7(uint16 v[])
+{
+    MEDIAN_CSWAP(v[0], v[5]);
+    MEDIAN_CSWAP(v[0], v[3]);
+    MEDIAN_CSWAP(v[1], v[6]);
+    MEDIAN_CSWAP(v[2], v[4]);
+    MEDIAN_CSWAP(v[0], v[1]);
+    MEDIAN_CSWAP(v[3], v[5]);
+    MEDIAN_CSWAP(v[2], v[6]);
+    MEDIAN_CSWAP(v[2], v[3]);
+    MEDIAN_CSWAP(v[3], v[6]);
+    MEDIAN_CSWAP(v[4], v[5]);
+    MEDIAN_CSWAP(v[1], v[4]);
+    MEDIAN_CSWAP(v[1], v[3]);
+    MEDIAN_CSWAP(v[3], v[4]);
+    return v[3];
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     9个数取中值
+// 参数说明     v               9元素数组 (执行后顺序改变)
+// 返回参数     uint16          中值
+// 使用示例     uint16 mid = median_of_9(arr);
+// 备注信息     19次比较交换
+//-------------------------------------------------------------------------------------------------------------------
+uint16 median_of_9(uint16 v[])
+{
+    MEDIAN_CSWAP(v[1], v[2]);
+    MEDIAN_CSWAP(v[4], v[5]);
+    MEDIAN_CSWAP(v[7], v[8]);
+    MEDIAN_CSWAP(v[0], v[1]);
+    MEDIAN_CSWAP(v[3], v[4]);
+    MEDIAN_CSWAP(v[6], v[7]);
+    MEDIAN_CSWAP(v[1], v[2]);
+    MEDIAN_CSWAP(v[4], v[5]);
+    MEDIAN_CSWAP(v[7], v[8]);
+    MEDIAN_CSWAP(v[0], v[3]);
+    MEDIAN_CSWAP(v[5], v[8]);
+    MEDIAN_CSWAP(v[4], v[7]);
+    MEDIAN_CSWAP(v[3], v[6]);
+    MEDIAN_CSWAP(v[1], v[4]);
+    MEDIAN_CSWAP(v[2], v[5]);
+    MEDIAN_CSWAP(v[4], v[7]);
+    MEDIAN_CSWAP(v[2], v[4]);
+    MEDIAN_CSWAP(v[4], v[6]);
+    MEDIAN_CSWAP(v[2], v[4]);
+    return v[4];
+}
+
+//===================================================================================================================
+// 完整排序网络
+//===================================================================================================================
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     3元素排序网络 (从小到大)
+// 参数说明     v               3元素数组
+// 返回参数     void
+// 使用示例     sort_network_3(arr);
+// 备注信息     3次比较交换
+//-------------------------------------------------------------------------------------------------------------------
+void sort_network_3(uint16 v[])
+{
+    MEDIAN_CSWAP(v[0], v[1]);
+    MEDIAN_CSWAP(v[1], v[2]);
+    MEDIAN_CSWAP(v[0], v[1]);
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     5元素排序网络 (从小到大)
+// 参数说明     v               5元素数组
+// 返回参数     void
+// 使用示例     sort_network_5(arr);
+// 备注信息     9次比较交换
+//-------------------------------------------------------------------------------------------------------------------
+void sort_network_5(uint16 v[])
+{
+    MEDIAN_CSWAP(v[0], v[3]);
+    MEDIAN_CSWAP(v[1], v[4]);
+    MEDIAN_CSWAP(v[0], v[2]);
+    MEDIAN_CSWAP(v[1], v[3]);
+    MEDIAN_CSWAP(v[0], v[1]);
+    MEDIAN_CSWAP(v[2], v[4]);
+    MEDIAN_CSWAP(v[1], v[2]);
+    MEDIAN_CSWAP(v[3], v[4]);
+    MEDIAN_CSWAP(v[2], v[3]);
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     7元素排序网络 (从小到大)
+// 参数说明     v               7元素数组
+// 返回参数     void
+// 使用示例     sort_network_7(arr);
+// 备注信息     16次比较交换
+//-------------------------------------------------------------------------------------------------------------------
+void sort_network_7(uint16 v[])
+{
+    MEDIAN_CSWAP(v[0], v[6]);
+    MEDIAN_CSWAP(v[2], v[3]);
+    MEDIAN_CSWAP(v[4], v[5]);
+    MEDIAN_CSWAP(v[0], v[2]);
+    MEDIAN_CSWAP(v[1], v[4]);
+    MEDIAN_CSWAP(v[3], v[6]);
+    MEDIAN_CSWAP(v[0], v[1]);
+    MEDIAN_CSWAP(v[2], v[5]);
+    MEDIAN_CSWAP(v[3], v[4]);
+    MEDIAN_CSWAP(v[1], v[2]);
+    MEDIAN_CSWAP(v[4], v[6]);
+    MEDIAN_CSWAP(v[2], v[3]);
+    MEDIAN_CSWAP(v[4], v[5]);
+    MEDIAN_CSWAP(v[1], v[2]);
+    MEDIAN_CSWAP(v[3], v[4]);
+    MEDIAN_CSWAP(v[5], v[6]);
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     9元素排序网络 (从小到大)
+// 参数说明     v               9元素数组
+// 返回参数     void
+// 使用示例     sort_network_9(arr);
+// 备注信息     25次比较交换
+//-------------------------------------------------------------------------------------------------------------------
+void sort_network_9(uint16 v[])
+{
+    MEDIAN_CSWAP(v[0], v[3]);
+    MEDIAN_CSWAP(v[1], v[7]);
+    MEDIAN_CSWAP(v[2], v[5]);
+    MEDIAN_CSWAP(v[4], v[8]);
+    MEDIAN_CSWAP(v[0], v[7]);
+    MEDIAN_CSWAP(v[2], v[4]);
+    MEDIAN_CSWAP(v[3], v[8]);
+    MEDIAN_CSWAP(v[5], v[6]);
+    MEDIAN_CSWAP(v[0], v[2]);
+    MEDIAN_CSWAP(v[1], v[3]);
+    MEDIAN_CSWAP(v[4], v[5]);
+    MEDIAN_CSWAP(v[7], v[8]);
+    MEDIAN_CSWAP(v[1], v[4]);
+    MEDIAN_CSWAP(v[3], v[6]);
+    MEDIAN_CSWAP(v[5], v[7]);
+    MEDIAN_CSWAP(v[0], v[1]);
+    MEDIAN_CSWAP(v[2], v[4]);
+    MEDIAN_CSWAP(v[3], v[5]);
+    MEDIAN_CSWAP(v[6], v[8]);
+    MEDIAN_CSWAP(v[2], v[3]);
+    MEDIAN_CSWAP(v[4], v[5]);
+    MEDIAN_CSWAP(v[6], v[7]);
+    MEDIAN_CSWAP(v[1], v[2]);
+    MEDIAN_CSWAP(v[3], v[4]);
+    MEDIAN_CSWAP(v[5], v[6]);
+}
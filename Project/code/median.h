@@ -0,0 +1,105 @@
+#ifndef _MEDIAN_H_
+#define _MEDIAN_H_
+
+//-------------------------------------------------------------------------------------------------------------------
+// 头文件包含
+//-------------------------------------------------------------------------------------------------------------------
+#include "zf_common_headfile.h"
+
+//-------------------------------------------------------------------------------------------------------------------
+// 说明
+//-------------------------------------------------------------------------------------------------------------------
+// 固定长度排序网络: 比较交换的次序在编译时确定，没有循环控制和提前退出判断
+// 每次比较交换只有一个条件分支，执行时间与输入数据基本无关
+//
+// 比较交换次数 (冒泡排序为 n(n-1)/2 次比较，交换次数随数据变化最多同样多次):
+//   n    取中值网络    完整排序网络    冒泡排序
+//   3        3              3              3
+//   5        7              9             10
+//   7       13             16             21
+//   9       19             25             36
+//
+// 只需要中值时用 median_of_x()，需要按秩取值(去极值平均等)时用 sort_network_x()
+// 两类函数都会改变输入数组中元素的顺序
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数声明 - 取中值网络
+//-------------------------------------------------------------------------------------------------------------------
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     3个数取中值
+// 参数说明     a b c           三个样本
+// 返回参数     uint16          中值
+// 使用示例     uint16 mid = median3(i, j, k);
+// 备注信息     3次比较交换
+//-------------------------------------------------------------------------------------------------------------------
+uint16 median3(uint16 a, uint16 b, uint16 c);
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     5个数取中值
+// 参数说明     v               5元素数组 (执行后顺序改变)
+// 返回参数     uint16          中值
+// 使用示例     uint16 mid = median_of_5(arr);
+// 备注信息     7次比较交换
+//-------------------------------------------------------------------------------------------------------------------
+uint16 median_of_5(uint16 v[]);
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     7个数取中值
+// 参数说明     v               7元素数组 (执行后顺序改变)
+// 返回参数     uint16          中值
+// 使用示例     uint16 mid = median_of_7(arr);
+// 备注信息     13次比较交换
+//-------------------------------------------------------------------------------------------------------------------
+uint16 median_of_7(uint16 v[]);
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     9个数取中值
+// 参数说明     v               9元素数组 (执行后顺序改变)
+// 返回参数     uint16          中值
+// 使用示例     uint16 mid = median_of_9(arr);
+// 备注信息     19次比较交换
+//-------------------------------------------------------------------------------------------------------------------
+uint16 median_of_9(uint16 v[]);
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数声明 - 完整排序网络
+//-------------------------------------------------------------------------------------------------------------------
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     3元素排序网络 (从小到大)
+// 参数说明     v               3元素数组
+// 返回参数     void
+// 使用示例     sort_network_3(arr);
+// 备注信息     3次比较交换
+//-------------------------------------------------------------------------------------------------------------------
+void sort_network_3(uint16 v[]);
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     5元素排序网络 (从小到大)
+// 参数说明     v               5元素数组
+// 返回参数     void
+// 使用示例     sort_network_5(arr);
+// 备注信息     9次比较交换
+//-------------------------------------------------------------------------------------------------------------------
+void sort_network_5(uint16 v[]);
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     7元素排序网络 (从小到大)
+// 参数说明     v               7元素数组
+// 返回参数     void
+// 使用示例     sort_network_7(arr);
+// 备注信息     16次比较交换
+//-------------------------------------------------------------------------------------------------------------------
+void sort_network_7(uint16 v[]);
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     9元素排序网络 (从小到大)
+// 参数说明     v               9元素数组
+// 返回参数     void
+// 使用示例     sort_network_9(arr);
+// 备注信息     25次比较交换
+//-------------------------------------------------------------------------------------------------------------------
+void sort_network_9(uint16 v[]);
+
+#endif
@@ -5,7 +5,6 @@
 ********************************************************************************************************************/
 
 #include "myeeprom.h"
-#include "zf_driver_eeprom.h"
 #include "pid.h"
 
 /*==================================================================================================================*/
@@ -35,6 +34,14 @@ static void write_float(uint32 addr, float value);
  */
 static float read_float(uint32 addr);
 
+/**
+ * @brief       CRC16 (CCITT, 多项式 0x1021) 累加一个字节
+ * @param       crc     当前 CRC 值
+ * @param       dat     新字节
+ * @return      更新后的 CRC 值
+ */
+static uint16 crc16_update(uint16 crc, uint8 dat);
+
 /*==================================================================================================================*/
 /* =============== API 函数实现 =============== */
 /*==================================================================================================================*/
@@ -69,6 +76,9 @@ uint8 myeeprom_save_speed_pid(pid_param_t *left_pid, pid_param_t *right_pid)
         return 1;
     }
 
+    // Flash 写入只能把1写成0，覆盖之前保存的参数要先擦除整页
+    iap_erase_page(EEPROM_PID_ADDR);
+
     // 写入左电机 PID 参数 (跳过魔数位置，先写数据)
     write_float(EEPROM_PID_ADDR + 2, left_pid->kp);
     write_float(EEPROM_PID_ADDR + 6, left_pid->ki);
@@ -156,6 +166,231 @@ void myeeprom_restore_default(pid_param_t *left_pid, pid_param_t *right_pid)
     myeeprom_save_speed_pid(left_pid, right_pid);
 }
 
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     保存 ADC 校准表到 EEPROM
+// 参数说明     table       校准表 (max_min_adc[])
+// 参数说明     count       表项数 (不超过 EEPROM_ADC_CALIB_MAX)
+// 返回参数     uint8       0=成功, 1=失败
+// 使用示例     myeeprom_save_adc_calib(max_min_adc, 2*CHANNEL_NUMBER);
+// 备注信息     存储格式: 魔数(2) + 表项(count*2, 低字节在前) + CRC16(2)
+//              IAP 写只能把1写成0，所以先擦除整页再写；魔数最后写入，掉电中断时数据不会被当作有效
+//              写完后回读校验
+//-------------------------------------------------------------------------------------------------------------------
+uint8 myeeprom_save_adc_calib(uint16 *table, uint8 count)
+{
+    uint32 addr;
+    uint16 crc;
+    uint8 dat;
+    uint8 i;
+
+    if(table == 0 || count == 0 || count > EEPROM_ADC_CALIB_MAX)
+    {
+        return 1;
+    }
+
+    iap_erase_page(EEPROM_ADC_CALIB_ADDR);
+
+    // 写入表项并计算 CRC
+    crc = 0xFFFF;
+    addr = EEPROM_ADC_CALIB_ADDR + 2;
+    for(i = 0; i < count; i++)
+    {
+        dat = (uint8)(table[i] & 0xFF);
+        iap_write_byte(addr++, dat);
+        crc = crc16_update(crc, dat);
+
+        dat = (uint8)((table[i] >> 8) & 0xFF);
+        iap_write_byte(addr++, dat);
+        crc = crc16_update(crc, dat);
+    }
+    iap_write_byte(addr, (uint8)(crc & 0xFF));
+    iap_write_byte(addr + 1, (uint8)((crc >> 8) & 0xFF));
+
+    // 写入魔数 (最后写入)
+    iap_write_byte(EEPROM_ADC_CALIB_ADDR, (uint8)(EEPROM_ADC_CALIB_MAGIC & 0xFF));
+    iap_write_byte(EEPROM_ADC_CALIB_ADDR + 1, (uint8)((EEPROM_ADC_CALIB_MAGIC >> 8) & 0xFF));
+
+    // 回读校验 (比较失败时表中数据与 EEPROM 不一致)
+    for(i = 0; i < count; i++)
+    {
+        addr = EEPROM_ADC_CALIB_ADDR + 2 + 2 * (uint32)i;
+        if((iap_read_byte(addr) | ((uint16)iap_read_byte(addr + 1) << 8)) != table[i])
+        {
+            return 1;
+        }
+    }
+
+    return 0;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     从 EEPROM 加载 ADC 校准表
+// 参数说明     table       校准表 (max_min_adc[])
+// 参数说明     count       表项数 (不超过 EEPROM_ADC_CALIB_MAX)
+// 返回参数     uint8       0=成功加载, 1=数据无效
+// 使用示例     myeeprom_load_adc_calib(max_min_adc, 2*CHANNEL_NUMBER);
+// 备注信息     先读到临时缓冲，魔数和 CRC 都校验通过才复制到 table，否则 table 保持原值
+//-------------------------------------------------------------------------------------------------------------------
+uint8 myeeprom_load_adc_calib(uint16 *table, uint8 count)
+{
+    uint16 buffer[EEPROM_ADC_CALIB_MAX];
+    uint32 addr;
+    uint16 magic_read;
+    uint16 crc;
+    uint16 crc_read;
+    uint8 low;
+    uint8 high;
+    uint8 i;
+
+    if(table == 0 || count == 0 || count > EEPROM_ADC_CALIB_MAX)
+    {
+        return 1;
+    }
+
+    magic_read = iap_read_byte(EEPROM_ADC_CALIB_ADDR) | ((uint16)iap_read_byte(EEPROM_ADC_CALIB_ADDR + 1) << 8);
+    if(magic_read != EEPROM_ADC_CALIB_MAGIC)
+    {
+        return 1;
+    }
+
+    crc = 0xFFFF;
+    addr = EEPROM_ADC_CALIB_ADDR + 2;
+    for(i = 0; i < count; i++)
+    {
+        low = iap_read_byte(addr++);
+        high = iap_read_byte(addr++);
+        crc = crc16_update(crc, low);
+        crc = crc16_update(crc, high);
+        buffer[i] = low | ((uint16)high << 8);
+    }
+    crc_read = iap_read_byte(addr) | ((uint16)iap_read_byte(addr + 1) << 8);
+    if(crc_read != crc)
+    {
+        return 1;
+    }
+
+    for(i = 0; i < count; i++)
+    {
+        table[i] = buffer[i];
+    }
+
+    return 0;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     保存陀螺仪零偏到 EEPROM
+// 参数说明     bias        三轴零偏 (Q8 原始值)
+// 返回参数     uint8       0=成功, 1=失败
+// 使用示例     myeeprom_save_gyro_bias(bias);
+// 备注信息     存储格式: 魔数(2) + 零偏(3*4, 低字节在前) + CRC16(2)
+//              与 ADC 校准表相同，先擦除整页，魔数最后写入，写完后回读校验
+//-------------------------------------------------------------------------------------------------------------------
+uint8 myeeprom_save_gyro_bias(int32 *bias)
+{
+    uint32 addr;
+    uint32 value;
+    uint16 crc;
+    uint8 dat;
+    uint8 i;
+    uint8 j;
+
+    if(bias == 0)
+    {
+        return 1;
+    }
+
+    iap_erase_page(EEPROM_GYRO_BIAS_ADDR);
+
+    // 写入零偏并计算 CRC
+    crc = 0xFFFF;
+    addr = EEPROM_GYRO_BIAS_ADDR + 2;
+    for(i = 0; i < 3; i++)
+    {
+        value = (uint32)bias[i];
+        for(j = 0; j < 4; j++)
+        {
+            dat = (uint8)(value & 0xFF);
+            iap_write_byte(addr++, dat);
+            crc = crc16_update(crc, dat);
+            value >>= 8;
+        }
+    }
+    iap_write_byte(addr, (uint8)(crc & 0xFF));
+    iap_write_byte(addr + 1, (uint8)((crc >> 8) & 0xFF));
+
+    // 写入魔数 (最后写入)
+    iap_write_byte(EEPROM_GYRO_BIAS_ADDR, (uint8)(EEPROM_GYRO_BIAS_MAGIC & 0xFF));
+    iap_write_byte(EEPROM_GYRO_BIAS_ADDR + 1, (uint8)((EEPROM_GYRO_BIAS_MAGIC >> 8) & 0xFF));
+
+    // 回读校验
+    crc = 0xFFFF;
+    for(addr = EEPROM_GYRO_BIAS_ADDR + 2; addr < EEPROM_GYRO_BIAS_ADDR + 14; addr++)
+    {
+        crc = crc16_update(crc, iap_read_byte(addr));
+    }
+    if((iap_read_byte(addr) | ((uint16)iap_read_byte(addr + 1) << 8)) != crc)
+    {
+        return 1;
+    }
+
+    return 0;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     从 EEPROM 加载陀螺仪零偏
+// 参数说明     bias        三轴零偏 (Q8 原始值)
+// 返回参数     uint8       0=成功加载, 1=数据无效
+// 使用示例     myeeprom_load_gyro_bias(bias);
+// 备注信息     魔数和 CRC 都校验通过才写入 bias，否则 bias 保持原值
+//-------------------------------------------------------------------------------------------------------------------
+uint8 myeeprom_load_gyro_bias(int32 *bias)
+{
+    uint32 buffer[3];
+    uint32 addr;
+    uint16 magic_read;
+    uint16 crc;
+    uint16 crc_read;
+    uint8 dat;
+    uint8 i;
+    uint8 j;
+
+    if(bias == 0)
+    {
+        return 1;
+    }
+
+    magic_read = iap_read_byte(EEPROM_GYRO_BIAS_ADDR) | ((uint16)iap_read_byte(EEPROM_GYRO_BIAS_ADDR + 1) << 8);
+    if(magic_read != EEPROM_GYRO_BIAS_MAGIC)
+    {
+        return 1;
+    }
+
+    crc = 0xFFFF;
+    addr = EEPROM_GYRO_BIAS_ADDR + 2;
+    for(i = 0; i < 3; i++)
+    {
+        buffer[i] = 0;
+        for(j = 0; j < 4; j++)
+        {
+            dat = iap_read_byte(addr++);
+            crc = crc16_update(crc, dat);
+            buffer[i] |= (uint32)dat << (8 * j);
+        }
+    }
+    crc_read = iap_read_byte(addr) | ((uint16)iap_read_byte(addr + 1) << 8);
+    if(crc_read != crc)
+    {
+        return 1;
+    }
+
+    for(i = 0; i < 3; i++)
+    {
+        bias[i] = (int32)buffer[i];
+    }
+
+    return 0;
+}
+
 //-------------------------------------------------------------------------------------------------------------------
 // 函数简介     擦除 EEPROM 存储区域
 // 参数说明     void
@@ -211,3 +446,29 @@ static float read_float(uint32 addr)
 
     return value;
 }
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     CRC16 (CCITT, 多项式 0x1021) 累加一个字节
+// 参数说明     crc     当前 CRC 值 (初值 0xFFFF)
+// 参数说明     dat     新字节
+// 返回参数     uint16  更新后的 CRC 值
+//-------------------------------------------------------------------------------------------------------------------
+static uint16 crc16_update(uint16 crc, uint8 dat)
+{
+    uint8 i;
+
+    crc ^= (uint16)dat << 8;
+    for(i = 0; i < 8; i++)
+    {
+        if(crc & 0x8000)
+        {
+            crc = (crc << 1) ^ 0x1021;
+        }
+        else
+        {
+            crc <<= 1;
+        }
+    }
+
+    return crc;
+}
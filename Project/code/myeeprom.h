@@ -21,6 +21,13 @@
 #define EEPROM_MAGIC_ADDR        0x0000    // 魔数地址 (用于检测数据有效性)
 #define EEPROM_MAGIC_VALUE       0xA5A5    // 魔数值 (如果读取到这个值说明数据有效)
 
+#define EEPROM_ADC_CALIB_ADDR    0x0200    // ADC 校准表存储起始地址 (独立一页，擦写不影响 PID 参数)
+#define EEPROM_ADC_CALIB_MAGIC   0x5AC3    // ADC 校准表魔数值
+#define EEPROM_ADC_CALIB_MAX     16        // ADC 校准表最大项数
+
+#define EEPROM_GYRO_BIAS_ADDR    0x0400    // 陀螺仪零偏存储起始地址 (独立一页)
+#define EEPROM_GYRO_BIAS_MAGIC   0x6B1A    // 陀螺仪零偏魔数值
+
 /*==================================================================================================================*/
 /* =============== 数据结构定义 =============== */
 /*==================================================================================================================*/
@@ -80,6 +87,40 @@ uint8 myeeprom_load_speed_pid(pid_param_t *left_pid, pid_param_t *right_pid);
  */
 void myeeprom_restore_default(pid_param_t *left_pid, pid_param_t *right_pid);
 
+/**
+ * @brief       保存 ADC 校准表到 EEPROM
+ * @param       table       校准表 (max_min_adc[])
+ * @param       count       表项数 (不超过 EEPROM_ADC_CALIB_MAX)
+ * @return      0=成功, 1=失败
+ * @note        存储格式: 魔数(2) + 表项(count*2) + CRC16(2)，写入前擦除整页
+ */
+uint8 myeeprom_save_adc_calib(uint16 *table, uint8 count);
+
+/**
+ * @brief       从 EEPROM 加载 ADC 校准表
+ * @param       table       校准表 (max_min_adc[])
+ * @param       count       表项数 (不超过 EEPROM_ADC_CALIB_MAX)
+ * @return      0=成功加载, 1=数据无效
+ * @note        魔数或 CRC 校验失败时 table 保持原值不变
+ */
+uint8 myeeprom_load_adc_calib(uint16 *table, uint8 count);
+
+/**
+ * @brief       保存陀螺仪零偏到 EEPROM
+ * @param       bias        三轴零偏 (Q8 原始值)
+ * @return      0=成功, 1=失败
+ * @note        存储格式: 魔数(2) + 零偏(3*4) + CRC16(2)，写入前擦除整页
+ */
+uint8 myeeprom_save_gyro_bias(int32 *bias);
+
+/**
+ * @brief       从 EEPROM 加载陀螺仪零偏
+ * @param       bias        三轴零偏 (Q8 原始值)
+ * @return      0=成功加载, 1=数据无效
+ * @note        魔数或 CRC 校验失败时 bias 保持原值不变
+ */
+uint8 myeeprom_load_gyro_bias(int32 *bias);
+
 /**
  * @brief       擦除 EEPROM 存储区域
  * @note        擦除 PID 参数所在的页 (512字节)
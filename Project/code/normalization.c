@@ -2,17 +2,178 @@
 
 // 全局变量定义
 uint16 adc_normalized_list[CHANNEL_NUMBER] = {0};
+uint16 adc_normalized_fine[CHANNEL_NUMBER] = {0};
+vuint16 adc_frame_seq = 0;                            // 归一化数据帧序号
+
+// ADC采样帧快照 (Adc_Frame_Update 完成后发布)
+static adc_frame_t adc_frame_snap_bank[2];
+static snapshot_t adc_frame_snap = {{&adc_frame_snap_bank[0], &adc_frame_snap_bank[1]}, sizeof(adc_frame_t), 0, 0};
+
+// 定点归一化缩放表 (由 Normalization_Update_Scale 根据 max_min_adc[] 计算)
+typedef struct
+{
+    uint16 min[CHANNEL_NUMBER];                         // 每通道 min
+    uint16 range[CHANNEL_NUMBER];                       // 每通道 max-min
+    uint32 scale[CHANNEL_NUMBER];                       // 每通道 ceil(50*2^24/range)
+    uint16 fine_range[CHANNEL_NUMBER];                  // 每通道 14位 max-min
+    uint32 fine_scale[CHANNEL_NUMBER];                  // 每通道 ceil(1000*2^22/fine_range)
+} norm_table_t;
+
+// 中断中使用的缩放表，和主循环写入的影子副本 (下一次归一化开始时整体应用)
+static norm_table_t norm_table = {{0}, {1, 1, 1, 1, 1}, {0}, {1, 1, 1, 1, 1}, {0}};
+static norm_table_t norm_table_shadow;
+static vuint8 norm_table_ready = 0;                   // 1-影子缩放表已写完，等待中断应用
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     应用影子缩放表
+// 参数说明     void
+// 返回参数     void
+// 备注信息     在归一化开始时调用 (控制中断中)，min、range、scale 一起更新，不会用新 range 配旧 scale
+//-------------------------------------------------------------------------------------------------------------------
+static void Normalization_Apply_Scale(void)
+{
+    if(norm_table_ready)
+    {
+        norm_table = norm_table_shadow;
+        norm_table_ready = 0;
+    }
+}
 
 //-------------------------------------------------------------------------------------------------------------------
-// 函数简介     ADC值归一化处理
+// 函数简介     更新归一化定点缩放表
+// 参数说明     void
+// 返回参数     void
+// 使用示例     Normalization_Update_Scale();
+// 备注信息     scale = ceil(50 * 2^24 / range)，只在 max_min_adc[] 改变时做一次32位除法
+//              同时计算14位过采样值使用的 ceil(1000 * 2^22 / (range << 2))
+//              max_min_adc[] 每次修改后(上电加载、校准完成)都必须调用一次
+//              在主循环中调用: 先写入影子副本，下一次 Normalization() / Normalization_Fine() 开始时整体应用，
+//              控制中断不会用到一半新一半旧的缩放表
+//-------------------------------------------------------------------------------------------------------------------
+void Normalization_Update_Scale(void)
+{
+    uint16 range;
+    uint8 i;
+
+    // 先清标志再写副本: 写副本期间进入的中断继续使用旧表
+    norm_table_ready = 0;
+    for(i = 0; i < CHANNEL_NUMBER; i++)
+    {
+        // 计算范围，防止除零
+        if(max_min_adc[2*i] > max_min_adc[2*i+1])
+        {
+            range = max_min_adc[2*i] - max_min_adc[2*i+1];
+        }
+        else
+        {
+            range = 1;
+        }
+
+        norm_table_shadow.min[i] = max_min_adc[2*i+1];
+        norm_table_shadow.range[i] = range;
+        norm_table_shadow.scale[i] = (((uint32)NORMALIZATION_MAX << NORMALIZATION_SHIFT) + range - 1) / range;
+
+        range <<= ADC_OVERSAMPLE_BITS;
+        norm_table_shadow.fine_range[i] = range;
+        norm_table_shadow.fine_scale[i] = (((uint32)NORMALIZATION_FINE_MAX << NORMALIZATION_FINE_SHIFT) + range - 1) / range;
+    }
+    norm_table_ready = 1;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     ADC值归一化处理 (定点)
 // 参数说明     void
 // 返回参数     void
 // 使用示例     Normalization();
 // 备注信息     将adc_val_list[]中的ADC原始值归一化到0-50范围
+//              result = ((adc_val - min) * scale) >> 24，每通道一次整数乘法，无浮点运算
+//              因 adc_val - min < range，乘积小于 50*2^24 + 4095，不会溢出32位
+//              对 range <= 4095 的全部输入与 Normalization_Float() 结果完全一致
+//-------------------------------------------------------------------------------------------------------------------
+void Normalization(void)
+{
+    uint16 min;
+    uint16 x;
+    uint8 i;
+
+    Normalization_Apply_Scale();
+    for(i = 0; i < CHANNEL_NUMBER; i++)
+    {
+        min = norm_table.min[i];
+
+        if(adc_val_list[i] <= min)
+        {
+            adc_normalized_list[i] = 0;
+            continue;
+        }
+
+        x = adc_val_list[i] - min;
+        if(x >= norm_table.range[i])
+        {
+            adc_normalized_list[i] = NORMALIZATION_MAX;
+        }
+        else
+        {
+            adc_normalized_list[i] = (uint16)(((uint32)x * norm_table.scale[i]) >> NORMALIZATION_SHIFT);
+        }
+    }
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     过采样值精细归一化处理
+// 参数说明     void
+// 返回参数     void
+// 使用示例     Normalization_Fine();
+// 备注信息     将 adc_fine_list[] 中的14位过采样值归一化到 0-1000
+//              14位范围下 Q22 倒数偶尔会比 x*1000/range 大1，用一次乘法比较修正，结果与整数除法完全一致
+//              x < fine_range <= 16380，各乘积都不超过32位
+//-------------------------------------------------------------------------------------------------------------------
+void Normalization_Fine(void)
+{
+    uint16 min;
+    uint16 x;
+    uint16 q;
+    uint8 i;
+
+    Normalization_Apply_Scale();
+    for(i = 0; i < CHANNEL_NUMBER; i++)
+    {
+        min = norm_table.min[i] << ADC_OVERSAMPLE_BITS;
+
+        if(adc_fine_list[i] <= min)
+        {
+            adc_normalized_fine[i] = 0;
+            continue;
+        }
+
+        x = adc_fine_list[i] - min;
+        if(x >= norm_table.fine_range[i])
+        {
+            adc_normalized_fine[i] = NORMALIZATION_FINE_MAX;
+        }
+        else
+        {
+            q = (uint16)(((uint32)x * norm_table.fine_scale[i]) >> NORMALIZATION_FINE_SHIFT);
+            if((uint32)q * norm_table.fine_range[i] > (uint32)x * NORMALIZATION_FINE_MAX)
+            {
+                q--;
+            }
+            adc_normalized_fine[i] = q;
+        }
+    }
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     ADC值归一化处理 (浮点参考实现)
+// 参数说明     void
+// 返回参数     void
+// 使用示例     Normalization_Float();
+// 备注信息     将adc_val_list[]中的ADC原始值归一化到0-50范围
 //              归一化公式: result = 50 * (adc_val - min) / (max - min)
 //              改进: 添加除零保护、超界限幅
+//              保留作为定点版本 Normalization() 的对照，控制流程中不再调用
 //-------------------------------------------------------------------------------------------------------------------
-void Normalization(void)
+void Normalization_Float(void)
 {
     float temp;
     float range;
@@ -38,3 +199,63 @@ void Normalization(void)
         adc_normalized_list[i] = (uint16)temp;
     }
 }
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     ADC采样帧更新 (采样 + 滤波 + 归一化)
+// 参数说明     void
+// 返回参数     void
+// 使用示例     Adc_Frame_Update();
+// 备注信息     在10ms控制中断中、控制算法之前调用，保证控制使用的是本周期的新数据
+//              采样方式由 adc.h 中的 ADC_GETVAL_METHOD 决定:
+//              ADC_METHOD_SCAN  - 读取后台扫描最近一帧，不等待转换，没有新帧时直接返回
+//              ADC_METHOD_OVERSAMPLE - 同 ADC_METHOD_SCAN，并计算 0-1000 精细归一化值
+//              ADC_METHOD_FILTER - 中断内每通道1次转换，滑动窗口滤波
+//              ADC_METHOD_QUICK - 中断内每通道3次转换取中值
+//              完成后 adc_frame_seq 加1，控制代码据此区分新旧数据，并发布快照供主循环读取
+//-------------------------------------------------------------------------------------------------------------------
+void Adc_Frame_Update(void)
+{
+    adc_frame_t frame;
+    uint32 stamp;
+
+#if(ADC_USE_SCAN)
+    if(!Adc_Getval_Scan())
+    {
+        return;  // 后台扫描还没有完成新的一帧，保持帧序号不变
+    }
+    stamp = adc_scan_stamp;              // 扫描中断中最后一个通道转换完成的时刻，不是读取的时刻
+#else
+#if(ADC_GETVAL_METHOD == ADC_METHOD_FILTER)
+    Adc_Getval_Filter();
+#else
+    Adc_Getval_Quick();
+#endif
+    stamp = timebase_now_us();           // 刚在本函数中完成转换
+#endif
+
+    Adc_Calib_Feed();                    // 扫描校准模式下记录峰谷值，未校准时直接返回
+    Normalization();
+#if(ADC_GETVAL_METHOD == ADC_METHOD_OVERSAMPLE)
+    Normalization_Fine();
+#endif
+    adc_frame_seq++;
+
+    // 发布快照
+    memcpy(frame.normalized, adc_normalized_list, sizeof(frame.normalized));
+    memcpy(frame.fine, adc_normalized_fine, sizeof(frame.fine));
+    frame.seq = adc_frame_seq;
+    frame.stamp = stamp;
+    snapshot_publish(&adc_frame_snap, &frame);
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     获取ADC采样帧快照
+// 参数说明     frame           输出 最近一次 Adc_Frame_Update() 完成的归一化数据
+// 返回参数     void
+// 使用示例     Adc_Frame_Snapshot(&frame);
+// 备注信息     可在主循环中调用，不关闭中断
+//-------------------------------------------------------------------------------------------------------------------
+void Adc_Frame_Snapshot(adc_frame_t *frame)
+{
+    snapshot_read(&adc_frame_snap, frame);
+}
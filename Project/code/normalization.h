@@ -10,15 +10,73 @@
 // 宏定义
 //-------------------------------------------------------------------------------------------------------------------
 #define CHANNEL_NUMBER      (5)       // ADC通道数量
+#define NORMALIZATION_MAX   (50)      // 归一化输出上限 (输出范围 0-50)
+#define NORMALIZATION_SHIFT (24)      // 定点倒数缩放系数的小数位数 (Q24)
+#define NORMALIZATION_FINE_MAX   (1000)  // 精细归一化输出上限 (输出范围 0-1000)
+#define NORMALIZATION_FINE_SHIFT (22)    // 精细归一化缩放系数的小数位数 (Q22，1000*2^22 不超过32位)
 
 //-------------------------------------------------------------------------------------------------------------------
 // 全局变量声明
 //-------------------------------------------------------------------------------------------------------------------
 extern uint16 adc_normalized_list[CHANNEL_NUMBER];    // 归一化后的ADC值数组
+extern uint16 adc_normalized_fine[CHANNEL_NUMBER];    // 精细归一化值 0-1000 (ADC_METHOD_OVERSAMPLE 时有效)
+extern vuint16 adc_frame_seq;                         // 归一化数据帧序号 (每完成一次采样+归一化加1)
+
+//-------------------------------------------------------------------------------------------------------------------
+// 数据结构
+//-------------------------------------------------------------------------------------------------------------------
+typedef struct
+{
+    uint16 normalized[CHANNEL_NUMBER];                 // 归一化值 0-50
+    uint16 fine[CHANNEL_NUMBER];                       // 精细归一化值 0-1000
+    uint16 seq;                                        // 帧序号
+    uint32 stamp;                                      // 采样完成时刻 (us，timebase_now_us)
+} adc_frame_t;
 
 //-------------------------------------------------------------------------------------------------------------------
 // 函数声明
 //-------------------------------------------------------------------------------------------------------------------
-void Normalization(void);                              // ADC值归一化处理
+void Normalization(void);                              // ADC值归一化处理 (定点)
+void Normalization_Float(void);                        // ADC值归一化处理 (浮点参考实现)
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     过采样值精细归一化处理
+// 参数说明     void
+// 返回参数     void
+// 使用示例     Normalization_Fine();
+// 备注信息     将 adc_fine_list[] 中的14位过采样值归一化到 0-1000，结果保存在 adc_normalized_fine[]
+//              校准表仍为12位，内部左移 ADC_OVERSAMPLE_BITS 位对齐
+//-------------------------------------------------------------------------------------------------------------------
+void Normalization_Fine(void);
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     更新归一化定点缩放表
+// 参数说明     void
+// 返回参数     void
+// 使用示例     Normalization_Update_Scale();
+// 备注信息     根据 max_min_adc[] 预先计算每通道的 Q24 倒数缩放系数
+//              max_min_adc[] 每次修改后(上电加载、校准完成)都必须调用一次
+//              新的缩放表在下一次 Normalization() / Normalization_Fine() 开始时整体生效 (可在主循环中调用)
+//-------------------------------------------------------------------------------------------------------------------
+void Normalization_Update_Scale(void);
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     ADC采样帧更新 (采样 + 滤波 + 归一化)
+// 参数说明     void
+// 返回参数     void
+// 使用示例     Adc_Frame_Update();
+// 备注信息     在10ms控制中断中、控制算法之前调用，保证控制使用的是本周期的新数据
+//              完成后 adc_frame_seq 加1，控制代码据此区分新旧数据
+//-------------------------------------------------------------------------------------------------------------------
+void Adc_Frame_Update(void);
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     获取ADC采样帧快照
+// 参数说明     frame           输出 最近一次 Adc_Frame_Update() 完成的归一化数据
+// 返回参数     void
+// 使用示例     Adc_Frame_Snapshot(&frame);
+// 备注信息     控制中断以外的上下文读取归一化数据应使用本函数，5个通道来自同一帧
+//-------------------------------------------------------------------------------------------------------------------
+void Adc_Frame_Snapshot(adc_frame_t *frame);
 
 #endif
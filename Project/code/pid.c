@@ -1,64 +1,5 @@
 #include "pid.h"
 
-//===================================================================================================================
-// 轻量级三角函数 (C251编译器不支持math.h)
-//================================================================================================================---
-
-//-------------------------------------------------------------------------------------------------------------------
-// 函数简介     快速正弦函数近似 (泰勒级数)
-// 参数说明     x               弧度值 (建议范围: -PI ~ PI)
-// 返回参数     float           sin(x) 近似值
-// 备注信息     使用5阶泰勒级数: sin(x) ≈ x - x³/6 + x⁵/120
-//              精度: ±0.1% (在-PI~PI范围内)
-//-------------------------------------------------------------------------------------------------------------------
-static float sinf(float x)
-{
-    float x2, x3, x5;
-    float result;
-
-    // 将角度限制在 -PI ~ PI
-    while(x > 3.14159f)
-        x -= 6.28318f;
-    while(x < -3.14159f)
-        x += 6.28318f;
-
-    x2 = x * x;
-    x3 = x2 * x;
-    x5 = x3 * x2;
-
-    // 泰勒级数: sin(x) ≈ x - x³/6 + x⁵/120
-    result = x - x3 * 0.166667f + x5 * 0.008333f;
-
-    return result;
-}
-
-//-------------------------------------------------------------------------------------------------------------------
-// 函数简介     快速余弦函数近似 (泰勒级数)
-// 参数说明     x               弧度值 (建议范围: -PI ~ PI)
-// 返回参数     float           cos(x) 近似值
-// 备注信息     使用4阶泰勒级数: cos(x) ≈ 1 - x²/2 + x⁴/24
-//              精度: ±0.1% (在-PI~PI范围内)
-//-------------------------------------------------------------------------------------------------------------------
-static float cosf(float x)
-{
-    float x2, x4;
-    float result;
-
-    // 将角度限制在 -PI ~ PI
-    while(x > 3.14159f)
-        x -= 6.28318f;
-    while(x < -3.14159f)
-        x += 6.28318f;
-
-    x2 = x * x;
-    x4 = x2 * x2;
-
-    // 泰勒级数: cos(x) ≈ 1 - x²/2 + x⁴/24
-    result = 1.0f - x2 * 0.5f + x4 * 0.041667f;
-
-    return result;
-}
-
 //===================================================================================================================
 // 全局变量定义
 //===================================================================================================================
@@ -66,12 +7,26 @@ pid_param_t pid_motor_left;     // 左电机PID控制器
 pid_param_t pid_motor_right;    // 右电机PID控制器
 pid_param_t pid_SDSD;           // 差比和差PID控制器
 
+// 定点PID全局变量 (速度环)
+pid_fixed_t pid_fixed_left;     // 左电机定点PID控制器
+pid_fixed_t pid_fixed_right;    // 右电机定点PID控制器
+
+// 定点PID参数影子副本: 主循环写入，速度控制中断中 motor_pid_control() 整体应用
+static pid_fixed_t pid_fixed_shadow_left;
+static pid_fixed_t pid_fixed_shadow_right;
+static vuint8 pid_fixed_shadow_ready = 0;  // 1-影子参数已写完，等待中断应用
+
 // PD控制器全局变量
 pd_param_t pd_direction;        // 方向环PD参数
 
 // 四元数姿态控制器全局变量
 quaternion_attitude_t attitude_controller;  // 四元数姿态控制器
 
+// 方向环历史数据 (pd_direction_gyro_loop)
+static float err_position_history[4] = {0};
+static float err_gyro_history[2] = {0};
+static uint8 pd_direction_seed = 1;         // 1-下一次计算用当前误差填充历史数据
+
 //-------------------------------------------------------------------------------------------------------------------
 // 函数简介     PID参数初始化
 // 参数说明     pid             PID结构体指针
@@ -101,6 +56,28 @@ void pid_init(pid_param_t *pid, float kp, float ki, float kd)
     pid->output_min = PID_OUTPUT_MIN;
 }
 
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     PID运行状态复位
+// 参数说明     pid             PID结构体指针
+// 参数说明     actual          当前实际值
+// 返回参数     void
+// 使用示例     pid_reset(&pid_SDSD, SDSD_calculate(&SDSD));
+// 备注信息     清除积分和输出，系数、目标值和限幅不变
+//              历史误差填为当前误差，复位后第一次计算没有微分冲击
+//-------------------------------------------------------------------------------------------------------------------
+void pid_reset(pid_param_t *pid, float actual)
+{
+    pid->actual = actual;
+    pid->error = pid->target - actual;
+    pid->last_error = pid->error;
+    pid->prev_error = pid->error;
+    pid->out_p = 0;
+    pid->out_i = 0;
+    pid->out_d = 0;
+    pid->out = 0;
+    pid->integrator = 0;
+}
+
 //-------------------------------------------------------------------------------------------------------------------
 // 函数简介     设置PID参数
 // 参数说明     pid             PID结构体指针
@@ -189,6 +166,299 @@ float pid_calc_increment(pid_param_t *pid, float actual)
     return pid->out;
 }
 
+//===================================================================================================================
+// 定点PID实现 - Q16.16 (速度环)
+// 加减乘全部饱和，溢出时停在 Q16_MAX/Q16_MIN 而不是回绕变号
+//===================================================================================================================
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     浮点数转Q16.16
+// 参数说明     x               浮点数
+// 返回参数     q16_t           Q16.16定点数
+// 使用示例     q16_t kp = q16_from_float(1.7f);
+// 备注信息     四舍五入，超出 -32768 ~ 32767.99998 时饱和
+//              使用浮点运算，只在主循环中调用 (参数同步)
+//-------------------------------------------------------------------------------------------------------------------
+q16_t q16_from_float(float x)
+{
+    if(x >= 32767.0f)
+    {
+        return Q16_MAX;
+    }
+    if(x <= -32768.0f)
+    {
+        return Q16_MIN;
+    }
+    x *= 65536.0f;
+    return (q16_t)((x >= 0.0f) ? (x + 0.5f) : (x - 0.5f));
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     Q16.16转浮点数
+// 参数说明     x               Q16.16定点数
+// 返回参数     float           浮点数
+// 使用示例     printf("%.3f", q16_to_float(pid_fixed_left.out));
+//-------------------------------------------------------------------------------------------------------------------
+float q16_to_float(q16_t x)
+{
+    return (float)x * (1.0f / 65536.0f);
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     Q16.16转整数
+// 参数说明     x               Q16.16定点数
+// 返回参数     int16           整数部分
+// 使用示例     pwm = q16_to_int(pid_fixed_left.out);
+// 备注信息     向零取整，与浮点数强制转换为整数的结果一致
+//-------------------------------------------------------------------------------------------------------------------
+int16 q16_to_int(q16_t x)
+{
+    if(x < 0)
+    {
+        return (int16)(-(int32)(((uint32)0 - (uint32)x) >> 16));
+    }
+    return (int16)(x >> 16);
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     Q16.16饱和加法
+// 参数说明     a               加数
+// 参数说明     b               加数
+// 返回参数     q16_t           a + b (溢出时饱和)
+// 使用示例     sum = q16_add(a, b);
+// 备注信息     按无符号数相加避免有符号溢出，同号相加结果变号即为溢出
+//-------------------------------------------------------------------------------------------------------------------
+q16_t q16_add(q16_t a, q16_t b)
+{
+    q16_t sum;
+
+    sum = (q16_t)((uint32)a + (uint32)b);
+    if(a >= 0 && b >= 0 && sum < 0)
+    {
+        return Q16_MAX;
+    }
+    if(a < 0 && b < 0 && sum >= 0)
+    {
+        return Q16_MIN;
+    }
+    return sum;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     Q16.16饱和减法
+// 参数说明     a               被减数
+// 参数说明     b               减数
+// 返回参数     q16_t           a - b (溢出时饱和)
+// 使用示例     err = q16_sub(target, actual);
+// 备注信息     异号相减结果符号与被减数不同即为溢出
+//-------------------------------------------------------------------------------------------------------------------
+q16_t q16_sub(q16_t a, q16_t b)
+{
+    q16_t diff;
+
+    diff = (q16_t)((uint32)a - (uint32)b);
+    if(a >= 0 && b < 0 && diff < 0)
+    {
+        return Q16_MAX;
+    }
+    if(a < 0 && b >= 0 && diff >= 0)
+    {
+        return Q16_MIN;
+    }
+    return diff;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     Q16.16饱和乘法
+// 参数说明     a               乘数
+// 参数说明     b               乘数
+// 返回参数     q16_t           a * b (向零取整，溢出时饱和)
+// 使用示例     out_p = q16_mul(kp, error);
+// 备注信息     C251 没有64位整数，把绝对值拆成16位高低两半做4次16x16乘法:
+//              |a|*|b| >> 16 = (ah*bh << 16) + ah*bl + al*bh + (al*bl >> 16)
+//              每个部分积都不超过32位，逐项累加时检查进位
+//-------------------------------------------------------------------------------------------------------------------
+q16_t q16_mul(q16_t a, q16_t b)
+{
+    uint8 negative;
+    uint32 ua, ub;
+    uint32 ah, al, bh, bl;
+    uint32 part;
+    uint32 result;
+    uint32 limit;
+
+    negative = 0;
+    ua = (uint32)a;
+    ub = (uint32)b;
+    if(a < 0)
+    {
+        ua = (uint32)0 - ua;
+        negative = 1;
+    }
+    if(b < 0)
+    {
+        ub = (uint32)0 - ub;
+        negative ^= 1;
+    }
+    limit = negative ? 0x80000000UL : 0x7FFFFFFFUL;
+
+    ah = ua >> 16;
+    al = ua & 0xFFFF;
+    bh = ub >> 16;
+    bl = ub & 0xFFFF;
+
+    // 整数部分相乘，超过15位时结果必然溢出
+    part = ah * bh;
+    if(part > 0x7FFF)
+    {
+        return negative ? Q16_MIN : Q16_MAX;
+    }
+    result = part << 16;
+
+    part = ah * bl;
+    result += part;
+    if(result < part)
+    {
+        return negative ? Q16_MIN : Q16_MAX;
+    }
+
+    part = al * bh;
+    result += part;
+    if(result < part)
+    {
+        return negative ? Q16_MIN : Q16_MAX;
+    }
+
+    part = (al * bl) >> 16;
+    result += part;
+    if(result < part || result > limit)
+    {
+        return negative ? Q16_MIN : Q16_MAX;
+    }
+
+    return negative ? (q16_t)((uint32)0 - result) : (q16_t)result;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     Q16.16限幅函数
+// 参数说明     value           待限幅值
+// 参数说明     min_val         最小值
+// 参数说明     max_val         最大值
+// 返回参数     q16_t           限幅后的值
+//-------------------------------------------------------------------------------------------------------------------
+q16_t q16_constrain(q16_t value, q16_t min_val, q16_t max_val)
+{
+    if(value <= min_val)
+        return min_val;
+    else if(value >= max_val)
+        return max_val;
+    else
+        return value;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     从浮点PID同步参数到定点PID
+// 参数说明     fx              定点PID结构体指针
+// 参数说明     pid             浮点PID结构体指针 (参数来源)
+// 返回参数     void
+// 使用示例     pid_fixed_sync(&pid_fixed_left, &pid_motor_left);
+// 备注信息     复制 kp/ki/kd、目标值和限幅，误差、积分和输出等运行状态保持不变，调参时输出不跳变
+//-------------------------------------------------------------------------------------------------------------------
+void pid_fixed_sync(pid_fixed_t *fx, const pid_param_t *pid)
+{
+    fx->kp = q16_from_float(pid->kp);
+    fx->ki = q16_from_float(pid->ki);
+    fx->kd = q16_from_float(pid->kd);
+    fx->target = q16_from_float(pid->target);
+    fx->integral_max = q16_from_float(pid->integral_max);
+    fx->output_max = q16_from_float(pid->output_max);
+    fx->output_min = q16_from_float(pid->output_min);
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     同步左右电机的定点PID
+// 参数说明     void
+// 返回参数     void
+// 使用示例     pid_fixed_sync_motor();
+// 备注信息     上电加载参数、设置目标速度以及菜单修改参数后在主循环中调用
+//              参数先写入影子副本，下一次 motor_pid_control() (速度控制中断) 开始时一起应用，
+//              中断不会用到只写了一半的32位系数，也不会左右电机用两组不同的参数
+//-------------------------------------------------------------------------------------------------------------------
+void pid_fixed_sync_motor(void)
+{
+    // 先清标志再写副本: 写副本期间进入的中断不会应用
+    pid_fixed_shadow_ready = 0;
+    pid_fixed_sync(&pid_fixed_shadow_left, &pid_motor_left);
+    pid_fixed_sync(&pid_fixed_shadow_right, &pid_motor_right);
+    pid_fixed_shadow_ready = 1;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     应用定点PID参数影子副本
+// 参数说明     fx              定点PID结构体指针
+// 参数说明     shadow          影子副本 (只使用系数、目标值和限幅)
+// 返回参数     void
+// 备注信息     在速度控制中断中调用，运行状态保持不变
+//-------------------------------------------------------------------------------------------------------------------
+static void pid_fixed_apply(pid_fixed_t *fx, const pid_fixed_t *shadow)
+{
+    fx->kp = shadow->kp;
+    fx->ki = shadow->ki;
+    fx->kd = shadow->kd;
+    fx->target = shadow->target;
+    fx->integral_max = shadow->integral_max;
+    fx->output_max = shadow->output_max;
+    fx->output_min = shadow->output_min;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     定点位置式PID计算
+// 参数说明     fx              定点PID结构体指针
+// 参数说明     actual          当前实际值 (Q16.16)
+// 返回参数     q16_t           PID输出值 (Q16.16)
+// 备注信息     与 pid_calc_position() 计算步骤相同
+//-------------------------------------------------------------------------------------------------------------------
+q16_t pid_fixed_calc_position(pid_fixed_t *fx, q16_t actual)
+{
+    fx->actual = actual;
+    fx->error = q16_sub(fx->target, actual);
+    fx->integrator = q16_add(fx->integrator, fx->error);
+    fx->integrator = q16_constrain(fx->integrator, -fx->integral_max, fx->integral_max);
+    fx->out_p = q16_mul(fx->kp, fx->error);
+    fx->out_i = q16_mul(fx->ki, fx->integrator);
+    fx->out_d = q16_mul(fx->kd, q16_sub(fx->error, fx->last_error));
+    fx->last_error = fx->error;
+    fx->out = q16_add(q16_add(fx->out_p, fx->out_i), fx->out_d);
+    fx->out = q16_constrain(fx->out, fx->output_min, fx->output_max);
+    return fx->out;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     定点增量式PID计算
+// 参数说明     fx              定点PID结构体指针
+// 参数说明     actual          当前实际值 (Q16.16)
+// 返回参数     q16_t           PID输出值 (Q16.16)
+// 备注信息     与 pid_calc_increment() 计算步骤相同
+//              二阶差分 error - 2*last_error + prev_error 写成 (error - last_error) - (last_error - prev_error)
+//-------------------------------------------------------------------------------------------------------------------
+q16_t pid_fixed_calc_increment(pid_fixed_t *fx, q16_t actual)
+{
+    q16_t increment;
+
+    fx->actual = actual;
+    fx->error = q16_sub(fx->target, actual);
+    fx->out_p = q16_mul(fx->kp, q16_sub(fx->error, fx->last_error));
+    fx->out_i = q16_mul(fx->ki, fx->error);
+    fx->out_d = q16_mul(fx->kd, q16_sub(q16_sub(fx->error, fx->last_error),
+                                        q16_sub(fx->last_error, fx->prev_error)));
+    increment = q16_add(q16_add(fx->out_p, fx->out_i), fx->out_d);
+    fx->prev_error = fx->last_error;
+    fx->last_error = fx->error;
+    fx->out = q16_add(fx->out, increment);
+    fx->out = q16_constrain(fx->out, fx->output_min, fx->output_max);
+    return fx->out;
+}
+
 //-------------------------------------------------------------------------------------------------------------------
 // 函数简介     电机PID控制函数
 // 参数说明     encoder_left    左编码器值（已叠加差速修正）
@@ -196,18 +466,35 @@ float pid_calc_increment(pid_param_t *pid, float actual)
 // 返回参数     void
 // 使用示例     motor_pid_control(encoder_left, encoder_right);
 // 备注信息     双电机速度环闭环控制，使用增量式PID
-//              注意：差速修正在 motor_control_task() 中完成，此函数仅处理速度环
+//              PID_USE_FIXED 为1时使用Q16.16定点PID，pid_fixed_sync_motor() 同步的参数在计算之前应用
+//              注意：差速修正在 direction_control_task() 中计算、speed_control_task() 中叠加，此函数仅处理速度环
 //-------------------------------------------------------------------------------------------------------------------
 void motor_pid_control(int16 encoder_left, int16 encoder_right)
 {
+#if(PID_USE_FIXED)
+    int16 output_left;
+    int16 output_right;
+#else
     float output_left;
     float output_right;
+#endif
     uint8 pwm_left;
     uint8 pwm_right;
 
     // 增量式PID速度环计算
+#if(PID_USE_FIXED)
+    if(pid_fixed_shadow_ready)
+    {
+        pid_fixed_apply(&pid_fixed_left, &pid_fixed_shadow_left);
+        pid_fixed_apply(&pid_fixed_right, &pid_fixed_shadow_right);
+        pid_fixed_shadow_ready = 0;
+    }
+    output_left = q16_to_int(pid_fixed_calc_increment(&pid_fixed_left, Q16_FROM_INT(encoder_left)));
+    output_right = q16_to_int(pid_fixed_calc_increment(&pid_fixed_right, Q16_FROM_INT(encoder_right)));
+#else
     output_left = pid_calc_increment(&pid_motor_left, encoder_left);
     output_right = pid_calc_increment(&pid_motor_right, encoder_right);
+#endif
 
     // 左电机PWM输出（带方向控制）
     if(output_left >= 0)
@@ -256,11 +543,25 @@ void pd_init(pd_param_t *pd, float kp, float kd, float kp_gyro, float kd_gyro)
     pd->kd_gyro = kd_gyro;
 }
 
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     PD方向环+角速度环历史数据复位
+// 参数说明     void
+// 返回参数     void
+// 使用示例     pd_direction_reset();
+// 备注信息     切换到方向环控制模式时调用，下一次 pd_direction_gyro_loop() 用当前误差填充历史数据
+//              两级微分项从0开始，不会因为旧的历史数据产生冲击
+//-------------------------------------------------------------------------------------------------------------------
+void pd_direction_reset(void)
+{
+    pd_direction_seed = 1;
+}
+
 //-------------------------------------------------------------------------------------------------------------------
 // 函数简介     PD方向环+角速度环组合控制 (推荐用于循迹) - 四元数实现版本
 // 参数说明     err_position    位置误差(ADC归一化值-中心值)
+// 参数说明     imu_data        IMU快照，四元数与角速度来自同一次姿态更新
 // 返回参数     float           电机差速修正值
-// 使用示例     float correction = pd_direction_gyro_loop(adc_error);
+// 使用示例     float correction = pd_direction_gyro_loop(adc_error, &imu_view);
 // 备注信息     【已升级】使用四元数姿态误差替代传统PD计算
 //              控制流程:
 //              1. 计算四元数姿态误差: q_error = q_target ⊗ q_current^(-1)
@@ -270,10 +571,8 @@ void pd_init(pd_param_t *pd, float kp, float kd, float kp_gyro, float kd_gyro)
 //              5. 角速度误差经PD计算得到电机差速修正值
 //              6. 三环结构提供更精确的姿态控制
 //-------------------------------------------------------------------------------------------------------------------
-float pd_direction_gyro_loop(float err_position)
+float pd_direction_gyro_loop(float err_position, const struct IMUData *imu_data)
 {
-    static float err_position_history[4] = {0};
-    static float err_gyro_history[2] = {0};
     float expect_gyro;
     float err_gyro;
     float correction;
@@ -288,13 +587,18 @@ float pd_direction_gyro_loop(float err_position)
     err_position_history[2] = err_position_history[1];
     err_position_history[1] = err_position_history[0];
     err_position_history[0] = err_position;
+    if(pd_direction_seed)
+    {
+        err_position_history[1] = err_position;
+        err_position_history[2] = err_position;
+    }
 
     // 计算四元数姿态误差
     // 步骤1: 获取当前姿态四元数的共轭
-    qc0 = imu.q0;
-    qc1 = -imu.q1;
-    qc2 = -imu.q2;
-    qc3 = -imu.q3;
+    qc0 = imu_data->q0;
+    qc1 = -imu_data->q1;
+    qc2 = -imu_data->q2;
+    qc3 = -imu_data->q3;
 
     // 步骤2: 计算误差四元数 q_error = q_target ⊗ q_current^(-1)
     quaternion_multiply(attitude_controller.target_q0, attitude_controller.target_q1,
@@ -321,11 +625,12 @@ float pd_direction_gyro_loop(float err_position)
 
     // ========== 第二级：PD角速度环 ==========
     // 角速度误差计算
-    err_gyro = expect_gyro - imu.gyro_z;
+    err_gyro = expect_gyro - imu_data->gyro_z;
 
     // 误差历史更新
-    err_gyro_history[1] = err_gyro_history[0];
+    err_gyro_history[1] = pd_direction_seed ? err_gyro : err_gyro_history[0];
     err_gyro_history[0] = err_gyro;
+    pd_direction_seed = 0;
 
     // PD计算：角速度误差 -> 电机差速修正值
     correction = pd_direction.kp_gyro * err_gyro_history[0] +
@@ -372,12 +677,12 @@ void euler_to_quaternion(float roll, float pitch, float yaw,
     yaw_rad = yaw * DEG_TO_RAD;
 
     // 计算三角函数
-    cos_roll = cosf(roll_rad * 0.5f);
-    sin_roll = sinf(roll_rad * 0.5f);
-    cos_pitch = cosf(pitch_rad * 0.5f);
-    sin_pitch = sinf(pitch_rad * 0.5f);
-    cos_yaw = cosf(yaw_rad * 0.5f);
-    sin_yaw = sinf(yaw_rad * 0.5f);
+    cos_roll = fast_cos(roll_rad * 0.5f);
+    sin_roll = fast_sin(roll_rad * 0.5f);
+    cos_pitch = fast_cos(pitch_rad * 0.5f);
+    sin_pitch = fast_sin(pitch_rad * 0.5f);
+    cos_yaw = fast_cos(yaw_rad * 0.5f);
+    sin_yaw = fast_sin(yaw_rad * 0.5f);
 
     // ZYX旋转顺序的四元数转换
     *q0 = cos_roll * cos_pitch * cos_yaw + sin_roll * sin_pitch * sin_yaw;
@@ -10,6 +10,13 @@
 #define PID_OUTPUT_MIN      (-60)      // PID输出最小值
 #define PID_INTEGRAL_MAX    (400)      // 积分限幅值
 
+#define PID_USE_FIXED       (1)        // 速度环实现: 1-Q16.16定点PID 0-浮点PID
+
+#define Q16_ONE             ((q16_t)0x00010000L)   // Q16.16 的 1.0
+#define Q16_MAX             ((q16_t)0x7FFFFFFFL)   // Q16.16 最大值 (约 32768.0)
+#define Q16_MIN             ((q16_t)(-0x7FFFFFFFL - 1))   // Q16.16 最小值 (-32768.0)
+#define Q16_FROM_INT(x)     ((q16_t)(x) * Q16_ONE)        // 整数转Q16.16 (|x| < 32768)
+
 /*==================================================================================================================*/
 /* =============== 传统 PID 控制器 (速度环) =============== */
 /*==================================================================================================================*/
@@ -44,6 +51,43 @@ extern pid_param_t pid_motor_left;      // 左电机PID控制器
 extern pid_param_t pid_motor_right;     // 右电机PID控制器
 extern pid_param_t pid_SDSD;             // 差比和差PID控制器
 
+/*==================================================================================================================*/
+/* =============== 定点 PID 控制器 (速度环, Q16.16) =============== */
+/*==================================================================================================================*/
+
+// Q16.16 定点数: 高16位整数(含符号)，低16位小数，范围 -32768.0 ~ 32767.99998，分辨率 1/65536
+typedef int32 q16_t;
+
+// 定点PID参数结构体 (字段与 pid_param_t 一一对应)
+// 系数、目标值和限幅由 pid_fixed_sync() 从对应的浮点 pid_param_t 复制，浮点结构体仍是菜单和EEPROM使用的参数
+typedef struct
+{
+    q16_t kp;                   // 比例系数
+    q16_t ki;                   // 积分系数
+    q16_t kd;                   // 微分系数
+
+    q16_t target;               // 目标值
+    q16_t actual;               // 实际值
+    q16_t error;                // 当前误差
+    q16_t last_error;           // 上次误差
+    q16_t prev_error;           // 上上次误差
+
+    q16_t out_p;                // 比例输出
+    q16_t out_i;                // 积分输出
+    q16_t out_d;                // 微分输出
+    q16_t out;                  // PID总输出
+
+    q16_t integrator;           // 积分累计值
+    q16_t integral_max;         // 积分限幅值
+    q16_t output_max;           // 输出最大值
+    q16_t output_min;           // 输出最小值
+
+} pid_fixed_t;
+
+// 外部变量声明
+extern pid_fixed_t pid_fixed_left;      // 左电机定点PID控制器
+extern pid_fixed_t pid_fixed_right;     // 右电机定点PID控制器
+
 /*==================================================================================================================*/
 /* =============== 四元数姿态控制 (替代欧拉角) =============== */
 /*==================================================================================================================*/
@@ -106,6 +150,12 @@ extern pd_param_t pd_direction;          // 方向环PD参数
 //-------------------------------------------------------------------------------------------------------------------
 void pid_init(pid_param_t *pid, float kp, float ki, float kd);
 
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     PID运行状态复位
+// 备注信息     清除积分和输出，历史误差填为当前误差 (切换控制模式时无微分冲击)
+//-------------------------------------------------------------------------------------------------------------------
+void pid_reset(pid_param_t *pid, float actual);
+
 //-------------------------------------------------------------------------------------------------------------------
 // 函数简介     设置PID参数
 //-------------------------------------------------------------------------------------------------------------------
@@ -132,6 +182,59 @@ float constrain_float(float value, float min_val, float max_val);
 //-------------------------------------------------------------------------------------------------------------------
 void motor_pid_control(int16 encoder_left, int16 encoder_right);
 
+/*==================================================================================================================*/
+/* =============== 定点 PID 函数 (速度环, Q16.16) =============== */
+/*==================================================================================================================*/
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     浮点数转Q16.16 (四舍五入，超出范围时饱和)
+//-------------------------------------------------------------------------------------------------------------------
+q16_t q16_from_float(float x);
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     Q16.16转浮点数
+//-------------------------------------------------------------------------------------------------------------------
+float q16_to_float(q16_t x);
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     Q16.16转整数 (向零取整，与浮点数强制转换一致)
+//-------------------------------------------------------------------------------------------------------------------
+int16 q16_to_int(q16_t x);
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     Q16.16饱和加法 / 减法 / 乘法
+//-------------------------------------------------------------------------------------------------------------------
+q16_t q16_add(q16_t a, q16_t b);
+q16_t q16_sub(q16_t a, q16_t b);
+q16_t q16_mul(q16_t a, q16_t b);
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     Q16.16限幅函数
+//-------------------------------------------------------------------------------------------------------------------
+q16_t q16_constrain(q16_t value, q16_t min_val, q16_t max_val);
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     从浮点PID复制系数、目标值和限幅到定点PID (保留误差和输出等运行状态)
+// 备注信息     在主循环中调用，修改浮点PID参数(菜单/EEPROM/目标速度)后调用一次
+//-------------------------------------------------------------------------------------------------------------------
+void pid_fixed_sync(pid_fixed_t *fx, const pid_param_t *pid);
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     同步左右电机的定点PID (pid_motor_left/right -> pid_fixed_left/right)
+// 备注信息     在主循环中调用，参数写入影子副本，下一次 motor_pid_control() 开始时在中断中应用
+//-------------------------------------------------------------------------------------------------------------------
+void pid_fixed_sync_motor(void);
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     定点位置式PID计算
+//-------------------------------------------------------------------------------------------------------------------
+q16_t pid_fixed_calc_position(pid_fixed_t *fx, q16_t actual);
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     定点增量式PID计算
+//-------------------------------------------------------------------------------------------------------------------
+q16_t pid_fixed_calc_increment(pid_fixed_t *fx, q16_t actual);
+
 /*==================================================================================================================*/
 /* =============== 四元数姿态控制函数 (新实现) =============== */
 /*==================================================================================================================*/
@@ -186,7 +289,15 @@ void pd_init(pd_param_t *pd, float kp, float kd, float kp_gyro, float kd_gyro);
 
 //-------------------------------------------------------------------------------------------------------------------
 // 函数简介     PD方向环+角速度环组合控制 (推荐用于循迹)
+// 备注信息     imu_data 为本控制周期开始时取得的IMU快照 (imu_get_snapshot)
 //-------------------------------------------------------------------------------------------------------------------
-float pd_direction_gyro_loop(float err_position);
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     PD方向环+角速度环历史数据复位
+// 备注信息     切换到方向环控制模式时调用，下一次计算用当前误差填充历史数据
+//-------------------------------------------------------------------------------------------------------------------
+void pd_direction_reset(void);
+
+struct IMUData;
+float pd_direction_gyro_loop(float err_position, const struct IMUData *imu_data);
 
 #endif
@@ -0,0 +1,293 @@
+//-------------------------------------------------------------------------------------------------------------------
+// 头文件包含
+//-------------------------------------------------------------------------------------------------------------------
+#include "profiler.h"
+
+#if(PROFILER_ENABLE)
+
+//-------------------------------------------------------------------------------------------------------------------
+// 数据结构
+//-------------------------------------------------------------------------------------------------------------------
+typedef struct
+{
+    profiler_stat_t stat;                 // 统计数据 (只在测量点所在的中断中修改)
+    uint16 start;                         // 本次测量开始时的计数
+    vuint8 seq;                           // 更新计数 (每次测量结束加1，主循环读取时检查)
+    vuint8 reset;                         // 主循环请求清零
+} profiler_slot_t;
+
+//-------------------------------------------------------------------------------------------------------------------
+// 私有变量
+//-------------------------------------------------------------------------------------------------------------------
+static profiler_slot_t profiler_slot[PROFILER_ID_MAX];
+
+// 测量点名称 (与 profiler.h 中的 PROFILER_ID_xxx 顺序一致)
+static char *profiler_name[PROFILER_ID_MAX] =
+{
+    "direction",
+    "speed",
+    "imu",
+};
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     清零一个测量点的统计
+// 参数说明     stat            统计数据
+// 返回参数     void
+// 备注信息     最小值置为 0xFFFF，第一次测量后更新
+//-------------------------------------------------------------------------------------------------------------------
+static void profiler_clear(profiler_stat_t *stat)
+{
+    memset(stat, 0, sizeof(profiler_stat_t));
+    stat->min = 0xFFFF;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     执行时间对应的直方图格
+// 参数说明     us              执行时间 (us)
+// 返回参数     uint8           格序号 (二进制位数，0us 为第0格)
+// 备注信息
+//-------------------------------------------------------------------------------------------------------------------
+static uint8 profiler_bin(uint16 us)
+{
+    uint8 bin;
+
+    bin = 0;
+    while(us != 0)
+    {
+        us >>= 1;
+        bin++;
+    }
+
+    return bin;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     串口发送32位/16位小端数据并累加校验和
+// 参数说明     value           数据
+// 参数说明     bytes           字节数 (2 / 4)
+// 参数说明     sum             校验和
+// 返回参数     void
+// 备注信息
+//-------------------------------------------------------------------------------------------------------------------
+static void profiler_send_le(uint32 value, uint8 bytes, uint8 *sum)
+{
+    uint8 buf[4];
+    uint8 i;
+
+    for(i = 0; i < bytes; i++)
+    {
+        buf[i] = (uint8)(value >> (8 * i));
+        *sum += buf[i];
+    }
+    debug_send_buffer(buf, bytes);
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     执行时间统计初始化
+// 参数说明     void
+// 返回参数     void
+// 使用示例     PROFILER_INIT();
+// 备注信息     清零所有统计，计时使用 timebase (在 timebase_init() 之后调用)
+//-------------------------------------------------------------------------------------------------------------------
+void profiler_init(void)
+{
+    uint8 i;
+
+    for(i = 0; i < PROFILER_ID_MAX; i++)
+    {
+        profiler_clear(&profiler_slot[i].stat);
+        profiler_slot[i].seq = 0;
+        profiler_slot[i].reset = 0;
+    }
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     测量开始
+// 参数说明     id              测量点编号 PROFILER_ID_xxx
+// 返回参数     void
+// 使用示例     PROFILER_BEGIN(PROFILER_ID_SPEED);
+// 备注信息     在被测代码入口调用，同一个测量点不能嵌套
+//-------------------------------------------------------------------------------------------------------------------
+void profiler_begin(uint8 id)
+{
+    profiler_slot[id].start = timebase_now_us16();
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     测量结束
+// 参数说明     id              测量点编号 PROFILER_ID_xxx
+// 返回参数     void
+// 使用示例     PROFILER_END(PROFILER_ID_SPEED);
+// 备注信息     在被测代码出口调用，更新该测量点的统计
+//-------------------------------------------------------------------------------------------------------------------
+void profiler_end(uint8 id)
+{
+    profiler_slot_t *slot;
+    uint16 us;
+    uint8 bin;
+
+    us = timebase_now_us16();
+    slot = &profiler_slot[id];
+    us -= slot->start;
+
+    if(slot->reset)
+    {
+        slot->reset = 0;
+        profiler_clear(&slot->stat);
+    }
+
+    slot->stat.count++;
+    slot->stat.sum += us;
+    if(us < slot->stat.min)
+    {
+        slot->stat.min = us;
+    }
+    if(us > slot->stat.max)
+    {
+        slot->stat.max = us;
+    }
+    bin = profiler_bin(us);
+    if(slot->stat.hist[bin] != 0xFFFF)
+    {
+        slot->stat.hist[bin]++;
+    }
+
+    slot->seq++;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     读取一个测量点的统计
+// 参数说明     id              测量点编号 PROFILER_ID_xxx
+// 参数说明     out             输出 统计数据
+// 返回参数     void
+// 使用示例     profiler_get_stat(PROFILER_ID_SPEED, &stat);
+// 备注信息     在主循环中调用，复制期间统计被更新时重读
+//-------------------------------------------------------------------------------------------------------------------
+void profiler_get_stat(uint8 id, profiler_stat_t *out)
+{
+    uint8 seq;
+
+    do
+    {
+        seq = profiler_slot[id].seq;
+        memcpy(out, &profiler_slot[id].stat, sizeof(profiler_stat_t));
+    }while(seq != profiler_slot[id].seq);
+
+    if(out->count == 0)
+    {
+        out->min = 0;
+    }
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     清零所有统计
+// 参数说明     void
+// 返回参数     void
+// 使用示例     profiler_reset();
+// 备注信息     在主循环中调用，各测量点在下一次测量结束时清零 (统计只由测量点所在的中断修改)
+//-------------------------------------------------------------------------------------------------------------------
+void profiler_reset(void)
+{
+    uint8 i;
+
+    for(i = 0; i < PROFILER_ID_MAX; i++)
+    {
+        profiler_slot[i].reset = 1;
+    }
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     通过调试串口输出统计报告
+// 参数说明     format          PROFILER_FORMAT_TEXT / PROFILER_FORMAT_BINARY
+// 返回参数     void
+// 使用示例     profiler_report(PROFILER_FORMAT_TEXT);
+// 备注信息     在主循环中调用，文本报告每个测量点两行 (统计和直方图)
+//              测量点清零请求还没有生效时报告的是清零前的统计
+//-------------------------------------------------------------------------------------------------------------------
+void profiler_report(uint8 format)
+{
+    profiler_stat_t stat;
+    uint16 mean;
+    uint8 header[3];
+    uint8 sum;
+    uint8 i;
+    uint8 k;
+
+    sum = 0;
+    if(format == PROFILER_FORMAT_BINARY)
+    {
+        header[0] = 0xA5;
+        header[1] = 0x5A;
+        header[2] = PROFILER_ID_MAX;
+        sum = header[0] + header[1] + header[2];
+        debug_send_buffer(header, 3);
+    }
+
+    for(i = 0; i < PROFILER_ID_MAX; i++)
+    {
+        profiler_get_stat(i, &stat);
+        mean = (stat.count != 0) ? (uint16)(stat.sum / stat.count) : 0;
+
+        if(format == PROFILER_FORMAT_BINARY)
+        {
+            header[0] = i;
+            sum += i;
+            debug_send_buffer(header, 1);
+            profiler_send_le(stat.count, 4, &sum);
+            profiler_send_le(stat.min, 2, &sum);
+            profiler_send_le(stat.max, 2, &sum);
+            profiler_send_le(mean, 2, &sum);
+            for(k = 0; k < PROFILER_HIST_BINS; k++)
+            {
+                profiler_send_le(stat.hist[k], 2, &sum);
+            }
+        }
+        else
+        {
+            printf("PROF %s: n=%lu min=%uus mean=%uus max=%uus\r\n",
+                   profiler_name[i], stat.count, stat.min, mean, stat.max);
+            printf("  hist:");
+            for(k = 0; k < PROFILER_HIST_BINS; k++)
+            {
+                printf(" %u", stat.hist[k]);
+            }
+            printf("\r\n");
+        }
+    }
+
+    if(format == PROFILER_FORMAT_BINARY)
+    {
+        debug_send_buffer(&sum, 1);
+    }
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     处理调试串口命令
+// 参数说明     void
+// 返回参数     void
+// 使用示例     PROFILER_SERVICE();
+// 备注信息     在主循环中调用，读取调试串口接收缓冲中的命令 'p' / 'b' / 'r'，其他字符忽略
+//-------------------------------------------------------------------------------------------------------------------
+void profiler_service(void)
+{
+    uint8 cmd;
+
+    while(debug_read_buffer(&cmd, 1) != 0)
+    {
+        if(cmd == 'p')
+        {
+            profiler_report(PROFILER_FORMAT_TEXT);
+        }
+        else if(cmd == 'b')
+        {
+            profiler_report(PROFILER_FORMAT_BINARY);
+        }
+        else if(cmd == 'r')
+        {
+            profiler_reset();
+            printf("PROF reset\r\n");
+        }
+    }
+}
+
+#endif
@@ -0,0 +1,138 @@
+#ifndef _PROFILER_H_
+#define _PROFILER_H_
+
+//-------------------------------------------------------------------------------------------------------------------
+// 头文件包含
+//-------------------------------------------------------------------------------------------------------------------
+#include "zf_common_headfile.h"
+
+//-------------------------------------------------------------------------------------------------------------------
+// 说明
+//-------------------------------------------------------------------------------------------------------------------
+// 任务执行时间统计: 在被测代码入口和出口读取 timebase 计数 (1MHz，低16位)
+//   每个测量点统计次数、最小/最大/平均执行时间和 log2 直方图 (第k格为 [2^(k-1), 2^k) us，第0格为 0us)
+//   测量范围 0 ~ 65535us，超过 65.5ms 的执行时间会回绕 (控制任务远小于该值)
+// 统计在被测代码所在的中断中更新，主循环读取时用更新计数检查一致性，不关闭总中断
+// 调试串口发送命令输出统计 (profiler_service 在主循环中处理):
+//   'p' - 文本报告    'b' - 二进制报告    'r' - 清零统计
+// PROFILER_ENABLE 为0时 PROFILER_* 宏为空，profiler.c 不编译任何代码
+//
+// 二进制报告格式 (小端):
+//   0xA5 0x5A | 测量点数 N | N 个测量点 { id(1) count(4) min(2) max(2) mean(2) hist(2*PROFILER_HIST_BINS) } | 校验和(1)
+//   校验和为前面所有字节之和的低8位
+
+//-------------------------------------------------------------------------------------------------------------------
+// 宏定义
+//-------------------------------------------------------------------------------------------------------------------
+#define PROFILER_ENABLE             (1)         // 1-开启执行时间统计 0-移除 (不占用代码)
+
+// 测量点编号 (PROFILER_BEGIN / PROFILER_END 的参数)，名称在 profiler.c 的 profiler_name 中
+#define PROFILER_ID_DIRECTION       (0)         // direction_control_task()
+#define PROFILER_ID_SPEED           (1)         // speed_control_task()
+#define PROFILER_ID_IMU             (2)         // imu_update_task()
+#define PROFILER_ID_MAX             (3)         // 测量点数
+
+#define PROFILER_HIST_BINS          (17)        // 直方图格数 (0us, 1us, 2~3us, ... 32768~65535us)
+
+#define PROFILER_FORMAT_TEXT        (0)         // profiler_report() 输出格式
+#define PROFILER_FORMAT_BINARY      (1)
+
+//-------------------------------------------------------------------------------------------------------------------
+// 数据结构
+//-------------------------------------------------------------------------------------------------------------------
+typedef struct
+{
+    uint32 count;                         // 测量次数
+    uint32 sum;                           // 执行时间累加 (us)
+    uint16 min;                           // 最小执行时间 (us)
+    uint16 max;                           // 最大执行时间 (us)
+    uint16 hist[PROFILER_HIST_BINS];      // log2 直方图 (到 65535 后不再增加)
+} profiler_stat_t;
+
+//-------------------------------------------------------------------------------------------------------------------
+// 测量宏
+//-------------------------------------------------------------------------------------------------------------------
+#if(PROFILER_ENABLE)
+#define PROFILER_INIT()             profiler_init()
+#define PROFILER_BEGIN(id)          profiler_begin(id)
+#define PROFILER_END(id)            profiler_end(id)
+#define PROFILER_SERVICE()          profiler_service()
+#else
+#define PROFILER_INIT()
+#define PROFILER_BEGIN(id)
+#define PROFILER_END(id)
+#define PROFILER_SERVICE()
+#endif
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数声明 (通过上面的宏调用，PROFILER_ENABLE 为0时没有定义)
+//-------------------------------------------------------------------------------------------------------------------
+#if(PROFILER_ENABLE)
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     执行时间统计初始化
+// 参数说明     void
+// 返回参数     void
+// 使用示例     PROFILER_INIT();
+// 备注信息     清零所有统计，计时使用 timebase (在 timebase_init() 之后调用)
+//-------------------------------------------------------------------------------------------------------------------
+void profiler_init(void);
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     测量开始
+// 参数说明     id              测量点编号 PROFILER_ID_xxx
+// 返回参数     void
+// 使用示例     PROFILER_BEGIN(PROFILER_ID_SPEED);
+// 备注信息     在被测代码入口调用，同一个测量点不能嵌套
+//-------------------------------------------------------------------------------------------------------------------
+void profiler_begin(uint8 id);
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     测量结束
+// 参数说明     id              测量点编号 PROFILER_ID_xxx
+// 返回参数     void
+// 使用示例     PROFILER_END(PROFILER_ID_SPEED);
+// 备注信息     在被测代码出口调用，更新该测量点的统计
+//-------------------------------------------------------------------------------------------------------------------
+void profiler_end(uint8 id);
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     读取一个测量点的统计
+// 参数说明     id              测量点编号 PROFILER_ID_xxx
+// 参数说明     out             输出 统计数据
+// 返回参数     void
+// 使用示例     profiler_get_stat(PROFILER_ID_SPEED, &stat);
+// 备注信息     在主循环中调用，复制期间统计被更新时重读
+//-------------------------------------------------------------------------------------------------------------------
+void profiler_get_stat(uint8 id, profiler_stat_t *out);
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     清零所有统计
+// 参数说明     void
+// 返回参数     void
+// 使用示例     profiler_reset();
+// 备注信息     在主循环中调用，各测量点在下一次测量结束时清零 (统计只由测量点所在的中断修改)
+//-------------------------------------------------------------------------------------------------------------------
+void profiler_reset(void);
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     通过调试串口输出统计报告
+// 参数说明     format          PROFILER_FORMAT_TEXT / PROFILER_FORMAT_BINARY
+// 返回参数     void
+// 使用示例     profiler_report(PROFILER_FORMAT_TEXT);
+// 备注信息     在主循环中调用，文本报告每个测量点两行 (统计和直方图)
+//-------------------------------------------------------------------------------------------------------------------
+void profiler_report(uint8 format);
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     处理调试串口命令
+// 参数说明     void
+// 返回参数     void
+// 使用示例     PROFILER_SERVICE();
+// 备注信息     在主循环中调用，读取调试串口接收缓冲中的命令 'p' / 'b' / 'r'
+//-------------------------------------------------------------------------------------------------------------------
+void profiler_service(void);
+
+#endif
+
+#endif
@@ -7,170 +7,6 @@
 
 #include "quaternion.h"
 
-/*==================================================================================================================*/
-/* =============== 数学基础函数 =============== */
-/*==================================================================================================================*/
-
-/**
- * @brief       快速平方根计算 (牛顿迭代法)
- * @param       x   输入值 (必须 >= 0)
- * @return      平方根值
- * @note        使用牛顿迭代法，迭代20次或达到精度要求
- */
-float my_sqrt(float x)
-{
-    float guess = x;
-    float epsilon = 0.00001f;
-    uint16 i;
-
-    // 牛顿迭代法: guess = 0.5 * (guess + x / guess)
-    for(i = 0; i < 20; i++)
-    {
-        guess = 0.5f * (guess + x / guess);
-        if((guess - x / guess) < epsilon)
-        {
-            break;  // 达到精度要求，提前退出
-        }
-    }
-
-    return guess;
-}
-
-/**
- * @brief       反正弦函数计算 (泰勒级数近似)
- * @param       x   输入值 [-1, 1]
- * @return      弧度值 [-π/2, π/2]
- * @note        使用分段多项式近似，提高精度
- */
-float my_asin(float x)
-{
-    float neg;
-    float result;
-    float temp;
-
-    neg = 0;
-
-    // 输入限幅，防止越界
-    if(x > 1.0f)
-    {
-        x = 1.0f;
-    }
-
-    if(x < -1.0f)
-    {
-        x = -1.0f;
-    }
-
-    // 处理负数情况 (asin(-x) = -asin(x))
-    if(x < 0)
-    {
-        neg = 1;
-        x = -x;
-    }
-
-    // 分段多项式近似计算
-    if(x > 0.7071f)  // > 45度
-    {
-        // π/2 - 0.5 * (1-x) * (1 + (1-x) * (1/6 + (1-x) * 0.075))
-        temp = 1.0f - x;
-        result = 1.57079633f - 0.5f * temp * (1.0f + temp * (0.166666f + temp * 0.075f));
-    }
-    else  // <= 45度
-    {
-        // x * (1 + x² * (1/6 + x² * (0.075 + x² * 0.04464)))
-        temp = x * x;
-        result = x * (1.0f + temp * (0.166666f + temp * (0.075f + temp * 0.04464f)));
-    }
-
-    // 恢复符号
-    if(neg)
-    {
-        result = -result;
-    }
-
-    return result;
-}
-
-/**
- * @brief       反正切函数 (双参数版本)
- * @param       y   Y坐标
- * @param       x   X坐标
- * @return      弧度值 [-π, π]
- * @note        根据象限返回正确的角度
- */
-float my_atan2(float y, float x)
-{
-    float abs_x;
-    float abs_y;
-    float angle;
-    float r;
-
-    // 原点处理
-    if(x == 0.0f && y == 0.0f)
-    {
-        return 0.0f;
-    }
-
-    // 取绝对值
-    if(x >= 0)
-    {
-        abs_x = x;
-    }
-    else
-    {
-        abs_x = -x;
-    }
-
-    if(y >= 0)
-    {
-        abs_y = y;
-    }
-    else
-    {
-        abs_y = -y;
-    }
-
-    // 多项式近似 atan(r)
-    if(abs_y > abs_x)  // |y| > |x|
-    {
-        r = abs_x / abs_y;
-        angle = 1.57079633f - r * (0.1963f + r * -0.9817f);  // π/2 - ...
-    }
-    else  // |x| >= |y|
-    {
-        r = abs_y / abs_x;
-        angle = r * (0.1963f + r * -0.9817f);
-    }
-
-    // 象限修正
-    if(x < 0)  // 第二、三象限
-    {
-        angle = 3.14159265f - angle;  // π - angle
-    }
-
-    if(y < 0)  // 第三、四象限
-    {
-        angle = -angle;
-    }
-
-    return angle;
-}
-
-/**
- * @brief       快速平方根倒数
- * @param       x   输入值 (> 0)
- * @return      1/sqrt(x)
- * @note        用于向量归一化
- */
-float Fast_InvSqrt(float x)
-{
-    if(x <= 0.0f)
-    {
-        return 0.0f;
-    }
-    return 1.0f / my_sqrt(x);
-}
-
 /*==================================================================================================================*/
 /* =============== Mahony 姿态解算算法 =============== */
 /*==================================================================================================================*/
@@ -234,7 +70,7 @@ void Mahony_Update(struct MahonyAHRS_t *ahrs, float gx, float gy, float gz,
     q3 = ahrs->q3;
 
     // ========== 步骤1: 加速度计归一化 ==========
-    norm = Fast_InvSqrt(ax * ax + ay * ay + az * az);
+    norm = fast_inv_sqrt(ax * ax + ay * ay + az * az);
     ax = ax * norm;
     ay = ay * norm;
     az = az * norm;
@@ -272,13 +108,261 @@ void Mahony_Update(struct MahonyAHRS_t *ahrs, float gx, float gy, float gz,
     q3_last = q3 + 0.5f * (q0 * gz + q1 * gy - q2 * gx) * dt;
 
     // ========== 步骤7: 四元数归一化 ==========
-    norm = Fast_InvSqrt(q0_last * q0_last + q1_last * q1_last + q2_last * q2_last + q3_last * q3_last);
+    norm = fast_inv_sqrt(q0_last * q0_last + q1_last * q1_last + q2_last * q2_last + q3_last * q3_last);
     ahrs->q0 = q0_last * norm;
     ahrs->q1 = q1_last * norm;
     ahrs->q2 = q2_last * norm;
     ahrs->q3 = q3_last * norm;
 }
 
+/*==================================================================================================================*/
+/* =============== Mahony 姿态解算算法 (Q30 定点) =============== */
+/*==================================================================================================================*/
+
+// 定点系数 MAHONY_FX_* 在 quaternion.h 中以整数常量给出
+// 陀螺仪系数按整数部分 (Q24) 和低8位两次相乘: 只取 Q24 时比例误差约 1e-5，连续转动10分钟累计约0.7°
+#define MAHONY_FX_GYRO_Q24      (MAHONY_FX_GYRO_Q32 >> 8)
+#define MAHONY_FX_GYRO_FRAC     (MAHONY_FX_GYRO_Q32 & 0xFF)
+
+// 1/sqrt(u) 初值表 (Q30)，u 为 Q28 尾数 [1, 4)，按 1/8 分段取区间中点
+static const int32 inv_sqrt_table[24] =
+{
+    1041682578L, 985333074L, 937238702L, 895562589L, 858993459L, 826566842L,
+    797555404L, 771398898L, 747657839L, 725981977L, 706088274L, 687745184L,
+    670761200L, 654976372L, 640255922L, 626485368L, 613566757L, 601415717L,
+    589959130L, 579133272L, 568882316L, 559157115L, 549914212L, 541115017L,
+};
+
+/**
+ * @brief       Q30 定点乘法
+ * @param       a   乘数 (Q30)
+ * @param       b   乘数 (Q30)
+ * @return      a * b (Q30，向零取整)
+ * @note        C251 没有64位整数，把绝对值拆成16位高低两半做4次16x16乘法:
+ *              |a|*|b| >> 30 = ((ah*bh) << 2) + ((ah*bl + al*bh + (al*bl >> 16)) >> 14)
+ *              输入绝对值小于 2^31 时中间和不超过32位
+ *              也可用于其他 Q 格式: Qm * Qn 的结果为 Q(m+n-30)
+ */
+int32 q30_mul(int32 a, int32 b)
+{
+    uint8 negative;
+    uint32 ua, ub;
+    uint32 ah, al, bh, bl;
+    uint32 mid;
+    uint32 result;
+
+    negative = 0;
+    ua = (uint32)a;
+    ub = (uint32)b;
+    if(a < 0)
+    {
+        ua = (uint32)0 - ua;
+        negative = 1;
+    }
+    if(b < 0)
+    {
+        ub = (uint32)0 - ub;
+        negative ^= 1;
+    }
+
+    ah = ua >> 16;
+    al = ua & 0xFFFF;
+    bh = ub >> 16;
+    bl = ub & 0xFFFF;
+
+    mid = ah * bl + al * bh + ((al * bl) >> 16);
+    result = ((ah * bh) << 2) + (mid >> 14);
+
+    return negative ? -(int32)result : (int32)result;
+}
+
+/**
+ * @brief       定点平方根倒数
+ * @param       n   输入值 (> 0)
+ * @param       k   输出 指数
+ * @return      尾数的平方根倒数 (Q30)，1/sqrt(n) = 返回值 * 2^k / 2^44
+ * @note        n 按4的幂移位到 Q28 尾数 u ∈ [1, 4)，查表得初值 (误差 < 3%)，
+ *              再做两次牛顿迭代 y = y * (1.5 - 0.5 * u * y²)，相对误差小于 3e-6
+ */
+static int32 fx_inv_sqrt(uint32 n, int8 *k)
+{
+    uint32 u;
+    int32 y;
+    int32 t;
+    uint8 i;
+
+    u = n;
+    *k = 0;
+    while(u >= 0x40000000UL)
+    {
+        u >>= 2;
+        (*k)--;
+    }
+    while(u < 0x10000000UL)
+    {
+        u <<= 2;
+        (*k)++;
+    }
+
+    y = inv_sqrt_table[(u >> 25) - 8];
+    for(i = 0; i < 2; i++)
+    {
+        t = q30_mul(y, y);
+        t = q30_mul((int32)u, t) * 4;                           // u * y² (Q30)
+        y = q30_mul(y, 1610612736L - t / 2);                    // 1.5 - 0.5 * u * y²
+    }
+
+    return y;
+}
+
+/**
+ * @brief       定点 Mahony AHRS 算法初始化
+ * @param       ahrs    定点Mahony算法结构体指针
+ * @note        初始化四元数为单位姿态 (无旋转)
+ */
+void Mahony_Fixed_Init(struct MahonyAHRS_Fixed_t *ahrs)
+{
+    ahrs->q0 = Q30_ONE;
+    ahrs->q1 = 0;
+    ahrs->q2 = 0;
+    ahrs->q3 = 0;
+
+    ahrs->integralFBx = 0;
+    ahrs->integralFBy = 0;
+    ahrs->integralFBz = 0;
+
+    ahrs->inited = 1;
+}
+
+/**
+ * @brief       定点 Mahony AHRS 算法更新
+ * @param       ahrs    定点Mahony算法结构体指针
+ * @param       gx      陀螺仪X轴原始值 (MAHONY_GYRO_LSB 计数每 °/s)
+ * @param       gy      陀螺仪Y轴原始值
+ * @param       gz      陀螺仪Z轴原始值
+ * @param       ax      加速度计X轴原始值 (只用方向，与量程无关)
+ * @param       ay      加速度计Y轴原始值
+ * @param       az      加速度计Z轴原始值
+ * @param       dt_us   采样时间间隔 (us, 不超过62000)
+ * @note        计算步骤与 Mahony_Update() 相同，全部使用整数运算:
+ *              四元数/单位向量/误差 Q30，角速度 Q24 rad/s，dt/2 Q36，
+ *              半角增量 ω*dt/2 = q30_mul(Q24, Q36) 直接得到 Q30
+ *              加速度全为0时不做加速度修正
+ */
+void Mahony_Fixed_Update(struct MahonyAHRS_Fixed_t *ahrs, int16 gx, int16 gy, int16 gz,
+                         int16 ax, int16 ay, int16 az, uint32 dt_us)
+{
+    int32 q0, q1, q2, q3;
+    int32 ux, uy, uz;
+    int32 vx, vy, vz;
+    int32 ex, ey, ez;
+    int32 wx, wy, wz;
+    int32 hx, hy, hz;
+    int32 half_dt;
+    int32 dt;
+    int32 ki_dt;
+    int32 s0, s1, s2, s3;
+    uint32 n;
+    int32 y;
+    int32 scale;
+    int8 k;
+
+    q0 = ahrs->q0;
+    q1 = ahrs->q1;
+    q2 = ahrs->q2;
+    q3 = ahrs->q3;
+
+    half_dt = (int32)dt_us * MAHONY_FX_HALF_DT_PER_US + (int32)dt_us * MAHONY_FX_HALF_DT_FRAC / 1000;   // dt/2 (Q36)
+    dt = half_dt / 32;                                          // dt (Q30)
+
+    // ========== 步骤1: 加速度计归一化 ==========
+    n = (uint32)((int32)ax * ax) + (uint32)((int32)ay * ay) + (uint32)((int32)az * az);
+    ex = 0;
+    ey = 0;
+    ez = 0;
+    if(n != 0)
+    {
+        // a * 2^(k+16) 不超过31位，乘以尾数平方根倒数后为 Q30 单位向量
+        y = fx_inv_sqrt(n, &k);
+        scale = (int32)1 << (k + 16);
+        ux = q30_mul((int32)ax * scale, y);
+        uy = q30_mul((int32)ay * scale, y);
+        uz = q30_mul((int32)az * scale, y);
+
+        // ========== 步骤2: 计算重力加速度参考向量 ==========
+        vx = 2 * (q30_mul(q1, q3) - q30_mul(q0, q2));
+        vy = 2 * (q30_mul(q0, q1) + q30_mul(q2, q3));
+        vz = q30_mul(q0, q0) - q30_mul(q1, q1) - q30_mul(q2, q2) + q30_mul(q3, q3);
+
+        // ========== 步骤3: 计算方向误差 (叉积) ==========
+        ex = q30_mul(uy, vz) - q30_mul(uz, vy);
+        ey = q30_mul(uz, vx) - q30_mul(ux, vz);
+        ez = q30_mul(ux, vy) - q30_mul(uy, vx);
+    }
+
+    // ========== 步骤4: 积分误差累积 (Q30 rad/s) ==========
+    ki_dt = q30_mul(MAHONY_FX_KI_Q30, dt);
+    ahrs->integralFBx += q30_mul(ki_dt, ex);
+    ahrs->integralFBy += q30_mul(ki_dt, ey);
+    ahrs->integralFBz += q30_mul(ki_dt, ez);
+
+    // ========== 步骤5: 修正角速度 (Q24 rad/s) ==========
+    wx = (int32)gx * MAHONY_FX_GYRO_Q24 + (int32)gx * MAHONY_FX_GYRO_FRAC / 256;
+    wy = (int32)gy * MAHONY_FX_GYRO_Q24 + (int32)gy * MAHONY_FX_GYRO_FRAC / 256;
+    wz = (int32)gz * MAHONY_FX_GYRO_Q24 + (int32)gz * MAHONY_FX_GYRO_FRAC / 256;
+    wx += q30_mul(MAHONY_FX_KP_Q24, ex) + ahrs->integralFBx / 64;
+    wy += q30_mul(MAHONY_FX_KP_Q24, ey) + ahrs->integralFBy / 64;
+    wz += q30_mul(MAHONY_FX_KP_Q24, ez) + ahrs->integralFBz / 64;
+
+    // ========== 步骤6: 四元数微分方程更新 ==========
+    hx = q30_mul(wx, half_dt);                                  // ω*dt/2 (Q30)
+    hy = q30_mul(wy, half_dt);
+    hz = q30_mul(wz, half_dt);
+    s0 = q0 - (q30_mul(q1, hx) + q30_mul(q2, hy) + q30_mul(q3, hz));
+    s1 = q1 + (q30_mul(q0, hx) + q30_mul(q2, hz) - q30_mul(q3, hy));
+    s2 = q2 + (q30_mul(q0, hy) - q30_mul(q1, hz) + q30_mul(q3, hx));
+    s3 = q3 + (q30_mul(q0, hz) + q30_mul(q1, hy) - q30_mul(q2, hx));
+
+    // ========== 步骤7: 四元数归一化 ==========
+    // 模长平方约为 1.0 (Q30 约 2^30)，1/|q| = 尾数平方根倒数 * 2^(k+1)
+    n = (uint32)(q30_mul(s0, s0) + q30_mul(s1, s1) + q30_mul(s2, s2) + q30_mul(s3, s3));
+    if(n == 0)
+    {
+        Mahony_Fixed_Init(ahrs);
+        return;
+    }
+    y = fx_inv_sqrt(n, &k);
+    if(k + 1 >= 0)
+    {
+        y = y * ((int32)1 << (k + 1));
+        ahrs->q0 = q30_mul(s0, y);
+        ahrs->q1 = q30_mul(s1, y);
+        ahrs->q2 = q30_mul(s2, y);
+        ahrs->q3 = q30_mul(s3, y);
+    }
+    else
+    {
+        ahrs->q0 = q30_mul(s0, y) >> (-(k + 1));
+        ahrs->q1 = q30_mul(s1, y) >> (-(k + 1));
+        ahrs->q2 = q30_mul(s2, y) >> (-(k + 1));
+        ahrs->q3 = q30_mul(s3, y) >> (-(k + 1));
+    }
+}
+
+/**
+ * @brief       定点四元数转换到浮点 Mahony 结构体
+ * @param       fixed   定点Mahony算法结构体指针
+ * @param       ahrs    浮点Mahony算法结构体指针 (只写四元数)
+ * @note        转换后可继续使用 Mahony_GetEuler() 计算欧拉角
+ */
+void Mahony_Fixed_ToFloat(struct MahonyAHRS_Fixed_t *fixed, struct MahonyAHRS_t *ahrs)
+{
+    ahrs->q0 = (float)fixed->q0 * (1.0f / 1073741824.0f);
+    ahrs->q1 = (float)fixed->q1 * (1.0f / 1073741824.0f);
+    ahrs->q2 = (float)fixed->q2 * (1.0f / 1073741824.0f);
+    ahrs->q3 = (float)fixed->q3 * (1.0f / 1073741824.0f);
+}
+
 /*==================================================================================================================*/
 /* =============== 四元数与欧拉角转换 =============== */
 /*==================================================================================================================*/
@@ -309,7 +393,7 @@ void Quaternion_ToEuler(struct Quaternion_t *quat, struct EulerAngle_t *euler)
 
     // ========== Roll (横滚角) ==========
     // roll = atan2(2(q0q1 + q2q3), 1 - 2(q1² + q2²))
-    euler->roll = my_atan2(2.0f * (q0 * q1 + q2 * q3), 1.0f - 2.0f * (q1 * q1 + q2 * q2));
+    euler->roll = fast_atan2_table(2.0f * (q0 * q1 + q2 * q3), 1.0f - 2.0f * (q1 * q1 + q2 * q2));
 
     // ========== Pitch (俯仰角) ==========
     // pitch = asin(2(q0q2 - q3q1))
@@ -322,11 +406,11 @@ void Quaternion_ToEuler(struct Quaternion_t *quat, struct EulerAngle_t *euler)
     {
         pitch_arg = -1.0f;
     }
-    euler->pitch = my_asin(pitch_arg);
+    euler->pitch = fast_asin(pitch_arg);
 
     // ========== Yaw (偏航角) ==========
     // yaw = atan2(2(q0q3 + q1q2), 1 - 2(q2² + q3²))
-    euler->yaw = my_atan2(2.0f * (q0 * q3 + q1 * q2), 1.0f - 2.0f * (q2 * q2 + q3 * q3));
+    euler->yaw = fast_atan2_table(2.0f * (q0 * q3 + q1 * q2), 1.0f - 2.0f * (q2 * q2 + q3 * q3));
 
     // 弧度转角度
     euler->roll = euler->roll * RAD_TO_DEG;
@@ -334,6 +418,28 @@ void Quaternion_ToEuler(struct Quaternion_t *quat, struct EulerAngle_t *euler)
     euler->yaw = euler->yaw * RAD_TO_DEG;
 }
 
+/**
+ * @brief       四元数转偏航角
+ * @param       quat    四元数结构体指针
+ * @return      偏航角 (度)
+ * @note        与 Quaternion_ToEuler() 的 yaw 相同，只需要航向时省去 roll 的 atan2 和 pitch 的 asin
+ */
+float Quaternion_ToYaw(struct Quaternion_t *quat)
+{
+    float q0;
+    float q1;
+    float q2;
+    float q3;
+
+    q0 = quat->q0;
+    q1 = quat->q1;
+    q2 = quat->q2;
+    q3 = quat->q3;
+
+    // yaw = atan2(2(q0q3 + q1q2), 1 - 2(q2² + q3²))
+    return fast_atan2_table(2.0f * (q0 * q3 + q1 * q2), 1.0f - 2.0f * (q2 * q2 + q3 * q3)) * RAD_TO_DEG;
+}
+
 /**
  * @brief       从 Mahony AHRS 获取欧拉角
  * @param       ahrs    Mahony算法结构体指针
@@ -9,6 +9,25 @@
 #define MAHONY_KI   0.002f
 #define SAMPLE_FREQ 100.0f
 
+// 姿态解算实现: 1-Q30定点 Mahony_Fixed_Update 0-浮点 Mahony_Update
+#define MAHONY_USE_FIXED        1
+// 陀螺仪原始值每 °/s 的计数 (与 IMU660RB_GYR_SAMPLE 量程对应，0x5C ±2000dps 为 14.3)
+#define MAHONY_GYRO_LSB         14.3f
+// Q30 定点数: 1.0 = 2^30，范围 -2.0 ~ 2.0
+#define Q30_ONE                 (1073741824L)
+
+// 定点 Mahony 系数，由上面的浮点参数换算 (四舍五入)，修改 MAHONY_KP/MAHONY_KI/MAHONY_GYRO_LSB 时同步修改
+// 写成整数常量，不依赖编译器在预处理后折叠浮点表达式；主机测试 test_mahony_constants 检查换算
+// 陀螺仪原始值 -> 角速度 rad/s (Q32): DEG_TO_RAD / MAHONY_GYRO_LSB * 2^32
+#define MAHONY_FX_GYRO_Q32      (5242050L)
+// 比例系数 (Q24): MAHONY_KP * 2^24，积分系数 (Q30): MAHONY_KI * 2^30
+#define MAHONY_FX_KP_Q24        (5033165L)
+#define MAHONY_FX_KI_Q30        (2147484L)
+// 采样间隔 us -> dt/2 (Q36)，1us = 2^36 / 2000000 = 34359.738，dt 不能超过 62ms
+// 小数部分单独乘 (738/1000)，与陀螺仪系数一样避免 1e-5 级的比例误差
+#define MAHONY_FX_HALF_DT_PER_US    (34359L)
+#define MAHONY_FX_HALF_DT_FRAC      (738L)
+
 struct Quaternion_t
 {
     float q0;
@@ -36,10 +55,29 @@ struct MahonyAHRS_t
     uint8 inited;
 };
 
+// 定点 Mahony 状态 (四元数 Q30，积分项 Q30 rad/s)
+struct MahonyAHRS_Fixed_t
+{
+    int32 q0;
+    int32 q1;
+    int32 q2;
+    int32 q3;
+    int32 integralFBx;
+    int32 integralFBy;
+    int32 integralFBz;
+    uint8 inited;
+};
+
 void Mahony_Init(struct MahonyAHRS_t *ahrs);
 void Mahony_Update(struct MahonyAHRS_t *ahrs, float gx, float gy, float gz, float ax, float ay, float az, float dt);
 void Quaternion_ToEuler(struct Quaternion_t *quat, struct EulerAngle_t *euler);
+float Quaternion_ToYaw(struct Quaternion_t *quat);
 void Mahony_GetEuler(struct MahonyAHRS_t *ahrs, struct EulerAngle_t *euler);
-float Fast_InvSqrt(float x);
+
+int32 q30_mul(int32 a, int32 b);
+void Mahony_Fixed_Init(struct MahonyAHRS_Fixed_t *ahrs);
+void Mahony_Fixed_Update(struct MahonyAHRS_Fixed_t *ahrs, int16 gx, int16 gy, int16 gz,
+                         int16 ax, int16 ay, int16 az, uint32 dt_us);
+void Mahony_Fixed_ToFloat(struct MahonyAHRS_Fixed_t *fixed, struct MahonyAHRS_t *ahrs);
 
 #endif
@@ -0,0 +1,328 @@
+//-------------------------------------------------------------------------------------------------------------------
+// 头文件包含
+//-------------------------------------------------------------------------------------------------------------------
+#include "scheduler.h"
+
+//-------------------------------------------------------------------------------------------------------------------
+// 数据结构
+//-------------------------------------------------------------------------------------------------------------------
+typedef struct
+{
+    const sched_task_t *task;             // 任务表项
+    uint16 countdown;                     // 距离下次到期的节拍数
+    vuint8 due;                           // 后台任务: 到期计数 (节拍中断中加1，溢出回绕)
+    uint8 done;                           // 后台任务: 已处理的到期计数 (主循环中修改)
+    sched_stat_t stat;                    // 执行统计
+} sched_entry_t;
+
+//-------------------------------------------------------------------------------------------------------------------
+// 全局变量定义
+//-------------------------------------------------------------------------------------------------------------------
+void (*sched_overrun_handler)(uint8 index, uint16 us) = NULL;
+
+//-------------------------------------------------------------------------------------------------------------------
+// 私有变量
+//-------------------------------------------------------------------------------------------------------------------
+static sched_entry_t sched_fg[SCHED_TASK_MAX];                  // 前台任务 (任务表顺序)
+static sched_entry_t sched_bg[SCHED_TASK_MAX];                  // 后台任务 (任务表顺序)
+static uint8 sched_fg_order[SCHED_TASK_MAX];                    // 按优先级排序后的下标
+static uint8 sched_bg_order[SCHED_TASK_MAX];
+static uint8 sched_fg_num = 0;
+static uint8 sched_bg_num = 0;
+
+static vuint32 sched_tick = 0;                                  // 节拍计数
+static uint16 sched_timer_reload = 0;                           // 节拍定时器重装载值
+static uint16 sched_counts_per_tick = 0;                        // 每个节拍的定时器计数
+static uint16 sched_counts_per_us = 1;                          // 每微秒的定时器计数
+static sched_stat_t sched_tick_stat;                            // 节拍统计
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     读取本节拍内已经过的定时器计数
+// 参数说明     void
+// 返回参数     uint32          定时器计数，节拍定时器已溢出但中断还没有执行时加一个节拍
+// 备注信息     高字节前后读两次，相同时低字节有效
+//              只能区分一次溢出，只在节拍中断入口读取 (进入中断的延迟)，不用于测量执行时间
+//-------------------------------------------------------------------------------------------------------------------
+static uint32 sched_timer_count(void)
+{
+    uint8 high;
+    uint8 low;
+    uint32 count;
+
+    do
+    {
+        high = TH1;
+        low = TL1;
+    }while(high != TH1);
+
+    count = (uint16)(((uint16)high << 8 | low) - sched_timer_reload);
+    if(TF1)
+    {
+        // 溢出标志在读计数之前或之后置位都可能，计数较小说明读到的是溢出之后的值
+        if(count < (sched_counts_per_tick >> 1))
+        {
+            count += sched_counts_per_tick;
+        }
+    }
+
+    return count;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     执行一个任务并统计执行时间
+// 参数说明     entry           任务
+// 返回参数     uint8           1-超出预算 0-未超出或不检查
+// 备注信息     用自由运行的 timebase 计数 (1MHz) 测量: 节拍中断中执行时节拍计数不增加，节拍定时器只能记录一次溢出，
+//              超过一个节拍的执行时间用节拍定时器测不出来；timebase 计数 65.5ms 回绕，执行时间不能超过该值
+//-------------------------------------------------------------------------------------------------------------------
+static uint8 sched_execute(sched_entry_t *entry)
+{
+    uint16 start;
+
+    start = timebase_now_us16();
+    entry->task->func();
+
+    entry->stat.runs++;
+    entry->stat.last_us = timebase_now_us16() - start;
+    if(entry->stat.last_us > entry->stat.max_us)
+    {
+        entry->stat.max_us = entry->stat.last_us;
+    }
+    if(entry->task->budget_us != 0 && entry->stat.last_us > entry->task->budget_us)
+    {
+        entry->stat.overruns++;
+        return 1;
+    }
+
+    return 0;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     装入任务表
+// 参数说明     entry           任务数组
+// 参数说明     order           输出 按优先级排序的下标
+// 参数说明     table           任务表
+// 参数说明     num             任务数
+// 返回参数     void
+// 备注信息     插入排序，优先级相同时保持任务表中的顺序
+//-------------------------------------------------------------------------------------------------------------------
+static void sched_load(sched_entry_t *entry, uint8 *order, const sched_task_t *table, uint8 num)
+{
+    uint8 i;
+    uint8 j;
+
+    for(i = 0; i < num; i++)
+    {
+        zf_assert(table[i].period > 0 && table[i].phase < table[i].period);
+
+        memset(&entry[i], 0, sizeof(sched_entry_t));
+        entry[i].task = &table[i];
+        entry[i].countdown = table[i].phase;
+
+        // 插入排序
+        j = i;
+        while(j > 0 && table[order[j - 1]].priority > table[i].priority)
+        {
+            order[j] = order[j - 1];
+            j--;
+        }
+        order[j] = i;
+    }
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     调度器初始化
+// 参数说明     fg_table        前台任务表 (节拍中断中执行)
+// 参数说明     fg_num          前台任务数 (不超过 SCHED_TASK_MAX)
+// 参数说明     bg_table        后台任务表 (主循环中执行)
+// 参数说明     bg_num          后台任务数 (不超过 SCHED_TASK_MAX)
+// 返回参数     void
+// 使用示例     scheduler_init(fg_tasks, 2, bg_tasks, 3);
+// 备注信息     节拍定时器为 1T 模式不分频，一个节拍的计数必须小于 32768 (30MHz 下 SCHED_TICK_MS 只能为1)
+//              不使用 pit_ms_init(): 库函数在计数不小于 32768 时自动设置预分频 TM1PS，计数速度变慢后执行时间统计会错
+//-------------------------------------------------------------------------------------------------------------------
+void scheduler_init(const sched_task_t *fg_table, uint8 fg_num, const sched_task_t *bg_table, uint8 bg_num)
+{
+    uint32 counts;
+
+    zf_assert(fg_num <= SCHED_TASK_MAX && bg_num <= SCHED_TASK_MAX);
+
+    sched_load(sched_fg, sched_fg_order, fg_table, fg_num);
+    sched_load(sched_bg, sched_bg_order, bg_table, bg_num);
+    sched_fg_num = fg_num;
+    sched_bg_num = bg_num;
+    sched_tick = 0;
+    memset(&sched_tick_stat, 0, sizeof(sched_tick_stat));
+
+    counts = SCHED_TICK_MS * (system_clock / 1000);
+    zf_assert(counts < 32768);
+    sched_counts_per_tick = (uint16)counts;
+    sched_counts_per_us = (uint16)(system_clock / 1000000);
+    sched_timer_reload = (uint16)(65536UL - sched_counts_per_tick);
+
+    // TIM1: 1T 模式、不分频、模式0 (16位自动重装载)
+    AUXR |= 0x40;
+    TM1PS = 0;
+    TMOD &= 0x0F;
+    TL1 = (uint8)sched_timer_reload;
+    TH1 = (uint8)(sched_timer_reload >> 8);
+    TF1 = 0;
+    TR1 = 1;
+    ET1 = 1;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     调度器节拍
+// 参数说明     void
+// 返回参数     void
+// 使用示例     tim1_irq_handler = scheduler_tick;
+// 备注信息     先记录到期的后台任务，再按优先级执行到期的前台任务
+//              前台任务超出预算时立即调用超时回调，同一节拍中后面的任务可以据此减少工作
+//              前台任务执行完时已超过一个节拍周期 (节拍超时) 只计数
+//              节拍定时器只用于进入中断的延迟，执行时间用 timebase 测量 (节拍定时器在中断中只能记录一次溢出)
+//-------------------------------------------------------------------------------------------------------------------
+void scheduler_tick(void)
+{
+    sched_entry_t *entry;
+    uint16 start;
+    uint16 busy;
+    uint8 index;
+    uint8 i;
+
+    // 进入中断的延迟: 节拍定时器溢出之后的计数，小于一个节拍 (只在这里读，不会超过一次溢出)
+    start = timebase_now_us16();
+    busy = (uint16)(sched_timer_count() / sched_counts_per_us);
+
+    for(i = 0; i < sched_bg_num; i++)
+    {
+        entry = &sched_bg[i];
+        if(entry->countdown == 0)
+        {
+            entry->countdown = entry->task->period - 1;
+            entry->due++;
+        }
+        else
+        {
+            entry->countdown--;
+        }
+    }
+
+    for(i = 0; i < sched_fg_num; i++)
+    {
+        index = sched_fg_order[i];
+        entry = &sched_fg[index];
+        if(entry->countdown == 0)
+        {
+            entry->countdown = entry->task->period - 1;
+            if(sched_execute(entry) && sched_overrun_handler != NULL)
+            {
+                sched_overrun_handler(index, entry->stat.last_us);
+            }
+        }
+        else
+        {
+            entry->countdown--;
+        }
+    }
+
+    // 节拍统计: 从节拍开始 (定时器溢出) 到前台任务执行完的时间 = 进入中断的延迟 + timebase 测量的中断执行时间
+    busy += timebase_now_us16() - start;
+    sched_tick_stat.runs++;
+    sched_tick_stat.last_us = busy;
+    if(busy > sched_tick_stat.max_us)
+    {
+        sched_tick_stat.max_us = busy;
+    }
+    if(busy >= SCHED_TICK_MS * 1000)
+    {
+        sched_tick_stat.overruns++;
+    }
+
+    sched_tick++;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     执行到期的后台任务
+// 参数说明     void
+// 返回参数     void
+// 使用示例     while(1) { scheduler_run_background(); }
+// 备注信息     到期计数只由节拍中断增加、已处理计数只由主循环修改，两者之差为未执行次数，不需要关中断
+//-------------------------------------------------------------------------------------------------------------------
+void scheduler_run_background(void)
+{
+    sched_entry_t *entry;
+    uint8 pending;
+    uint8 i;
+
+    for(i = 0; i < sched_bg_num; i++)
+    {
+        entry = &sched_bg[sched_bg_order[i]];
+        pending = (uint8)(entry->due - entry->done);
+        if(pending == 0)
+        {
+            continue;
+        }
+
+        entry->done += pending;
+        entry->stat.skipped += pending - 1;
+        sched_execute(entry);
+    }
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     获取调度器节拍计数
+// 参数说明     void
+// 返回参数     uint32          上电后的节拍数
+// 使用示例     uint32 now = scheduler_get_tick();
+// 备注信息     32位读取不是原子操作，前后两次相同时有效
+//-------------------------------------------------------------------------------------------------------------------
+uint32 scheduler_get_tick(void)
+{
+    uint32 tick;
+
+    do
+    {
+        tick = sched_tick;
+    }while(tick != sched_tick);
+
+    return tick;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     获取任务执行统计
+// 参数说明     table           SCHED_FOREGROUND / SCHED_BACKGROUND / SCHED_TICK
+// 参数说明     index           任务在任务表中的下标 (scheduler_init 传入的顺序)，SCHED_TICK 时为0
+// 参数说明     out             输出 统计数据
+// 返回参数     uint8           0-成功 1-下标超出范围
+// 使用示例     scheduler_get_stat(SCHED_FOREGROUND, 0, &stat);
+// 备注信息     用于显示调试，不保证前台任务的各项统计来自同一次执行
+//-------------------------------------------------------------------------------------------------------------------
+uint8 scheduler_get_stat(uint8 table, uint8 index, sched_stat_t *out)
+{
+    if(table == SCHED_FOREGROUND)
+    {
+        if(index >= sched_fg_num)
+        {
+            return 1;
+        }
+        memcpy(out, &sched_fg[index].stat, sizeof(sched_stat_t));
+    }
+    else if(table == SCHED_TICK)
+    {
+        if(index != 0)
+        {
+            return 1;
+        }
+        memcpy(out, &sched_tick_stat, sizeof(sched_stat_t));
+    }
+    else
+    {
+        if(index >= sched_bg_num)
+        {
+            return 1;
+        }
+        memcpy(out, &sched_bg[index].stat, sizeof(sched_stat_t));
+    }
+
+    return 0;
+}
@@ -0,0 +1,119 @@
+#ifndef _SCHEDULER_H_
+#define _SCHEDULER_H_
+
+//-------------------------------------------------------------------------------------------------------------------
+// 头文件包含
+//-------------------------------------------------------------------------------------------------------------------
+#include "zf_common_headfile.h"
+
+//-------------------------------------------------------------------------------------------------------------------
+// 说明
+//-------------------------------------------------------------------------------------------------------------------
+// 节拍驱动的协作式调度器，只使用一个定时器 (SCHED_TIMER) 产生 SCHED_TICK_MS 节拍
+//   前台任务表: 在节拍中断中执行，同一节拍到期的任务按 priority 从小到大依次执行，不会互相打断
+//   后台任务表: 节拍中断只记录到期次数，由主循环 scheduler_run_background() 按 priority 依次执行，不阻塞
+// 每个任务有周期、相位偏移、优先级和执行时间预算:
+//   相位偏移把周期相同的任务分散到不同节拍，避免同一节拍中断时间过长
+//   执行时间用 timebase 计数测量 (分辨率 1us，不超过 65.5ms)，超出预算时记录次数，统计由 scheduler_get_stat() 读取
+// 前台任务执行时间之和应小于一个节拍，超过时下一个节拍中断推迟执行 (超过两个节拍会丢失节拍)
+// 超时检测: 前台任务超出预算时计数并调用 sched_overrun_handler (在节拍中断中)，由控制代码决定降级处理
+//   一个节拍的前台任务执行完时下一个节拍已经到期 (节拍超时) 只计数: 节拍推迟不等于控制任务错过周期
+
+//-------------------------------------------------------------------------------------------------------------------
+// 宏定义
+//-------------------------------------------------------------------------------------------------------------------
+#define SCHED_TIMER                 (TIM1_PIT)  // 节拍定时器 如果修改 需要同步修改 main.c 中的 timx_irq_handler 和 scheduler.c 中直接配置、读取的定时器寄存器
+#define SCHED_TICK_MS               (1)         // 节拍周期 (ms)
+#define SCHED_TASK_MAX              (8)         // 每个任务表最多任务数
+
+#define SCHED_FOREGROUND            (0)         // scheduler_get_stat() 的任务表选择
+#define SCHED_BACKGROUND            (1)
+#define SCHED_TICK                  (2)         // 节拍统计 (index 为0): runs-节拍数 last_us/max_us-节拍内前台任务总时间 overruns-节拍超时次数
+
+//-------------------------------------------------------------------------------------------------------------------
+// 数据结构
+//-------------------------------------------------------------------------------------------------------------------
+typedef struct
+{
+    char *name;                           // 任务名称
+    void (*func)(void);                   // 任务函数
+    uint16 period;                        // 周期 (节拍数)
+    uint16 phase;                         // 相位偏移 (节拍数，0 ~ period-1)
+    uint8 priority;                       // 优先级 同一节拍到期时数值小的先执行
+    uint16 budget_us;                     // 执行时间预算 (us)，0-不检查
+} sched_task_t;
+
+typedef struct
+{
+    uint32 runs;                          // 执行次数
+    uint16 last_us;                       // 最近一次执行时间 (us)
+    uint16 max_us;                        // 最大执行时间 (us)
+    uint16 overruns;                      // 超出预算次数
+    uint16 skipped;                       // 后台任务: 执行前又到期的次数 (执行落后于周期)
+} sched_stat_t;
+
+//-------------------------------------------------------------------------------------------------------------------
+// 全局变量声明
+//-------------------------------------------------------------------------------------------------------------------
+// 前台任务超出预算回调 (在节拍中断中调用)，index 为前台任务表下标，us 为执行时间
+// 使用示例     sched_overrun_handler = control_overrun_handler;
+extern void (*sched_overrun_handler)(uint8 index, uint16 us);
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数声明
+//-------------------------------------------------------------------------------------------------------------------
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     调度器初始化
+// 参数说明     fg_table        前台任务表 (节拍中断中执行)
+// 参数说明     fg_num          前台任务数 (不超过 SCHED_TASK_MAX)
+// 参数说明     bg_table        后台任务表 (主循环中执行)
+// 参数说明     bg_num          后台任务数 (不超过 SCHED_TASK_MAX)
+// 返回参数     void
+// 使用示例     scheduler_init(fg_tasks, 2, bg_tasks, 3);
+// 备注信息     按优先级排序任务表并开启节拍定时器，调用前先设置 SCHED_TIMER 对应的 timx_irq_handler = scheduler_tick
+//              执行时间测量使用 timebase，在 timebase_init() 之后调用
+//              任务表在调度器运行期间必须一直有效 (定义为静态常量)
+//-------------------------------------------------------------------------------------------------------------------
+void scheduler_init(const sched_task_t *fg_table, uint8 fg_num, const sched_task_t *bg_table, uint8 bg_num);
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     调度器节拍
+// 参数说明     void
+// 返回参数     void
+// 使用示例     tim1_irq_handler = scheduler_tick;
+// 备注信息     在 SCHED_TIMER 中断中调用，执行到期的前台任务，记录到期的后台任务
+//-------------------------------------------------------------------------------------------------------------------
+void scheduler_tick(void);
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     执行到期的后台任务
+// 参数说明     void
+// 返回参数     void
+// 使用示例     while(1) { scheduler_run_background(); }
+// 备注信息     在主循环中反复调用，没有到期任务时立即返回
+//              一个任务落后多个周期时只执行一次，落后次数记录在 skipped
+//-------------------------------------------------------------------------------------------------------------------
+void scheduler_run_background(void);
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     获取调度器节拍计数
+// 参数说明     void
+// 返回参数     uint32          上电后的节拍数
+// 使用示例     uint32 now = scheduler_get_tick();
+// 备注信息     主循环中读取时可能正被节拍中断修改，内部重读保证一致
+//-------------------------------------------------------------------------------------------------------------------
+uint32 scheduler_get_tick(void);
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     获取任务执行统计
+// 参数说明     table           SCHED_FOREGROUND / SCHED_BACKGROUND / SCHED_TICK
+// 参数说明     index           任务在任务表中的下标 (scheduler_init 传入的顺序)，SCHED_TICK 时为0
+// 参数说明     out             输出 统计数据
+// 返回参数     uint8           0-成功 1-下标超出范围
+// 使用示例     scheduler_get_stat(SCHED_FOREGROUND, 0, &stat);
+// 备注信息     前台任务的统计在中断中更新，复制期间可能被修改，用于显示调试
+//-------------------------------------------------------------------------------------------------------------------
+uint8 scheduler_get_stat(uint8 table, uint8 index, sched_stat_t *out);
+
+#endif
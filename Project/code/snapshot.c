@@ -0,0 +1,45 @@
+//-------------------------------------------------------------------------------------------------------------------
+// 头文件包含
+//-------------------------------------------------------------------------------------------------------------------
+#include "snapshot.h"
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     发布一份新数据
+// 参数说明     snap            快照指针
+// 参数说明     src             新数据 (size 字节)
+// 返回参数     void
+// 使用示例     snapshot_publish(&imu_snap, &imu);
+// 备注信息     先写未发布的缓冲区，再翻转索引，最后计数加1
+//-------------------------------------------------------------------------------------------------------------------
+void snapshot_publish(snapshot_t *snap, const void *src)
+{
+    uint8 next;
+
+    next = snap->ready ^ 1;
+    memcpy(snap->bank[next], src, snap->size);
+    snap->ready = next;                                         // 单字节写入，读取方看到的要么是旧缓冲区要么是新缓冲区
+    snap->seq++;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     读取最近一次发布的数据
+// 参数说明     snap            快照指针
+// 参数说明     dst             输出缓冲 (size 字节)
+// 返回参数     uint8           读取时的发布计数
+// 使用示例     snapshot_read(&imu_snap, &imu_view);
+// 备注信息     复制期间只发布了1次时，写入方写的是另一个缓冲区，数据有效
+//              发布了2次及以上时正在复制的缓冲区可能被覆盖，重新读取
+//              写入方周期远大于一次复制的时间，实际不会重读
+//-------------------------------------------------------------------------------------------------------------------
+uint8 snapshot_read(snapshot_t *snap, void *dst)
+{
+    uint8 seq;
+
+    do
+    {
+        seq = snap->seq;
+        memcpy(dst, snap->bank[snap->ready], snap->size);
+    }while((uint8)(snap->seq - seq) >= 2);
+
+    return seq;
+}
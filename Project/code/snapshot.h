@@ -0,0 +1,59 @@
+#ifndef _SNAPSHOT_H_
+#define _SNAPSHOT_H_
+
+//-------------------------------------------------------------------------------------------------------------------
+// 头文件包含
+//-------------------------------------------------------------------------------------------------------------------
+#include "zf_common_headfile.h"
+
+//-------------------------------------------------------------------------------------------------------------------
+// 说明
+//-------------------------------------------------------------------------------------------------------------------
+// 双缓冲快照: 在一个上下文(中断)中发布数据，在另一个上下文(主循环或其他中断)中读取完整一致的一份
+// 写入方把数据复制到未发布的缓冲区，再翻转8位索引(单字节写入为原子操作)，最后发布计数加1
+// 读取方复制已发布的缓冲区，复制期间发布计数增加2次以上(写入方可能覆盖了正在复制的缓冲区)时重读
+// 不关闭总中断:
+//   - 读取方被写入方打断时，写入方写的是另一个缓冲区，读取方复制的数据不受影响
+//   - 读取方打断写入方时，已发布的缓冲区不会被修改，读取方不会等待写入方
+// 同一个快照只能有一个写入方
+//
+// 快照用静态初始化定义，不依赖初始化函数的调用顺序，例如:
+//   static struct IMUData imu_snap_bank[2];
+//   static snapshot_t imu_snap = {{&imu_snap_bank[0], &imu_snap_bank[1]}, sizeof(struct IMUData), 0, 0};
+
+//-------------------------------------------------------------------------------------------------------------------
+// 数据结构
+//-------------------------------------------------------------------------------------------------------------------
+typedef struct
+{
+    void *bank[2];                        // 两个缓冲区
+    uint16 size;                          // 每个缓冲区字节数
+    vuint8 ready;                         // 最近一次发布的缓冲区索引
+    vuint8 seq;                           // 发布计数 (溢出回绕)
+} snapshot_t;
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数声明
+//-------------------------------------------------------------------------------------------------------------------
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     发布一份新数据
+// 参数说明     snap            快照指针
+// 参数说明     src             新数据 (size 字节)
+// 返回参数     void
+// 使用示例     snapshot_publish(&imu_snap, &imu);
+// 备注信息     在写入方完成一整组数据的更新后调用
+//-------------------------------------------------------------------------------------------------------------------
+void snapshot_publish(snapshot_t *snap, const void *src);
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     读取最近一次发布的数据
+// 参数说明     snap            快照指针
+// 参数说明     dst             输出缓冲 (size 字节)
+// 返回参数     uint8           读取时的发布计数，可用于判断数据是否更新
+// 使用示例     snapshot_read(&imu_snap, &imu_view);
+// 备注信息     可在主循环或其他中断中调用，第一次发布前读到的是全0数据
+//-------------------------------------------------------------------------------------------------------------------
+uint8 snapshot_read(snapshot_t *snap, void *dst);
+
+#endif
@@ -3,7 +3,23 @@
 //-------------------------------------------------------------------------------------------------------------------
 // 全局变量
 //-------------------------------------------------------------------------------------------------------------------
-static uint8 current_control_mode = CONTROL_MODE_PID_ONLY;  // 当前控制模式
+static vuint8 current_control_mode = CONTROL_MODE_CURRENT;  // 当前控制模式 (只在控制中断中修改)
+static vuint8 control_mode_requested = CONTROL_MODE_NONE;   // 主循环请求切换的模式
+static uint8 control_mode_switched = 0;                     // 本周期切换了模式
+static float control_last_correction = 0.0f;                // 上一周期输出的差速修正值
+static float control_blend_offset = 0.0f;                   // 切换时新旧模式输出之差
+static uint8 control_blend_ticks = 0;                       // 剩余过渡周期数
+static uint16 adc_frame_seq_used = 0;                       // 控制算法上次使用的ADC帧序号
+static struct IMUData imu_view;                             // 本控制周期使用的IMU快照
+static float direction_correction = 0.0f;                   // 方向控制输出的差速修正值 (速度控制任务使用)
+static uint8 control_mode_selected = CONTROL_MODE_CURRENT;  // 选择的控制模式 (超时降级之前)
+
+// 控制任务超时处理状态 (只在节拍中断中修改)
+static vuint8 overrun_flags = 0;                            // 正在生效的降级动作和严重超时标志
+static vuint16 overrun_total = 0;                           // 上电后的超时次数
+static uint8 overrun_hold_pwm = 0;                          // 下一个速度控制周期保持PWM
+static uint8 overrun_episode = 0;                           // 本次降级期间的超时次数
+static uint16 overrun_clean_ticks = 0;                      // 降级后连续没有超时的方向控制周期数
 
 //-------------------------------------------------------------------------------------------------------------------
 // 函数简介     检查ADC传感器有效性
@@ -37,6 +53,27 @@ uint8 sensor_check_valid(void)
     return sensor_valid;
 }
 
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     检查ADC数据帧是否为新数据
+// 参数说明     void
+// 返回参数     uint8           1-新数据帧(并标记为已使用) 0-数据帧未更新
+// 使用示例     if(adc_frame_is_fresh()) { ... }
+// 备注信息     比较 adc_frame_seq 与上次使用的序号，每一帧只会被判定为新数据一次
+//-------------------------------------------------------------------------------------------------------------------
+uint8 adc_frame_is_fresh(void)
+{
+    uint16 seq;
+
+    seq = adc_frame_seq;
+    if(seq == adc_frame_seq_used)
+    {
+        return 0;  // 本周期没有新的采样帧
+    }
+
+    adc_frame_seq_used = seq;
+    return 1;
+}
+
 //-------------------------------------------------------------------------------------------------------------------
 // 函数简介     计算位置误差
 // 参数说明     void
@@ -44,13 +81,19 @@ uint8 sensor_check_valid(void)
 // 使用示例     float err = position_error_calc();
 // 备注信息     计算中间传感器相对中心的偏差
 //              adc_normalized_list[2]: 0=赛道最左, 25=赛道中心, 50=赛道最右
+//              ADC_METHOD_OVERSAMPLE 时使用 adc_normalized_fine[2] (0-1000)，换算回同样的 ±25 量程
+//              分辨率由1提高到0.05，中心线附近不再整步跳变
 //              返回值: 负数=偏左, 正数=偏右, 0=居中
 //-------------------------------------------------------------------------------------------------------------------
 float position_error_calc(void)
 {
     float error;
 
+#if(ADC_GETVAL_METHOD == ADC_METHOD_OVERSAMPLE)
+    error = ((float)adc_normalized_fine[2] - 500.0f) * 0.05f;
+#else
     error = (float)adc_normalized_list[2] - 25.0f;
+#endif
 
     return error;
 }
@@ -83,8 +126,8 @@ float sdsd_control_with_sensor_check(void)
     float input_SDSD;
     float output_SDSD;
 
-    // 检查传感器有效性
-    sensor_valid = sensor_check_valid();
+    // 检查传感器有效性 (旧数据帧按无效处理，避免对同一帧重复积分)
+    sensor_valid = adc_frame_is_fresh() && sensor_check_valid();
 
     if(sensor_valid)
     {
@@ -94,7 +137,7 @@ float sdsd_control_with_sensor_check(void)
     }
     else
     {
-        // 传感器异常，保持上一次的PID输出
+        // 传感器异常或数据帧未更新，保持上一次的PID输出
         output_SDSD = pid_SDSD.out;
     }
 
@@ -116,8 +159,8 @@ float pd_control_with_sensor_check(void)
     float position_error;
     float correction;
 
-    // 检查传感器有效性
-    sensor_valid = sensor_check_valid();
+    // 检查传感器有效性 (旧数据帧按无效处理)
+    sensor_valid = adc_frame_is_fresh() && sensor_check_valid();
 
     // 计算位置误差
     position_error = position_error_calc();
@@ -126,14 +169,295 @@ float pd_control_with_sensor_check(void)
     if(sensor_valid)
     {
         // 传感器正常，使用四元数增强的PD控制
-        correction = pd_direction_gyro_loop(position_error);
+        correction = pd_direction_gyro_loop(position_error, &imu_view);
     }
     else
     {
         // 传感器异常，使用IMU角速度反馈保持直行
-        correction = -imu.gyro_z * 0.5f;  // 简单的角速度负反馈
+        correction = -imu_view.gyro_z * 0.5f;  // 简单的角速度负反馈
+    }
+
+    return correction;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     SDSD控制模式初始化
+// 参数说明     void
+// 返回参数     void
+// 使用示例     sdsd_mode_init();
+// 备注信息     差比和差系数和SDSD的PID参数 Kp=2.0, Ki=0, Kd=0.5，期望偏差为0(居中)
+//-------------------------------------------------------------------------------------------------------------------
+static void sdsd_mode_init(void)
+{
+    SDSD_init(&SDSD, 1.0f, 1.0f, 1.0f);
+    pid_init(&pid_SDSD, 2.0f, 0.0f, 0.5f);
+    pid_SDSD.target = 0;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     SDSD控制模式复位
+// 参数说明     void
+// 返回参数     void
+// 使用示例     sdsd_mode_reset();
+// 备注信息     清除SDSD的PID积分，历史误差填为当前偏差 (传感器无效时按居中处理)
+//-------------------------------------------------------------------------------------------------------------------
+static void sdsd_mode_reset(void)
+{
+    pid_reset(&pid_SDSD, sensor_check_valid() ? SDSD_calculate(&SDSD) : pid_SDSD.target);
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     PD方向环控制模式初始化
+// 参数说明     void
+// 返回参数     void
+// 使用示例     pd_mode_init();
+// 备注信息     Kp=2.5, Kd=0.8 (方向环) | Kp_gyro=1.2, Kd_gyro=0.3 (角速度环)
+//              四元数姿态控制器目标姿态 roll=0, pitch=0, yaw=0 (保持水平直行)
+//-------------------------------------------------------------------------------------------------------------------
+static void pd_mode_init(void)
+{
+    pd_init(&pd_direction, 2.5f, 0.8f, 1.2f, 0.3f);
+    attitude_init(0.0f, 0.0f, 0.0f, 2.5f, 0.8f, 1.2f, 0.3f);
+}
+
+// 控制模式表 (下标为 CONTROL_MODE_xxx)
+static const control_mode_t control_mode_table[CONTROL_MODE_TOTAL] =
+{
+    {"纯PID速度环",       NULL,           NULL,               pid_only_control},
+    {"SDSD循迹",          sdsd_mode_init, sdsd_mode_reset,    sdsd_control_with_sensor_check},
+    {"PD方向环(四元数)",  pd_mode_init,   pd_direction_reset, pd_control_with_sensor_check},
+};
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     切换控制模式
+// 参数说明     mode            目标控制模式
+// 返回参数     void
+// 使用示例     control_mode_switch(CONTROL_MODE_SDSD);
+// 备注信息     在控制中断中调用，复位新模式的控制器，本周期计算后开始输出过渡
+//-------------------------------------------------------------------------------------------------------------------
+static void control_mode_switch(uint8 mode)
+{
+    if(mode >= CONTROL_MODE_TOTAL || mode == current_control_mode)
+    {
+        return;
+    }
+
+    if(control_mode_table[mode].reset != NULL)
+    {
+        control_mode_table[mode].reset();
+    }
+    current_control_mode = mode;
+    control_mode_switched = 1;
+}
+
+#if(CONTROL_SELECT_METHOD == CONTROL_SELECT_METHOD_AUTO)
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     按赛道事件选择控制模式
+// 参数说明     error           本周期位置误差
+// 参数说明     valid           本周期传感器是否有效
+// 返回参数     uint8           应该使用的控制模式
+// 使用示例     mode = control_mode_auto_select(error, valid);
+// 备注信息     丢线: 连续 CONTROL_AUTO_LOST_TICKS 周期传感器无效
+//              圆环: 两侧电感连续 CONTROL_AUTO_RING_TICKS 周期都很大，之后保持 CONTROL_AUTO_RING_HOLD_TICKS 周期
+//              直道: 连续 CONTROL_AUTO_STRAIGHT_TICKS 周期传感器有效、位置误差小且Z轴角速度小
+//              切换后 CONTROL_AUTO_HOLD_TICKS 周期内保持当前模式 (丢线除外)
+//-------------------------------------------------------------------------------------------------------------------
+static uint8 control_mode_auto_select(float error, uint8 valid)
+{
+    static uint8 lost_ticks = 0;
+    static uint8 ring_ticks = 0;
+    static uint8 ring_hold = 0;
+    static uint8 straight_ticks = 0;
+    static uint8 hold_ticks = 0;
+    static uint8 last_mode = CONTROL_AUTO_MODE_DEFAULT;
+    uint8 mode;
+
+    // 事件计数
+    lost_ticks = valid ? 0 : ((lost_ticks < 255) ? lost_ticks + 1 : lost_ticks);
+
+    if(adc_normalized_list[0] > CONTROL_AUTO_RING_LEVEL && adc_normalized_list[4] > CONTROL_AUTO_RING_LEVEL)
+    {
+        ring_ticks = (ring_ticks < 255) ? ring_ticks + 1 : ring_ticks;
+    }
+    else
+    {
+        ring_ticks = 0;
+    }
+    if(ring_ticks >= CONTROL_AUTO_RING_TICKS)
+    {
+        ring_hold = CONTROL_AUTO_RING_HOLD_TICKS;
+    }
+    else if(ring_hold > 0)
+    {
+        ring_hold--;
+    }
+
+    if(valid && error < STRAIGHT_ERROR_MAX && error > -STRAIGHT_ERROR_MAX &&
+       imu_view.gyro_z < CONTROL_AUTO_STRAIGHT_GYRO && imu_view.gyro_z > -CONTROL_AUTO_STRAIGHT_GYRO)
+    {
+        straight_ticks = (straight_ticks < 255) ? straight_ticks + 1 : straight_ticks;
+    }
+    else
+    {
+        straight_ticks = 0;
+    }
+
+    // 按优先级选择模式
+    if(lost_ticks >= CONTROL_AUTO_LOST_TICKS)
+    {
+        mode = CONTROL_AUTO_MODE_LOST;
+    }
+    else if(ring_hold > 0)
+    {
+        mode = CONTROL_AUTO_MODE_RING;
+    }
+    else if(straight_ticks >= CONTROL_AUTO_STRAIGHT_TICKS)
+    {
+        mode = CONTROL_AUTO_MODE_STRAIGHT;
+    }
+    else
+    {
+        mode = CONTROL_AUTO_MODE_DEFAULT;
+    }
+
+    // 最短保持时间 (丢线立即切换)
+    if(hold_ticks > 0)
+    {
+        hold_ticks--;
+        if(lost_ticks < CONTROL_AUTO_LOST_TICKS)
+        {
+            mode = last_mode;
+        }
+    }
+    if(mode != last_mode)
+    {
+        hold_ticks = CONTROL_AUTO_HOLD_TICKS;
+        last_mode = mode;
+    }
+
+    return mode;
+}
+#endif
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     控制模式初始化
+// 参数说明     void
+// 返回参数     void
+// 使用示例     control_mode_init();
+// 备注信息     参数初始化放在各模式的 init 中，切换模式时不会重新初始化参数
+//-------------------------------------------------------------------------------------------------------------------
+void control_mode_init(void)
+{
+    uint8 i;
+
+    for(i = 0; i < CONTROL_MODE_TOTAL; i++)
+    {
+        if(control_mode_table[i].init != NULL)
+        {
+            control_mode_table[i].init();
+        }
+    }
+
+#if(CONTROL_SELECT_METHOD == CONTROL_SELECT_METHOD_AUTO)
+    current_control_mode = CONTROL_AUTO_MODE_DEFAULT;
+#else
+    current_control_mode = CONTROL_MODE_CURRENT;
+#endif
+    control_mode_selected = current_control_mode;
+    control_mode_requested = CONTROL_MODE_NONE;
+    control_last_correction = 0.0f;
+    control_blend_ticks = 0;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     请求切换控制模式
+// 参数说明     mode            目标控制模式
+// 返回参数     void
+// 使用示例     control_mode_request(CONTROL_MODE_SDSD);
+// 备注信息     单字节写入，控制中断中读取后清除
+//-------------------------------------------------------------------------------------------------------------------
+void control_mode_request(uint8 mode)
+{
+#if(CONTROL_SELECT_METHOD == CONTROL_SELECT_METHOD_KEY)
+    if(mode < CONTROL_MODE_TOTAL)
+    {
+        control_mode_requested = mode;
+    }
+#endif
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     请求切换到下一个控制模式
+// 参数说明     void
+// 返回参数     void
+// 使用示例     control_mode_next();
+// 备注信息     连续按键时以尚未生效的请求为基准，不会漏掉按键
+//-------------------------------------------------------------------------------------------------------------------
+void control_mode_next(void)
+{
+    uint8 mode;
+
+    mode = control_mode_requested;
+    if(mode == CONTROL_MODE_NONE)
+    {
+        mode = control_mode_selected;
+    }
+    control_mode_request((uint8)((mode + 1) % CONTROL_MODE_TOTAL));
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     控制模式更新并计算差速修正值
+// 参数说明     error           本周期位置误差
+// 参数说明     valid           本周期传感器是否有效
+// 返回参数     float           电机差速修正值
+// 使用示例     correction = control_mode_update(error, valid);
+// 备注信息     处理按键请求或自动切换，执行当前模式的 step
+//              超时降级期间选择的模式为 OVERRUN_DEGRADE_FROM 时改用 OVERRUN_DEGRADE_TO，解除降级后切回
+//              切换后的第一个周期输出等于切换前的输出，之后 CONTROL_MODE_BLEND_TICKS 周期内线性过渡到新模式的输出
+//-------------------------------------------------------------------------------------------------------------------
+static float control_mode_update(float error, uint8 valid)
+{
+    float correction;
+    uint8 mode;
+#if(CONTROL_SELECT_METHOD == CONTROL_SELECT_METHOD_KEY)
+    uint8 request;
+#endif
+
+    // 1. 选择模式
+#if(CONTROL_SELECT_METHOD == CONTROL_SELECT_METHOD_KEY)
+    request = control_mode_requested;
+    if(request != CONTROL_MODE_NONE)
+    {
+        control_mode_requested = CONTROL_MODE_NONE;
+        control_mode_selected = request;
+    }
+#elif(CONTROL_SELECT_METHOD == CONTROL_SELECT_METHOD_AUTO)
+    control_mode_selected = control_mode_auto_select(error, valid);
+#endif
+    mode = control_mode_selected;
+    if((overrun_flags & OVERRUN_ACTION_DEGRADE) && mode == OVERRUN_DEGRADE_FROM)
+    {
+        mode = OVERRUN_DEGRADE_TO;
     }
+    control_mode_switch(mode);
 
+    // 2. 执行当前模式
+    correction = control_mode_table[current_control_mode].step();
+
+    // 3. 输出过渡
+    if(control_mode_switched)
+    {
+        control_mode_switched = 0;
+        control_blend_offset = control_last_correction - correction;
+        control_blend_ticks = CONTROL_MODE_BLEND_TICKS;
+    }
+    if(control_blend_ticks > 0)
+    {
+        correction += control_blend_offset * control_blend_ticks / CONTROL_MODE_BLEND_TICKS;
+        control_blend_ticks--;
+    }
+
+    control_last_correction = correction;
     return correction;
 }
 
@@ -146,11 +470,7 @@ float pd_control_with_sensor_check(void)
 //-------------------------------------------------------------------------------------------------------------------
 uint8 get_control_mode(void)
 {
-    #if(CONTROL_SELECT_METHOD == CONTROL_SELECT_METHOD_STATIC)
-        return CONTROL_MODE_CURRENT;
-    #else
-        return current_control_mode;
-    #endif
+    return current_control_mode;
 }
 
 //-------------------------------------------------------------------------------------------------------------------
@@ -158,80 +478,191 @@ uint8 get_control_mode(void)
 // 参数说明     mode            控制模式编号
 // 返回参数     char*           模式名称字符串
 // 使用示例     printf("当前模式: %s\r\n", get_mode_name(get_control_mode()));
-// 备注信息     返回控制模式的中文名称
+// 备注信息     返回控制模式表中的中文名称
 //-------------------------------------------------------------------------------------------------------------------
 char* get_mode_name(uint8 mode)
 {
-    switch(mode)
+    if(mode >= CONTROL_MODE_TOTAL)
+    {
+        return "未知模式";
+    }
+
+    return control_mode_table[mode].name;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     控制任务超时处理
+// 参数说明     index           超出预算的前台任务下标 (main.c 中的任务表)
+// 参数说明     us              执行时间 (us)
+// 返回参数     void
+// 使用示例     sched_overrun_handler = control_overrun_handler;
+// 备注信息     由调度器在节拍中断中调用，OVERRUN_CONTROL_TASKS 中的任务超时按 OVERRUN_POLICY 开始降级处理，其他任务只计数
+//              执行时间超过 OVERRUN_HARD_US 或降级期间累计超时 OVERRUN_HARD_COUNT 次时立即停止电机，之后不再输出 (重新上电恢复)
+//-------------------------------------------------------------------------------------------------------------------
+void control_overrun_handler(uint8 index, uint16 us)
+{
+    overrun_total++;
+
+    if(index < 8 && (OVERRUN_CONTROL_TASKS & (1 << index)))
+    {
+        overrun_clean_ticks = 0;
+        if(overrun_episode < 255)
+        {
+            overrun_episode++;
+        }
+
+        overrun_flags |= OVERRUN_POLICY & (OVERRUN_ACTION_SKIP_OPTIONAL | OVERRUN_ACTION_DEGRADE);
+        if(OVERRUN_POLICY & OVERRUN_ACTION_HOLD_PWM)
+        {
+            overrun_hold_pwm = 1;
+        }
+    }
+
+    if(us > OVERRUN_HARD_US || overrun_episode >= OVERRUN_HARD_COUNT)
+    {
+        Motor_LeftForward(0);
+        Motor_RightForward(0);
+        overrun_flags |= OVERRUN_FLAG_FAULT;
+    }
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     获取超时处理状态
+// 参数说明     void
+// 返回参数     uint8           正在生效的 OVERRUN_ACTION_SKIP_OPTIONAL / OVERRUN_ACTION_DEGRADE 和 OVERRUN_FLAG_FAULT，0-正常
+// 使用示例     if(control_overrun_flags() & OVERRUN_ACTION_SKIP_OPTIONAL) { ... }
+// 备注信息     可在主循环中调用
+//-------------------------------------------------------------------------------------------------------------------
+uint8 control_overrun_flags(void)
+{
+    return overrun_flags;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     获取超时次数
+// 参数说明     void
+// 返回参数     uint16          上电后的超时次数 (各前台任务的总和)
+// 使用示例     printf("overrun %u\r\n", control_overrun_count());
+// 备注信息     16位读取前后两次相同时有效
+//-------------------------------------------------------------------------------------------------------------------
+uint16 control_overrun_count(void)
+{
+    uint16 count;
+
+    do
+    {
+        count = overrun_total;
+    }while(count != overrun_total);
+
+    return count;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     超时降级恢复
+// 参数说明     void
+// 返回参数     void
+// 使用示例     control_overrun_recover();
+// 备注信息     每个方向控制周期调用，超时后连续 OVERRUN_RECOVER_TICKS 周期没有超时时解除降级并重新开始累计 (严重超时不解除)
+//              按超时次数判断而不是按降级标志，OVERRUN_POLICY 只有 OVERRUN_ACTION_HOLD_PWM 时累计次数同样会清零
+//-------------------------------------------------------------------------------------------------------------------
+static void control_overrun_recover(void)
+{
+    if(overrun_episode == 0)
+    {
+        return;
+    }
+
+    overrun_clean_ticks++;
+    if(overrun_clean_ticks >= OVERRUN_RECOVER_TICKS)
     {
-        case CONTROL_MODE_PID_ONLY:
-            return "纯PID速度环";
-        case CONTROL_MODE_SDSD:
-            return "SDSD循迹";
-        case CONTROL_MODE_PD_DIRECTION:
-            return "PD方向环(四元数)";
-        default:
-            return "未知模式";
+        overrun_flags &= ~(OVERRUN_ACTION_SKIP_OPTIONAL | OVERRUN_ACTION_DEGRADE);
+        overrun_episode = 0;
     }
 }
 
 //-------------------------------------------------------------------------------------------------------------------
-// 函数简介     电机控制任务(10ms周期调用)
+// 函数简介     方向控制任务
 // 参数说明     void
 // 返回参数     void
-// 使用示例     motor_control_task();
-// 备注信息     在10ms定时中断中调用，完成编码器采集和电机控制
-//              功能: 编码器采集 -> 控制算法选择 -> 电机输出
+// 使用示例     direction_control_task();
+// 备注信息     由调度器在节拍中断中按 CONTROL_DIRECTION_PERIOD 周期调用，在同一节拍的速度控制任务之前执行
+//              功能: ADC采样帧更新 -> IMU快照 -> 误差统计 (TRACK_METRICS_ENABLE) /直道提示 -> 控制算法选择 -> 差速修正值
 //              控制模式由 task.h 中的 CONTROL_MODE_CURRENT 决定
 //-------------------------------------------------------------------------------------------------------------------
-void motor_control_task(void)
+void direction_control_task(void)
 {
-    float correction;
-    uint8 mode;
+    float error;
+    uint8 valid;
 
-    // 使用滤波后的编码器获取函数 (一阶IIR低通滤波)
-    Encoder_Get_Filtered();
+    PROFILER_BEGIN(PROFILER_ID_DIRECTION);
 
-    // 获取当前控制模式
-    mode = get_control_mode();
+    // 超时降级后连续没有超时则恢复
+    control_overrun_recover();
 
-    // 根据控制模式选择不同的控制算法
-    switch(mode)
-    {
-        case CONTROL_MODE_PID_ONLY:
-            // 模式0: 纯PID速度环控制(无循迹)
-            correction = pid_only_control();
-            break;
+    // 在控制算法之前完成本周期的ADC采样和归一化，传感器到执行器延迟不超过一个控制周期
+    Adc_Frame_Update();
 
-        case CONTROL_MODE_SDSD:
-            // 模式1: SDSD控制
-            correction = sdsd_control_with_sensor_check();
-            break;
+    // 取IMU快照，本周期控制算法使用的四元数和角速度来自同一次姿态更新
+    imu_get_snapshot(&imu_view);
 
-        case CONTROL_MODE_PD_DIRECTION:
-            // 模式2: PD方向环+角速度环控制 (四元数实现)
-            correction = pd_control_with_sensor_check();
-            break;
+    error = position_error_calc();
+    valid = sensor_check_valid();
 
-        default:
-            // 默认: 纯PID模式
-            correction = pid_only_control();
-            break;
+#if(TRACK_METRICS_ENABLE)
+    // 赛道统计 (圈时 / 传感器位置误差均方根和峰值)
+    Track_Metrics_Update(error, valid);
+#endif
+
+    // 沿直道行驶时提示陀螺仪零偏估计跟踪Z轴零偏
+    gyro_bias_set_straight(valid && error < STRAIGHT_ERROR_MAX && error > -STRAIGHT_ERROR_MAX);
+
+    // 选择控制模式并计算差速修正值 (按键请求 / 自动切换，切换时输出平滑过渡)
+    direction_correction = control_mode_update(error, valid);
+
+    PROFILER_END(PROFILER_ID_DIRECTION);
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     速度控制任务
+// 参数说明     void
+// 返回参数     void
+// 使用示例     speed_control_task();
+// 备注信息     由调度器在节拍中断中按 CONTROL_SPEED_PERIOD 周期调用
+//              功能: 编码器采集 -> 叠加最近一次方向控制的差速修正值 -> 电机PID -> 电机输出
+//              严重超时后不再输出，OVERRUN_ACTION_HOLD_PWM 时超时后的一个周期不计算速度环
+//-------------------------------------------------------------------------------------------------------------------
+void speed_control_task(void)
+{
+    PROFILER_BEGIN(PROFILER_ID_SPEED);
+
+    // 使用滤波后的编码器获取函数 (一阶IIR低通滤波)
+    Encoder_Get_Filtered();
+
+    // 严重超时后电机保持停止，超时后的一个周期按策略保持上次PWM
+    if((overrun_flags & OVERRUN_FLAG_FAULT) || overrun_hold_pwm)
+    {
+        overrun_hold_pwm = 0;
+    }
+    else
+    {
+        // 电机PID控制 (修正值叠加到编码器输入)
+        motor_pid_control(encoder_data_dir_L + direction_correction, encoder_data_dir_R - direction_correction);
     }
 
-    // 电机PID控制 (修正值叠加到编码器输入)
-    motor_pid_control(encoder_data_dir_L + correction, encoder_data_dir_R - correction);
+    PROFILER_END(PROFILER_ID_SPEED);
 }
 
 //-------------------------------------------------------------------------------------------------------------------
-// 函数简介     IMU更新任务(50ms周期调用)
+// 函数简介     IMU更新任务
 // 参数说明     void
 // 返回参数     void
 // 使用示例     imu_update_task();
-// 备注信息     在50ms定时中断中调用，更新IMU数据
-//              功能: 获取IMU原始数据 -> 四元数解算 -> 欧拉角更新
+// 备注信息     IMU_USE_FIFO 为1时在IMU660RB FIFO水位外部中断中调用 (约9.6ms一次)，否则由调度器按 IMU_UPDATE_PERIOD 周期调用
+//              功能: 获取IMU原始数据 -> 四元数解算 (欧拉角在读取时由 imu_get_euler 计算)
 //-------------------------------------------------------------------------------------------------------------------
 void imu_update_task(void)
 {
+    PROFILER_BEGIN(PROFILER_ID_IMU);
     imu_update();
+    PROFILER_END(PROFILER_ID_IMU);
 }
@@ -15,23 +15,81 @@
 #define CONTROL_MODE_SDSD              1       // SDSD控制模式
 #define CONTROL_MODE_PD_DIRECTION       2       // PD方向环+角速度环模式(四元数实现)
 #define CONTROL_MODE_TOTAL             3       // 总模式数
+#define CONTROL_MODE_NONE              0xFF    // 没有切换请求
 
 // 当前控制模式选择方式 (选择一种)
 #define CONTROL_SELECT_METHOD_STATIC   0       // 静态选择: 编译时固定模式
-#define CONTROL_SELECT_METHOD_KEY      1       // 动态选择: 按键切换模式
-#define CONTROL_SELECT_METHOD_AUTO     2       // 自动切换: 定时自动切换
+#define CONTROL_SELECT_METHOD_KEY      1       // 动态选择: 按键切换模式 (PID菜单普通界面 KEY3 切换到下一个模式)
+#define CONTROL_SELECT_METHOD_AUTO     2       // 自动切换: 按赛道事件 (丢线/圆环/直道) 切换
 
-// 当前使用的模式选择方式
+// 当前使用的模式选择方式 (主机仿真编译时用 -D 改为按键切换，由仿真脚本选择模式)
+#ifndef CONTROL_SELECT_METHOD
 #define CONTROL_SELECT_METHOD          CONTROL_SELECT_METHOD_STATIC  // 静态模式
-
-// ========== 静态模式选择 (编译时固定) ==========
-#if(CONTROL_SELECT_METHOD == CONTROL_SELECT_METHOD_STATIC)
-    // 修改此值选择控制算法
-    #define CONTROL_MODE_CURRENT       CONTROL_MODE_PID_ONLY    // 默认: 纯PID (先测试电机)
-    // #define CONTROL_MODE_CURRENT    CONTROL_MODE_SDSD         // 然后测试SDSD循迹
-    // #define CONTROL_MODE_CURRENT    CONTROL_MODE_PD_DIRECTION  // 最后测试PD方向环+角速度环
 #endif
 
+// ========== 初始模式选择 (静态选择时固定使用，按键切换时为上电后的模式) ==========
+// 修改此值选择控制算法
+#define CONTROL_MODE_CURRENT           CONTROL_MODE_PID_ONLY    // 默认: 纯PID (先测试电机)
+// #define CONTROL_MODE_CURRENT        CONTROL_MODE_SDSD         // 然后测试SDSD循迹
+// #define CONTROL_MODE_CURRENT        CONTROL_MODE_PD_DIRECTION  // 最后测试PD方向环+角速度环
+
+// 模式切换时差速修正从旧模式的输出线性过渡到新模式的输出，过渡周期数 (20 = 200ms)
+#define CONTROL_MODE_BLEND_TICKS       20
+
+// ========== 自动切换 (CONTROL_SELECT_METHOD_AUTO) ==========
+// 事件优先级: 丢线 > 圆环 > 直道 > 其他 (弯道)
+#define CONTROL_AUTO_MODE_LOST         CONTROL_MODE_PD_DIRECTION  // 丢线: IMU角速度反馈保持方向
+#define CONTROL_AUTO_MODE_RING         CONTROL_MODE_PD_DIRECTION  // 圆环: 四元数姿态辅助
+#define CONTROL_AUTO_MODE_STRAIGHT     CONTROL_MODE_SDSD          // 直道: 差比和差循迹
+#define CONTROL_AUTO_MODE_DEFAULT      CONTROL_MODE_PD_DIRECTION  // 其他 (弯道)，也是上电后的模式
+
+#define CONTROL_AUTO_HOLD_TICKS        30      // 切换后至少保持的周期数 (300ms)，防止在两个模式间来回切换
+#define CONTROL_AUTO_LOST_TICKS        5       // 连续传感器无效的周期数达到该值判定为丢线
+#define CONTROL_AUTO_RING_LEVEL        40      // 两侧电感 (通道0和4) 归一化值都超过该值视为圆环入口
+#define CONTROL_AUTO_RING_TICKS        3       // 圆环入口特征连续出现的周期数
+#define CONTROL_AUTO_RING_HOLD_TICKS   150     // 判定圆环后保持圆环模式的周期数 (1.5s)
+#define CONTROL_AUTO_STRAIGHT_GYRO     (20.0f) // 直道判断: Z轴角速度绝对值上限 (°/s)
+#define CONTROL_AUTO_STRAIGHT_TICKS    30      // 直道判断: 连续满足条件的周期数 (300ms)
+
+//-------------------------------------------------------------------------------------------------------------------
+// 数据结构
+//-------------------------------------------------------------------------------------------------------------------
+// 控制模式表项，每个控制模式提供一组函数
+typedef struct
+{
+    char *name;                           // 模式名称
+    void (*init)(void);                   // 上电初始化 (control_mode_init 中调用一次)，可以为 NULL
+    void (*reset)(void);                  // 切换到该模式时调用，清除控制器历史状态，可以为 NULL
+    float (*step)(void);                  // 每个控制周期调用，返回电机差速修正值
+} control_mode_t;
+
+// 直道判断: 传感器有效且位置误差绝对值小于该值时提示陀螺仪零偏估计 (gyro_bias_set_straight)
+// 弯道上循迹误差也可能很小，零偏估计另外用窗口内Z轴角速度排除弯道
+#define STRAIGHT_ERROR_MAX             (3.0f)
+
+// 调度器任务周期 (节拍数，节拍为 SCHED_TICK_MS = 1ms)，任务表在 main.c 中
+// PD / SDSD 的微分项和 CONTROL_AUTO_* 的周期数按 10ms 控制周期整定，修改方向控制周期时需要同步调整
+#define CONTROL_DIRECTION_PERIOD       10      // 方向控制 (ADC -> 控制算法)
+#define CONTROL_SPEED_PERIOD           10      // 速度控制 (编码器 -> 电机PID)，编码器计数值单位为每10ms
+#define IMU_UPDATE_PERIOD              10      // IMU更新 (IMU_USE_FIFO 为0时使用)
+#define IMU_UPDATE_PHASE               5       // IMU更新相位偏移，与控制任务错开节拍
+
+// 控制任务超时处理 (前台任务超出调度器任务表中的预算)，OVERRUN_POLICY 为下面动作的组合
+#define OVERRUN_ACTION_SKIP_OPTIONAL   0x01    // 跳过可选工作: 主循环只输出超时状态，不计算欧拉角、不输出传感器数据
+#define OVERRUN_ACTION_DEGRADE         0x02    // 降级控制模式: OVERRUN_DEGRADE_FROM 换成计算量小的 OVERRUN_DEGRADE_TO
+#define OVERRUN_ACTION_HOLD_PWM        0x04    // 超时后的一个速度控制周期不计算速度环，保持上次PWM
+#define OVERRUN_FLAG_FAULT             0x80    // 严重超时: 电机已停止 (control_overrun_flags 返回值，不是可选动作)
+
+#define OVERRUN_POLICY                 (OVERRUN_ACTION_SKIP_OPTIONAL | OVERRUN_ACTION_DEGRADE)
+#define OVERRUN_DEGRADE_FROM           CONTROL_MODE_PD_DIRECTION  // PD方向环+四元数姿态
+#define OVERRUN_DEGRADE_TO             CONTROL_MODE_SDSD          // SDSD差比和差
+#define OVERRUN_RECOVER_TICKS          100     // 连续这么多个方向控制周期没有超时后解除降级 (1s)
+#define OVERRUN_HARD_US                5000    // 单次执行时间超过该值 (半个控制周期) 为严重超时
+#define OVERRUN_HARD_COUNT             10      // 降级期间 (解除之前) 累计超时次数达到该值也为严重超时
+// 按 OVERRUN_POLICY 处理的前台任务 (main.c 前台任务表下标的位掩码，默认 direction、speed)
+// 其他前台任务 (imu) 超时只计数，单次超过 OVERRUN_HARD_US 时同样为严重超时
+#define OVERRUN_CONTROL_TASKS          ((1 << 0) | (1 << 1))
+
 //-------------------------------------------------------------------------------------------------------------------
 // 函数简介     检查ADC传感器有效性
 // 参数说明     void
@@ -41,6 +99,15 @@
 //-------------------------------------------------------------------------------------------------------------------
 uint8 sensor_check_valid(void);
 
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     检查ADC数据帧是否为新数据
+// 参数说明     void
+// 返回参数     uint8           1-新数据帧(并标记为已使用) 0-数据帧未更新
+// 使用示例     if(adc_frame_is_fresh()) { ... }
+// 备注信息     比较 adc_frame_seq 与上次使用的序号，每一帧只会被判定为新数据一次
+//-------------------------------------------------------------------------------------------------------------------
+uint8 adc_frame_is_fresh(void);
+
 //-------------------------------------------------------------------------------------------------------------------
 // 函数简介     计算位置误差
 // 参数说明     void
@@ -48,6 +115,7 @@ uint8 sensor_check_valid(void);
 // 使用示例     float err = position_error_calc();
 // 备注信息     计算中间传感器相对中心的偏差
 //              adc_normalized_list[2]: 0=赛道最左, 25=赛道中心, 50=赛道最右
+//              ADC_METHOD_OVERSAMPLE 时改用 adc_normalized_fine[2]，量程不变，分辨率0.05
 //              返回值: 负数=偏左, 正数=偏右, 0=居中
 //-------------------------------------------------------------------------------------------------------------------
 float position_error_calc(void);
@@ -83,6 +151,35 @@ float sdsd_control_with_sensor_check(void);
 //-------------------------------------------------------------------------------------------------------------------
 float pd_control_with_sensor_check(void);
 
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     控制模式初始化
+// 参数说明     void
+// 返回参数     void
+// 使用示例     control_mode_init();
+// 备注信息     调用模式表中每个模式的 init (SDSD、方向环PD、四元数姿态控制器的参数)，再选择上电后的模式
+//              在开启控制定时中断之前调用
+//-------------------------------------------------------------------------------------------------------------------
+void control_mode_init(void);
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     请求切换控制模式
+// 参数说明     mode            目标控制模式
+// 返回参数     void
+// 使用示例     control_mode_request(CONTROL_MODE_SDSD);
+// 备注信息     在主循环中调用，下一个控制周期生效 (复位新模式的控制器，输出平滑过渡)
+//              CONTROL_SELECT_METHOD_KEY 以外的选择方式忽略请求
+//-------------------------------------------------------------------------------------------------------------------
+void control_mode_request(uint8 mode);
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     请求切换到下一个控制模式
+// 参数说明     void
+// 返回参数     void
+// 使用示例     control_mode_next();
+// 备注信息     按键切换使用，最后一个模式之后回到第一个
+//-------------------------------------------------------------------------------------------------------------------
+void control_mode_next(void);
+
 //-------------------------------------------------------------------------------------------------------------------
 // 函数简介     获取当前控制模式
 // 参数说明     void
@@ -102,23 +199,63 @@ uint8 get_control_mode(void);
 char* get_mode_name(uint8 mode);
 
 //-------------------------------------------------------------------------------------------------------------------
-// 函数简介     电机控制任务(10ms周期调用)
+// 函数简介     方向控制任务
 // 参数说明     void
 // 返回参数     void
-// 使用示例     motor_control_task();
-// 备注信息     在10ms定时中断中调用，完成编码器采集和电机控制
-//              功能: 编码器采集 -> 控制算法选择 -> 电机输出
-//              控制模式由 task.h 中的 CONTROL_MODE_CURRENT 决定
+// 使用示例     direction_control_task();
+// 备注信息     由调度器在节拍中断中按 CONTROL_DIRECTION_PERIOD 周期调用，在同一节拍的速度控制任务之前执行
+//              功能: ADC采样帧更新 -> 控制模式选择 -> 控制算法 -> 差速修正值
+//              控制模式由 task.h 中的 CONTROL_SELECT_METHOD 和 CONTROL_MODE_CURRENT 决定
+//-------------------------------------------------------------------------------------------------------------------
+void direction_control_task(void);
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     速度控制任务
+// 参数说明     void
+// 返回参数     void
+// 使用示例     speed_control_task();
+// 备注信息     由调度器在节拍中断中按 CONTROL_SPEED_PERIOD 周期调用
+//              功能: 编码器采集 -> 叠加方向控制的差速修正值 -> 电机PID -> 电机输出
+//              严重超时后不再输出，OVERRUN_ACTION_HOLD_PWM 时超时后的一个周期不计算速度环
+//-------------------------------------------------------------------------------------------------------------------
+void speed_control_task(void);
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     控制任务超时处理
+// 参数说明     index           超出预算的前台任务下标 (main.c 中的任务表)
+// 参数说明     us              执行时间 (us)
+// 返回参数     void
+// 使用示例     sched_overrun_handler = control_overrun_handler;
+// 备注信息     由调度器在节拍中断中调用，按 OVERRUN_POLICY 开始降级处理
+//              执行时间超过 OVERRUN_HARD_US 或降级期间累计超时 OVERRUN_HARD_COUNT 次时立即停止电机，之后不再输出 (重新上电恢复)
+//-------------------------------------------------------------------------------------------------------------------
+void control_overrun_handler(uint8 index, uint16 us);
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     获取超时处理状态
+// 参数说明     void
+// 返回参数     uint8           正在生效的 OVERRUN_ACTION_SKIP_OPTIONAL / OVERRUN_ACTION_DEGRADE 和 OVERRUN_FLAG_FAULT，0-正常
+// 使用示例     if(control_overrun_flags() & OVERRUN_ACTION_SKIP_OPTIONAL) { ... }
+// 备注信息     可在主循环中调用
+//-------------------------------------------------------------------------------------------------------------------
+uint8 control_overrun_flags(void);
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     获取超时次数
+// 参数说明     void
+// 返回参数     uint16          上电后的超时次数 (各前台任务的总和)
+// 使用示例     printf("overrun %u\r\n", control_overrun_count());
+// 备注信息     可在主循环中调用，各任务的次数由 scheduler_get_stat() 读取
 //-------------------------------------------------------------------------------------------------------------------
-void motor_control_task(void);
+uint16 control_overrun_count(void);
 
 //-------------------------------------------------------------------------------------------------------------------
-// 函数简介     IMU更新任务(50ms周期调用)
+// 函数简介     IMU更新任务
 // 参数说明     void
 // 返回参数     void
 // 使用示例     imu_update_task();
-// 备注信息     在50ms定时中断中调用，更新IMU数据
-//              功能: 获取IMU原始数据 -> 四元数解算 -> 欧拉角更新
+// 备注信息     IMU_USE_FIFO 为1时在IMU660RB FIFO水位外部中断中调用 (约9.6ms一次)，否则由调度器按 IMU_UPDATE_PERIOD 周期调用
+//              功能: 获取IMU原始数据 -> 四元数解算 (欧拉角在读取时由 imu_get_euler 计算)
 //-------------------------------------------------------------------------------------------------------------------
 void imu_update_task(void);
 
@@ -0,0 +1,92 @@
+//-------------------------------------------------------------------------------------------------------------------
+// 头文件包含
+//-------------------------------------------------------------------------------------------------------------------
+#include "timebase.h"
+
+//-------------------------------------------------------------------------------------------------------------------
+// 私有变量
+//-------------------------------------------------------------------------------------------------------------------
+static vuint16 timebase_high = 0;                               // 时间高16位 (溢出中断中加1)
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     时间基准初始化
+// 参数说明     void
+// 返回参数     void
+// 使用示例     timebase_init();
+// 备注信息     TIM4: 1T 模式，预分频到 1MHz，重装载值为0 (65536 计数溢出)，使能溢出中断
+//-------------------------------------------------------------------------------------------------------------------
+void timebase_init(void)
+{
+    timebase_high = 0;
+
+    T4T3M &= ~0x80;                                         // 停止定时器
+    T4T3M |= 0x20;                                          // 1T 模式
+    TM4PS = (uint8)(system_clock / 1000000 - 1);            // 设置分频值
+    T4L = 0;
+    T4H = 0;
+    TIM4_CLEAR_FLAG;
+    IE2 |= 0x40;                                            // 使能定时器中断
+    T4T3M |= 0x80;                                          // 启动定时器
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     计时定时器溢出处理
+// 参数说明     void
+// 返回参数     void
+// 使用示例     tim4_irq_handler = timebase_overflow_handler;
+// 备注信息     在 TIMEBASE_TIMER 中断中调用 (isr.c 已清除溢出标志)
+//-------------------------------------------------------------------------------------------------------------------
+void timebase_overflow_handler(void)
+{
+    timebase_high++;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     读取当前时间的低16位
+// 参数说明     void
+// 返回参数     uint16          计数值 (us，65.536ms 回绕)
+// 使用示例     uint16 t = timebase_now_us16();
+// 备注信息     高字节前后读两次，相同时低字节有效
+//-------------------------------------------------------------------------------------------------------------------
+uint16 timebase_now_us16(void)
+{
+    uint8 high;
+    uint8 low;
+
+    do
+    {
+        high = T4H;
+        low = T4L;
+    }while(high != T4H);
+
+    return ((uint16)high << 8) | low;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     读取当前时间
+// 参数说明     void
+// 返回参数     uint32          上电后的时间 (us，约71.6分钟回绕)
+// 使用示例     uint32 t = timebase_now_us();
+// 备注信息     高16位前后读两次，相同时 (期间没有执行溢出中断) 计数值和溢出标志有效
+//              溢出标志置位说明溢出中断还没有执行，计数值较小时是溢出之后读到的，高16位补加1
+//-------------------------------------------------------------------------------------------------------------------
+uint32 timebase_now_us(void)
+{
+    uint16 high;
+    uint16 low;
+    uint8 pending;
+
+    do
+    {
+        high = timebase_high;
+        low = timebase_now_us16();
+        pending = AUXINTIF & 0x04;                          // 定时器4溢出标志
+    }while(high != timebase_high);
+
+    if(pending && low < 0x8000)
+    {
+        high++;
+    }
+
+    return ((uint32)high << 16) | low;
+}
@@ -0,0 +1,63 @@
+#ifndef _TIMEBASE_H_
+#define _TIMEBASE_H_
+
+//-------------------------------------------------------------------------------------------------------------------
+// 头文件包含
+//-------------------------------------------------------------------------------------------------------------------
+#include "zf_common_headfile.h"
+
+//-------------------------------------------------------------------------------------------------------------------
+// 说明
+//-------------------------------------------------------------------------------------------------------------------
+// 微秒时间基准: TIMEBASE_TIMER 以 1MHz 自由运行 (16位计数，65.536ms 溢出一次)
+//   溢出中断只把高16位加1，timebase_now_us() 拼成32位微秒时间 (约71.6分钟回绕，时间差用 uint32 相减)
+//   读取时溢出中断还没有执行 (在其他中断中调用，或溢出刚好发生) 由溢出标志补上，中断和主循环中都可以调用
+// 用于采样时间戳 (IMU / ADC帧 / 编码器) 和执行时间测量 (profiler)
+
+//-------------------------------------------------------------------------------------------------------------------
+// 宏定义
+//-------------------------------------------------------------------------------------------------------------------
+#define TIMEBASE_TIMER              (TIM4_PIT)  // 计时定时器 如果修改 需要同步修改 main.c 中的 timx_irq_handler 和 timebase.c 中的计数寄存器
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数声明
+//-------------------------------------------------------------------------------------------------------------------
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     时间基准初始化
+// 参数说明     void
+// 返回参数     void
+// 使用示例     timebase_init();
+// 备注信息     调用前先设置 TIMEBASE_TIMER 对应的 timx_irq_handler = timebase_overflow_handler
+//              在使用时间戳的模块开始工作之前调用
+//-------------------------------------------------------------------------------------------------------------------
+void timebase_init(void);
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     计时定时器溢出处理
+// 参数说明     void
+// 返回参数     void
+// 使用示例     tim4_irq_handler = timebase_overflow_handler;
+// 备注信息     在 TIMEBASE_TIMER 中断中调用，高16位加1
+//-------------------------------------------------------------------------------------------------------------------
+void timebase_overflow_handler(void);
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     读取当前时间
+// 参数说明     void
+// 返回参数     uint32          上电后的时间 (us，约71.6分钟回绕)
+// 使用示例     uint32 t = timebase_now_us();
+// 备注信息     中断和主循环中都可以调用
+//-------------------------------------------------------------------------------------------------------------------
+uint32 timebase_now_us(void);
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     读取当前时间的低16位
+// 参数说明     void
+// 返回参数     uint16          计数值 (us，65.536ms 回绕)
+// 使用示例     uint16 t = timebase_now_us16();
+// 备注信息     只读计数寄存器，比 timebase_now_us() 快，用于测量不超过 65ms 的时间差 (uint16 相减)
+//-------------------------------------------------------------------------------------------------------------------
+uint16 timebase_now_us16(void);
+
+#endif
@@ -0,0 +1,108 @@
+//-------------------------------------------------------------------------------------------------------------------
+// 头文件包含
+//-------------------------------------------------------------------------------------------------------------------
+#include "track_metrics.h"
+
+//-------------------------------------------------------------------------------------------------------------------
+// 私有变量
+//-------------------------------------------------------------------------------------------------------------------
+static track_metrics_t track_metrics;                           // 控制中断中更新的统计
+static vuint8 track_lap_request = 0;                            // 主循环请求结束当前圈
+
+// 统计快照 (每个控制周期发布)
+static track_metrics_t track_snap_bank[2];
+static snapshot_t track_snap = {{&track_snap_bank[0], &track_snap_bank[1]}, sizeof(track_metrics_t), 0, 0};
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     赛道误差统计更新
+// 参数说明     err             本周期传感器位置误差 (position_error_calc)
+// 参数说明     valid           本周期传感器是否有效
+// 返回参数     void
+// 使用示例     Track_Metrics_Update(position_error_calc(), sensor_check_valid());
+// 备注信息     传感器无效的周期只计时，不计入误差统计
+//-------------------------------------------------------------------------------------------------------------------
+void Track_Metrics_Update(float err, uint8 valid)
+{
+    if(track_lap_request)
+    {
+        track_lap_request = 0;
+        track_metrics.last_lap = track_metrics.current;
+        memset(&track_metrics.current, 0, sizeof(track_run_t));
+        track_metrics.laps++;
+    }
+
+    track_metrics.current.ticks++;
+    if(valid)
+    {
+        if(err < 0.0f)
+        {
+            err = -err;
+        }
+        track_metrics.current.sensor_sq_sum += err * err;
+        if(err > track_metrics.current.sensor_peak)
+        {
+            track_metrics.current.sensor_peak = err;
+        }
+    }
+    else
+    {
+        track_metrics.current.lost_ticks++;
+    }
+
+    snapshot_publish(&track_snap, &track_metrics);
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     标记一圈结束
+// 参数说明     void
+// 返回参数     void
+// 使用示例     Track_Metrics_Lap();
+// 备注信息     只置位请求标志，由控制中断完成切换，主循环不直接修改统计数据
+//-------------------------------------------------------------------------------------------------------------------
+void Track_Metrics_Lap(void)
+{
+    track_lap_request = 1;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     获取赛道误差统计快照
+// 参数说明     out             输出 当前圈和上一圈的统计
+// 返回参数     void
+// 使用示例     Track_Metrics_Snapshot(&metrics);
+// 备注信息     可在主循环中调用，不关闭中断
+//-------------------------------------------------------------------------------------------------------------------
+void Track_Metrics_Snapshot(track_metrics_t *out)
+{
+    snapshot_read(&track_snap, out);
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     计算一圈的传感器位置误差均方根
+// 参数说明     run             一圈的统计
+// 返回参数     float           传感器位置误差均方根值，没有有效周期时返回0
+// 使用示例     float sensor_rms = track_run_sensor_rms(&metrics.last_lap);
+// 备注信息     只在主循环中调用
+//-------------------------------------------------------------------------------------------------------------------
+float track_run_sensor_rms(const track_run_t *run)
+{
+    uint32 valid_ticks;
+
+    valid_ticks = run->ticks - run->lost_ticks;
+    if(valid_ticks == 0)
+    {
+        return 0.0f;
+    }
+    return fast_sqrt(run->sensor_sq_sum / (float)valid_ticks);
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     计算一圈的用时
+// 参数说明     run             一圈的统计
+// 返回参数     float           用时 (秒)
+// 使用示例     float t = track_run_time(&metrics.last_lap);
+// 备注信息     包含传感器无效的周期
+//-------------------------------------------------------------------------------------------------------------------
+float track_run_time(const track_run_t *run)
+{
+    return (float)run->ticks * (TRACK_METRICS_PERIOD_MS / 1000.0f);
+}
@@ -0,0 +1,98 @@
+#ifndef _TRACK_METRICS_H_
+#define _TRACK_METRICS_H_
+
+//-------------------------------------------------------------------------------------------------------------------
+// 头文件包含
+//-------------------------------------------------------------------------------------------------------------------
+#include "zf_common_headfile.h"
+
+//-------------------------------------------------------------------------------------------------------------------
+// 说明
+//-------------------------------------------------------------------------------------------------------------------
+// 每圈统计圈时、传感器无效的周期数和传感器位置误差的均方根 / 峰值
+//   误差是传感器位置误差 position_error_calc() (中间电感归一化值减中心值，±25)，不是车到导线的横向偏差:
+//   中间电感在导线正上方时读数最大，居中行驶时该值接近上限而不是0，只能比较同一赛道上同一组传感器的相对变化
+//   横向偏差 (mm) 只有主机仿真能给出 (sim_main.c 的 cte)，比较控制效果以仿真为准
+
+//-------------------------------------------------------------------------------------------------------------------
+// 宏定义
+//-------------------------------------------------------------------------------------------------------------------
+// 上车统计开关: 1-方向控制任务每周期统计误差，PID菜单普通界面 KEY4 标记一圈结束并由串口输出
+// 默认关闭，不占用控制中断时间；调参时优先用主机仿真 (Project/host/sim) 比较控制效果，仿真编译时打开
+#ifndef TRACK_METRICS_ENABLE
+#define TRACK_METRICS_ENABLE        (0)
+#endif
+
+#define TRACK_METRICS_PERIOD_MS     (CONTROL_DIRECTION_PERIOD * SCHED_TICK_MS)   // 统计周期 (ms，方向控制任务周期)
+
+//-------------------------------------------------------------------------------------------------------------------
+// 数据结构
+//-------------------------------------------------------------------------------------------------------------------
+typedef struct
+{
+    uint32 ticks;                         // 统计的控制周期数
+    uint32 lost_ticks;                    // 传感器无效的周期数 (不计入误差统计)
+    float sensor_sq_sum;                  // 传感器位置误差平方和
+    float sensor_peak;                    // 传感器位置误差绝对值最大值
+} track_run_t;
+
+typedef struct
+{
+    track_run_t current;                  // 当前圈
+    track_run_t last_lap;                 // 上一圈
+    uint16 laps;                          // 已完成圈数
+} track_metrics_t;
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数声明
+//-------------------------------------------------------------------------------------------------------------------
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     赛道误差统计更新
+// 参数说明     err             本周期传感器位置误差 (position_error_calc)
+// 参数说明     valid           本周期传感器是否有效
+// 返回参数     void
+// 使用示例     Track_Metrics_Update(position_error_calc(), sensor_check_valid());
+// 备注信息     TRACK_METRICS_ENABLE 为1时在10ms控制中断中每周期调用一次
+//              有 Track_Metrics_Lap() 的请求时先结束当前圈再统计本周期
+//-------------------------------------------------------------------------------------------------------------------
+void Track_Metrics_Update(float err, uint8 valid);
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     标记一圈结束
+// 参数说明     void
+// 返回参数     void
+// 使用示例     Track_Metrics_Lap();
+// 备注信息     在主循环中调用(按键或起跑线检测)，下一个控制周期生效
+//              当前圈的统计移入 last_lap，圈数加1，然后重新开始统计
+//-------------------------------------------------------------------------------------------------------------------
+void Track_Metrics_Lap(void);
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     获取赛道误差统计快照
+// 参数说明     out             输出 当前圈和上一圈的统计
+// 返回参数     void
+// 使用示例     Track_Metrics_Snapshot(&metrics);
+// 备注信息     可在主循环中调用，不关闭中断
+//-------------------------------------------------------------------------------------------------------------------
+void Track_Metrics_Snapshot(track_metrics_t *out);
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     计算一圈的传感器位置误差均方根
+// 参数说明     run             一圈的统计
+// 返回参数     float           传感器位置误差均方根值，没有有效周期时返回0
+// 使用示例     float sensor_rms = track_run_sensor_rms(&metrics.last_lap);
+// 备注信息     只在主循环中调用
+//-------------------------------------------------------------------------------------------------------------------
+float track_run_sensor_rms(const track_run_t *run);
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     计算一圈的用时
+// 参数说明     run             一圈的统计
+// 返回参数     float           用时 (秒)
+// 使用示例     float t = track_run_time(&metrics.last_lap);
+// 备注信息     包含传感器无效的周期
+//-------------------------------------------------------------------------------------------------------------------
+float track_run_time(const track_run_t *run);
+
+#endif
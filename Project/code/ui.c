@@ -29,6 +29,8 @@ static void display_menu_normal(void);
 static void display_menu_edit(void);
 static void display_menu_save(void);
 static void display_edit_value(uint8 show);
+static void display_menu_calib(void);
+static void display_calib_value(void);
 
 /*==================================================================================================================*/
 /* =============== UI 基础函数 =============== */
@@ -263,6 +265,7 @@ void UI_MenuInit(void)
     menu.value = UI_MenuGetItemValue(menu.item);
     menu.blink_cnt = 0;
     menu.save_cnt = 0;
+    menu.calib_result = ADC_CALIB_OK;
 
     // 初始显示
     display_menu_normal();
@@ -299,12 +302,43 @@ void UI_MenuUpdate(void)
     // 状态机处理
     if(menu.state == UI_MENU_NORMAL)
     {
-        // 普通模式：KEY1 进入编辑模式
+        // 普通模式：KEY1 进入编辑模式，KEY2 进入 ADC 扫描校准，KEY3 切换控制模式，KEY4 标记一圈结束 (TRACK_METRICS_ENABLE)
         if(key_down == KEY1)
         {
             UI_MenuEnterEdit();
             need_redraw = 1;
         }
+        else if(key_down == KEY2)
+        {
+            UI_MenuEnterCalib();
+            need_redraw = 1;
+        }
+        else if(key_down == KEY3)
+        {
+            // 下一个控制周期切换到下一个控制模式 (CONTROL_SELECT_METHOD_KEY 时有效)
+            control_mode_next();
+        }
+#if(TRACK_METRICS_ENABLE)
+        else if(key_down == KEY4)
+        {
+            // 标记一圈结束，串口输出本圈用时和误差统计
+            Track_Metrics_Lap();
+        }
+#endif
+    }
+    else if(menu.state == UI_MENU_CALIB)
+    {
+        // 校准模式：KEY4 保存，KEY1 放弃
+        if(key_down == KEY4)
+        {
+            UI_MenuExitCalib(1);
+            need_redraw = 1;
+        }
+        else if(key_down == KEY1)
+        {
+            UI_MenuExitCalib(0);
+            need_redraw = 1;
+        }
     }
     else if(menu.state == UI_MENU_EDIT)
     {
@@ -353,6 +387,18 @@ void UI_MenuUpdate(void)
             display_menu_edit();  // 完整重绘
         }
     }
+    else if(menu.state == UI_MENU_CALIB)
+    {
+        // 校准模式：每次调用刷新记录的跨度
+        if(need_redraw)
+        {
+            display_menu_calib();
+        }
+        else
+        {
+            display_calib_value();
+        }
+    }
     else  // UI_MENU_NORMAL
     {
         if(need_redraw) display_menu_normal();
@@ -386,10 +432,41 @@ void UI_MenuExitEdit(void)
 void UI_MenuSave(void)
 {
     myeeprom_save_speed_pid(&pid_motor_left, &pid_motor_right);
+    menu.calib_result = ADC_CALIB_OK;
     menu.state = UI_MENU_SAVE;
     menu.save_cnt = MENU_SAVE_DELAY;
 }
 
+/**
+ * @brief       进入 ADC 扫描校准
+ * @note        进入后左右扫动车体，使每个电感都经过导线正上方和远离导线的位置
+ */
+void UI_MenuEnterCalib(void)
+{
+    Adc_Calib_Start();
+    menu.state = UI_MENU_CALIB;
+}
+
+/**
+ * @brief       退出 ADC 扫描校准
+ * @param   save    1=检查并保存校准结果, 0=放弃本次校准
+ */
+void UI_MenuExitCalib(uint8 save)
+{
+    if(save)
+    {
+        // 显示保存结果，失败时显示错误码，原校准表保持不变
+        menu.calib_result = Adc_Calib_Finish();
+        menu.state = UI_MENU_SAVE;
+        menu.save_cnt = MENU_SAVE_DELAY;
+    }
+    else
+    {
+        Adc_Calib_Cancel();
+        menu.state = UI_MENU_NORMAL;
+    }
+}
+
 /**
  * @brief       增加当前参数值
  * @param   step    步进值
@@ -404,6 +481,8 @@ void UI_MenuIncrease(float step)
         {
             *menu.value = 10.0f;
         }
+        // 速度环使用定点PID时，修改后立即同步，调参实时生效
+        pid_fixed_sync_motor();
     }
 }
 
@@ -421,6 +500,8 @@ void UI_MenuDecrease(float step)
         {
             *menu.value = 0.0f;
         }
+        // 速度环使用定点PID时，修改后立即同步，调参实时生效
+        pid_fixed_sync_motor();
     }
 }
 
@@ -503,8 +584,12 @@ static void display_menu_normal(void)
     OLED_ShowString(UI_TITLE_LINE, 1, "PID MENU");
     OLED_ShowString(UI_TITLE_LINE, 10, "K1=Edit");
 
-    // 第3行: 提示信息
-    OLED_ShowString(3, 1, "KEY1=Edit");
+    // 第2-4行: 提示信息
+#if(TRACK_METRICS_ENABLE)
+    OLED_ShowString(2, 1, "KEY4=Lap Mark");
+#endif
+    OLED_ShowString(3, 1, "K1=Edit K3=Mode");
+    OLED_ShowString(4, 1, "KEY2=ADC Calib");
 }
 
 /**
@@ -577,5 +662,56 @@ static void display_edit_value(uint8 show)
 static void display_menu_save(void)
 {
     OLED_Clear();
-    OLED_ShowString(2, 5, "SAVED!");
+    if(menu.calib_result == ADC_CALIB_OK)
+    {
+        OLED_ShowString(2, 5, "SAVED!");
+    }
+    else
+    {
+        // 1=帧数不足 2=跨度不足 3=EEPROM写入失败
+        OLED_ShowString(2, 3, "CALIB FAIL");
+        OLED_ShowNum(2, 14, menu.calib_result, 1);
+    }
+}
+
+/**
+ * @brief       显示 ADC 扫描校准界面
+ */
+static void display_menu_calib(void)
+{
+    OLED_Clear();
+
+    // 标题行: "ADC CALIB K4=Ok"
+    OLED_ShowString(UI_TITLE_LINE, 1, "ADC CALIB");
+    OLED_ShowString(UI_TITLE_LINE, 11, "K4=Ok");
+
+    // 第2-4行: 各通道当前记录的跨度 (max-min)
+    OLED_ShowString(2, 1, "L1:");
+    OLED_ShowString(2, 9, "L2:");
+    OLED_ShowString(3, 1, "M3:");
+    OLED_ShowString(3, 9, "R4:");
+    OLED_ShowString(4, 1, "R5:");
+    OLED_ShowString(4, 9, "K1=Esc");
+
+    display_calib_value();
+}
+
+/**
+ * @brief       只更新校准界面的跨度数值
+ */
+static void display_calib_value(void)
+{
+    uint16 max;
+    uint16 min;
+    uint16 span;
+    uint8 i;
+
+    for(i = 0; i < CHANNEL_NUMBER; i++)
+    {
+        Adc_Calib_Get(i, &max, &min);
+        span = (max > min) ? (max - min) : 0;
+
+        // 通道 i 显示在第 2+i/2 行，偶数通道在左半屏，奇数通道在右半屏
+        OLED_ShowNum(2 + i / 2, (i % 2) ? 12 : 4, span, 4);
+    }
 }
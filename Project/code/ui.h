@@ -37,7 +37,8 @@ typedef enum
 {
     UI_MENU_NORMAL = 0,      // 普通显示模式
     UI_MENU_EDIT,            // 编辑模式
-    UI_MENU_SAVE             // 保存提示
+    UI_MENU_SAVE,            // 保存提示
+    UI_MENU_CALIB            // ADC 扫描校准
 } ui_menu_state_t;
 
 /** PID 参数项 */
@@ -60,6 +61,7 @@ typedef struct
     float *value;            // 当前参数值指针
     uint8 blink_cnt;         // 闪烁计数器
     uint8 save_cnt;          // 保存提示计数器
+    uint8 calib_result;      // 最近一次校准结果 (ADC_CALIB_OK 或 ADC_CALIB_ERR_xxx)
 } ui_menu_t;
 
 /** 菜单配置 */
@@ -154,6 +156,18 @@ void UI_MenuExitEdit(void);
  */
 void UI_MenuSave(void);
 
+/**
+ * @brief       进入 ADC 扫描校准
+ * @note        进入后左右扫动车体，使每个电感都经过导线正上方和远离导线的位置
+ */
+void UI_MenuEnterCalib(void);
+
+/**
+ * @brief       退出 ADC 扫描校准
+ * @param   save    1=检查并保存校准结果, 0=放弃本次校准
+ */
+void UI_MenuExitCalib(uint8 save);
+
 /**
  * @brief       增加当前参数值
  * @param   step    步进值
@@ -0,0 +1,56 @@
+//-------------------------------------------------------------------------------------------------------------------
+// 头文件包含
+//-------------------------------------------------------------------------------------------------------------------
+#include "host_bench.h"
+#include "myeeprom.h"
+
+//-------------------------------------------------------------------------------------------------------------------
+// 宏定义
+//-------------------------------------------------------------------------------------------------------------------
+#define BENCH_CONTROL_LOOPS     (200000)
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     一个控制节拍 (方向控制 + 速度控制) 的耗时和 ADC 转换次数
+// 备注信息     初始化顺序与 main() 相同，ADC 输入为固定的居中值，编码器为固定速度
+//              每个节拍之前后台扫描完成一帧，计时包含扫描中断
+//-------------------------------------------------------------------------------------------------------------------
+void bench_control_tick(void)
+{
+    double t0;
+    double t1;
+    uint32 i;
+    uint32 convert;
+
+    myeeprom_init();
+    Motor_Init();
+    mock_adc_value[ADC_CH6_P16] = 1200;
+    mock_adc_value[ADC_CH0_P10] = 1800;
+    mock_adc_value[ADC_CH1_P11] = 2600;
+    mock_adc_value[ADC_CH13_P05] = 1800;
+    mock_adc_value[ADC_CH14_P06] = 1200;
+    mock_adc_irq_handler = Adc_Scan_Isr;
+    Adc_All_Init();
+    Encoder_Init();
+    imu_init();
+    control_mode_init();
+    myeeprom_load_speed_pid(&pid_motor_left, &pid_motor_right);
+    pid_motor_left.target = 30.0f;
+    pid_motor_right.target = 30.0f;
+    pid_fixed_sync_motor();
+
+    convert = mock_adc_convert_count;
+    t0 = host_bench_now_ns();
+    for(i = 0; i < BENCH_CONTROL_LOOPS; i++)
+    {
+        mock_set_time_us(i * CONTROL_DIRECTION_PERIOD * 1000);
+        mock_adc_run(CHANNEL_NUMBER * ADC_SCAN_DEPTH);
+        mock_encoder_count[TIM0_ENCOEDER] = 30;
+        mock_encoder_count[TIM3_ENCOEDER] = 30;
+        direction_control_task();
+        speed_control_task();
+    }
+    t1 = host_bench_now_ns();
+
+    host_bench_report("direction + speed task", t1 - t0, BENCH_CONTROL_LOOPS);
+    printf("  adc conversions per tick %.2f\r\n", (double)(mock_adc_convert_count - convert) / BENCH_CONTROL_LOOPS);
+}
@@ -0,0 +1,306 @@
+//-------------------------------------------------------------------------------------------------------------------
+// 头文件包含
+//-------------------------------------------------------------------------------------------------------------------
+#include "host_bench.h"
+
+//-------------------------------------------------------------------------------------------------------------------
+// 说明
+//-------------------------------------------------------------------------------------------------------------------
+// fastmath 每个函数在定义域上的误差、单次调用的浮点运算次数和主机耗时，用于按调用位置选择精度和速度
+//   误差: 定义域上均匀取 BENCH_FASTMATH_POINTS 个点 (fast_inv_sqrt 按对数均匀)，与 double 的 math.h 对照，
+//         fast_inv_sqrt 为相对误差，其余为绝对误差 (sin/cos 无单位，反三角函数 rad)；atan2 为单位圆上一周
+//   运算次数: 按源代码统计的浮点乘/加减/除 (比较、取绝对值、整数运算和类型转换不计)，
+//            atan2 的象限修正另外最多2次加减。C251 没有FPU，车上的耗时主要由这些软件浮点运算决定
+//   主机耗时只用于同一台机器上的相对比较 (有硬件浮点)，车上的耗时用 profiler 测量
+// atan2 三种实现对比 (Quaternion_ToEuler / Quaternion_ToYaw 的选择依据)
+//   输入为固定种子的随机单位四元数按航向公式算出的 (y, x)，与欧拉角输出的调用方式相同
+//   bench_legacy_atan2 是换成 fastmath 之前 quaternion.c 的 my_atan2，原样保留作对照
+//   主机有硬件浮点，查表的浮点转整数和取表反而显得不便宜；C251 上每次软件浮点乘法远比取表贵，以运算次数为准
+
+//-------------------------------------------------------------------------------------------------------------------
+// 宏定义
+//-------------------------------------------------------------------------------------------------------------------
+#define BENCH_FASTMATH_POINTS   (1000000L)
+#define BENCH_FASTMATH_INPUTS   (4096)
+#define BENCH_FASTMATH_LOOPS    (4000000L)
+#define BENCH_ATAN2_QUATS       (4096)
+#define BENCH_ATAN2_LOOPS       (1000)                          // 每轮计算全部 BENCH_ATAN2_QUATS 个输入
+
+//-------------------------------------------------------------------------------------------------------------------
+// 数据结构
+//-------------------------------------------------------------------------------------------------------------------
+typedef struct
+{
+    const char *name;
+    float (*func)(float x);               // 单参数函数 (双参数时为 NULL)
+    float (*func2)(float y, float x);     // 双参数函数: 输入为单位圆上的角度
+    double (*ref)(double x);              // 参考函数 (双参数时为 NULL，用 atan2)
+    double lo;                            // 定义域 (双参数时为角度 rad)
+    double hi;
+    uint8 log_domain;                     // 1-对数均匀取点，相对误差
+    uint8 mul;                            // 浮点乘法次数
+    uint8 add;                            // 浮点加减次数 (不含象限修正)
+    uint8 div;                            // 浮点除法次数
+} bench_fastmath_item_t;
+
+//-------------------------------------------------------------------------------------------------------------------
+// 私有变量
+//-------------------------------------------------------------------------------------------------------------------
+static double bench_inv_sqrt_ref(double x)
+{
+    return 1.0 / sqrt(x);
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     换成 fastmath 之前的 my_atan2 (1除2乘1加，|y| > |x| 时再加1次减法，加上最多2次象限修正)
+//-------------------------------------------------------------------------------------------------------------------
+static float bench_legacy_atan2(float y, float x)
+{
+    float abs_x, abs_y, angle, r;
+
+    if(x == 0.0f && y == 0.0f)
+    {
+        return 0.0f;
+    }
+
+    abs_x = x >= 0 ? x : -x;
+    abs_y = y >= 0 ? y : -y;
+
+    if(abs_y > abs_x)
+    {
+        r = abs_x / abs_y;
+        angle = 1.57079633f - r * (0.1963f + r * -0.9817f);
+    }
+    else
+    {
+        r = abs_y / abs_x;
+        angle = r * (0.1963f + r * -0.9817f);
+    }
+
+    if(x < 0) angle = 3.14159265f - angle;
+    if(y < 0) angle = -angle;
+
+    return angle;
+}
+
+typedef float (*bench_atan2_func)(float y, float x);
+
+static const char *const bench_atan2_name[3] = {"fast_atan2_table", "fast_atan2", "my_atan2 (legacy)"};
+static const bench_atan2_func bench_atan2_list[3] = {fast_atan2_table, fast_atan2, bench_legacy_atan2};
+static const uint8 bench_atan2_ops[3][3] = {{2, 3, 1}, {6, 4, 1}, {2, 1, 1}};     // 乘 加减 除 (不含象限修正)
+
+static uint32 bench_atan2_seed = 1;
+
+static double bench_atan2_rand(void)
+{
+    bench_atan2_seed = bench_atan2_seed * 1103515245u + 12345u;
+    return (double)((bench_atan2_seed >> 8) & 0xFFFF) / 32768.0 - 1.0;
+}
+
+// 运算次数: fast_inv_sqrt 1 + 3*迭代次数 乘、迭代次数 减；fast_sqrt 再加1次乘法
+//          fast_sin 3乘 4加减 (x < 0 时多1次)，fast_cos 再加1次
+//          fast_asin 多项式 3乘3加、1-x、π/2-sqrt*多项式，加上 fast_sqrt
+//          fast_atan2 比值1除、r² 和9次奇多项式 6乘4加；fast_atan2_table 比值1除、查表插值 2乘3加减
+static const bench_fastmath_item_t bench_fastmath_list[] =
+{
+    {"fast_inv_sqrt",    fast_inv_sqrt, NULL,             bench_inv_sqrt_ref, 1e-6,     1e6,    1, 1 + 3 * FAST_INV_SQRT_ITER, FAST_INV_SQRT_ITER,     0},
+    {"fast_sin",         fast_sin,      NULL,             sin,                -8*M_PI,  8*M_PI, 0, 3,                          4,                      0},
+    {"fast_cos",         fast_cos,      NULL,             cos,                -8*M_PI,  8*M_PI, 0, 3,                          5,                      0},
+    {"fast_asin",        fast_asin,     NULL,             asin,               -1.0,     1.0,    0, 6 + 3 * FAST_INV_SQRT_ITER, 5 + FAST_INV_SQRT_ITER, 0},
+    {"fast_atan2",       NULL,          fast_atan2,       NULL,               -M_PI,    M_PI,   0, 6,                          4,                      1},
+    {"fast_atan2_table", NULL,          fast_atan2_table, NULL,               -M_PI,    M_PI,   0, 2,                          3,                      1},
+};
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     定义域上第 i 个点
+//-------------------------------------------------------------------------------------------------------------------
+static double bench_fastmath_point(const bench_fastmath_item_t *item, long i, long n)
+{
+    if(item->log_domain)
+    {
+        return pow(10.0, log10(item->lo) + (log10(item->hi) - log10(item->lo)) * i / n);
+    }
+    return item->lo + (item->hi - item->lo) * i / n;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     计算一个点的误差
+//-------------------------------------------------------------------------------------------------------------------
+static double bench_fastmath_error(const bench_fastmath_item_t *item, double p)
+{
+    float x;
+    float y;
+    double err;
+
+    if(item->func2 != NULL)
+    {
+        y = (float)sin(p);
+        x = (float)cos(p);
+        err = fabs(item->func2(y, x) - atan2((double)y, (double)x));
+        return (err > M_PI) ? (2 * M_PI - err) : err;   // ±π 两侧是同一个角度
+    }
+
+    x = (float)p;
+    if(item->log_domain)
+    {
+        return fabs(item->func(x) / item->ref((double)x) - 1);
+    }
+    return fabs(item->func(x) - item->ref((double)x));
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     主机耗时 (ns/次)
+//-------------------------------------------------------------------------------------------------------------------
+static double bench_fastmath_time(const bench_fastmath_item_t *item, float *sink)
+{
+    static float in_x[BENCH_FASTMATH_INPUTS];
+    static float in_y[BENCH_FASTMATH_INPUTS];
+    double p;
+    double t0;
+    double t1;
+    float sum;
+    long i;
+
+    for(i = 0; i < BENCH_FASTMATH_INPUTS; i++)
+    {
+        // 打乱取点顺序，避免分支总是同一方向
+        p = bench_fastmath_point(item, (i * 1237L) % BENCH_FASTMATH_INPUTS, BENCH_FASTMATH_INPUTS);
+        in_x[i] = (item->func2 != NULL) ? (float)cos(p) : (float)p;
+        in_y[i] = (float)sin(p);
+    }
+
+    sum = 0;
+    t0 = host_bench_now_ns();
+    if(item->func2 != NULL)
+    {
+        for(i = 0; i < BENCH_FASTMATH_LOOPS; i++)
+        {
+            sum += item->func2(in_y[i % BENCH_FASTMATH_INPUTS], in_x[i % BENCH_FASTMATH_INPUTS]);
+        }
+    }
+    else
+    {
+        for(i = 0; i < BENCH_FASTMATH_LOOPS; i++)
+        {
+            sum += item->func(in_x[i % BENCH_FASTMATH_INPUTS]);
+        }
+    }
+    t1 = host_bench_now_ns();
+    *sink += sum;
+
+    return (t1 - t0) / BENCH_FASTMATH_LOOPS;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     fastmath 误差、运算次数和主机耗时
+//-------------------------------------------------------------------------------------------------------------------
+void bench_fastmath_functions(void)
+{
+    const bench_fastmath_item_t *item;
+    double err;
+    double err_max;
+    double err_sum2;
+    double ns;
+    float sink;
+    long i;
+    uint8 k;
+
+    sink = 0;
+    printf("  %-17s %10s %10s   %-22s %s\r\n", "function", "max err", "rms err", "mul add div /call", "host ns/call (relative only)");
+    for(k = 0; k < sizeof(bench_fastmath_list) / sizeof(bench_fastmath_list[0]); k++)
+    {
+        item = &bench_fastmath_list[k];
+
+        err_max = 0;
+        err_sum2 = 0;
+        for(i = 0; i <= BENCH_FASTMATH_POINTS; i++)
+        {
+            err = bench_fastmath_error(item, bench_fastmath_point(item, i, BENCH_FASTMATH_POINTS));
+            err_sum2 += err * err;
+            err_max = (err > err_max) ? err : err_max;
+        }
+
+        ns = bench_fastmath_time(item, &sink);
+        printf("  %-17s %10.2e %10.2e   %3u %3u %3u%-11s %8.1f\r\n", item->name, err_max,
+               sqrt(err_sum2 / (BENCH_FASTMATH_POINTS + 1)), item->mul, item->add, item->div,
+               (item->func2 != NULL) ? " (+0~2)" : "", ns);
+    }
+    printf("  (inv_sqrt: relative error, atan2: full circle; checksum %.1f)\r\n", sink);
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     atan2 三种实现: 欧拉角输入上的误差、运算次数和主机耗时
+//-------------------------------------------------------------------------------------------------------------------
+void bench_fastmath_atan2(void)
+{
+    static float in_y[BENCH_ATAN2_QUATS];
+    static float in_x[BENCH_ATAN2_QUATS];
+    double q[4];
+    double n;
+    double err;
+    double err_max;
+    double err_sum2;
+    double t0;
+    double t1;
+    float sum;
+    uint32 i;
+    uint16 j;
+    uint8 k;
+
+    // 随机单位四元数的航向参数
+    bench_atan2_seed = 1;
+    for(j = 0; j < BENCH_ATAN2_QUATS; j++)
+    {
+        do
+        {
+            for(k = 0; k < 4; k++)
+            {
+                q[k] = bench_atan2_rand();
+            }
+            n = sqrt(q[0] * q[0] + q[1] * q[1] + q[2] * q[2] + q[3] * q[3]);
+        } while(n < 0.1 || n > 1.0);
+        for(k = 0; k < 4; k++)
+        {
+            q[k] /= n;
+        }
+        in_y[j] = (float)(2 * (q[0] * q[3] + q[1] * q[2]));
+        in_x[j] = (float)(1 - 2 * (q[2] * q[2] + q[3] * q[3]));
+    }
+
+    sum = 0;
+    for(k = 0; k < 3; k++)
+    {
+        err_max = 0;
+        err_sum2 = 0;
+        for(j = 0; j < BENCH_ATAN2_QUATS; j++)
+        {
+            err = fabs(bench_atan2_list[k](in_y[j], in_x[j]) - atan2((double)in_y[j], (double)in_x[j]));
+            err = (err > M_PI) ? (2 * M_PI - err) : err;
+            err_sum2 += err * err;
+            err_max = (err > err_max) ? err : err_max;
+        }
+        printf("  %-24s max err %.2e rad  rms %.2e rad  ops %u mul %u add %u div (+0~2 fold)\r\n",
+               bench_atan2_name[k], err_max, sqrt(err_sum2 / BENCH_ATAN2_QUATS),
+               bench_atan2_ops[k][0], bench_atan2_ops[k][1], bench_atan2_ops[k][2]);
+    }
+
+    for(k = 0; k < 3; k++)
+    {
+        t0 = host_bench_now_ns();
+        for(i = 0; i < BENCH_ATAN2_LOOPS; i++)
+        {
+            for(j = 0; j < BENCH_ATAN2_QUATS; j++)
+            {
+                sum += bench_atan2_list[k](in_y[j], in_x[j]);
+            }
+        }
+        t1 = host_bench_now_ns();
+        host_bench_report(bench_atan2_name[k], t1 - t0, (uint32)BENCH_ATAN2_LOOPS * BENCH_ATAN2_QUATS);
+    }
+
+    // Quaternion_ToEuler 每次 2个 atan2 (roll, yaw)，Quaternion_ToYaw 1个
+    printf("  fast_atan2_table vs fast_atan2: -%u mul -%u add per atan2, Quaternion_ToEuler -%u mul -%u add\r\n",
+           bench_atan2_ops[1][0] - bench_atan2_ops[0][0], bench_atan2_ops[1][1] - bench_atan2_ops[0][1],
+           2 * (bench_atan2_ops[1][0] - bench_atan2_ops[0][0]), 2 * (bench_atan2_ops[1][1] - bench_atan2_ops[0][1]));
+    printf("  (host ns is relative only; checksum %.1f)\r\n", sum);
+}
@@ -0,0 +1,25 @@
+#ifndef _BENCH_LIST_H_
+#define _BENCH_LIST_H_
+
+//-------------------------------------------------------------------------------------------------------------------
+// 说明
+//-------------------------------------------------------------------------------------------------------------------
+// 性能测试登记表，新测试在对应的 bench_xxx.c 中实现，在这里声明并加入 HOST_BENCH_LIST
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数声明
+//-------------------------------------------------------------------------------------------------------------------
+void bench_control_tick(void);
+void bench_fastmath_functions(void);
+void bench_fastmath_atan2(void);
+void bench_median_networks(void);
+void bench_pid_increment(void);
+
+#define HOST_BENCH_LIST(X)                                      \
+    X(bench_control_tick)                                       \
+    X(bench_fastmath_functions)                                 \
+    X(bench_fastmath_atan2)                                     \
+    X(bench_median_networks)                                    \
+    X(bench_pid_increment)
+
+#endif
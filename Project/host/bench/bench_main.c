@@ -0,0 +1,73 @@
+//-------------------------------------------------------------------------------------------------------------------
+// 头文件包含
+//-------------------------------------------------------------------------------------------------------------------
+#include "host_bench.h"
+#include "bench_list.h"
+
+//-------------------------------------------------------------------------------------------------------------------
+// 私有变量
+//-------------------------------------------------------------------------------------------------------------------
+typedef struct
+{
+    const char *name;
+    void (*func)(void);
+}bench_item_struct;
+
+#define HOST_BENCH_ITEM(func)   {#func, func},
+static const bench_item_struct bench_list[] =
+{
+    HOST_BENCH_LIST(HOST_BENCH_ITEM)
+};
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     读取主机时间
+// 参数说明     void
+// 返回参数     double          时间 (ns)
+// 使用示例     t0 = host_bench_now_ns();
+//-------------------------------------------------------------------------------------------------------------------
+double host_bench_now_ns(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     打印一行测试结果
+// 参数说明     name            测试项名称
+// 参数说明     ns              总耗时 (ns)
+// 参数说明     loops           循环次数
+// 返回参数     void
+// 使用示例     host_bench_report("pid float", t1 - t0, loops);
+//-------------------------------------------------------------------------------------------------------------------
+void host_bench_report(const char *name, double ns, uint32 loops)
+{
+    printf("  %-32s %10u loops %10.1f ns/loop\r\n", name, loops, ns / loops);
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     运行全部性能测试
+// 参数说明     argc / argv     可选参数: 只运行名字包含该字符串的测试
+// 返回参数     int             0
+// 使用示例     ./build/bench_runner [名字]
+//-------------------------------------------------------------------------------------------------------------------
+int main(int argc, char *argv[])
+{
+    uint32 i;
+
+    for(i = 0; i < sizeof(bench_list) / sizeof(bench_list[0]); i++)
+    {
+        if(argc > 1 && strstr(bench_list[i].name, argv[1]) == NULL)
+        {
+            continue;
+        }
+
+        mock_hal_reset();
+        tim4_irq_handler = timebase_overflow_handler;
+        printf("%s\r\n", bench_list[i].name);
+        bench_list[i].func();
+    }
+
+    return 0;
+}
@@ -0,0 +1,250 @@
+//-------------------------------------------------------------------------------------------------------------------
+// 头文件包含
+//-------------------------------------------------------------------------------------------------------------------
+#include "host_bench.h"
+
+//-------------------------------------------------------------------------------------------------------------------
+// 说明
+//-------------------------------------------------------------------------------------------------------------------
+// 排序网络与冒泡排序对比
+//   比较 / 交换次数: n = 3/5/7/9 的全部 n! 个排列的平均值和最大值，与平台无关
+//   主机耗时: 固定种子的随机 12 位数据，只用于相对比较
+//   排序网络的计数来自 count_xxx (median.c 用 bench/median_count.h 再编译一次)
+
+//-------------------------------------------------------------------------------------------------------------------
+// 宏定义
+//-------------------------------------------------------------------------------------------------------------------
+#define BENCH_MEDIAN_LOOPS      (1000000)
+
+//-------------------------------------------------------------------------------------------------------------------
+// 私有变量
+//-------------------------------------------------------------------------------------------------------------------
+unsigned long median_count_cmp = 0;
+unsigned long median_count_swap = 0;
+
+uint16 count_median3(uint16 a, uint16 b, uint16 c);
+void   count_sort_network_3(uint16 v[]);
+void   count_sort_network_5(uint16 v[]);
+void   count_sort_network_7(uint16 v[]);
+void   count_sort_network_9(uint16 v[]);
+uint16 count_median_of_5(uint16 v[]);
+uint16 count_median_of_7(uint16 v[]);
+uint16 count_median_of_9(uint16 v[]);
+
+static uint16 count_median_of_3(uint16 v[])
+{
+    return count_median3(v[0], v[1], v[2]);
+}
+
+static uint16 bench_median_of_3(uint16 v[])
+{
+    return median3(v[0], v[1], v[2]);
+}
+
+typedef void   (*bench_sort_func)(uint16 v[]);
+typedef uint16 (*bench_median_func)(uint16 v[]);
+
+static const uint8 bench_median_n[4] = {3, 5, 7, 9};
+static const bench_sort_func bench_sort_list[4] = {sort_network_3, sort_network_5, sort_network_7, sort_network_9};
+static const bench_median_func bench_median_list[4] = {bench_median_of_3, median_of_5, median_of_7, median_of_9};
+static const bench_sort_func bench_count_sort_list[4] = {count_sort_network_3, count_sort_network_5, count_sort_network_7, count_sort_network_9};
+static const bench_median_func bench_count_median_list[4] = {count_median_of_3, count_median_of_5, count_median_of_7, count_median_of_9};
+
+static unsigned long bubble_cmp = 0;
+static unsigned long bubble_swap = 0;
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     冒泡排序 (一趟没有交换时提前结束)，统计比较和交换次数
+//-------------------------------------------------------------------------------------------------------------------
+static void bench_bubble_sort(uint16 v[], uint8 n)
+{
+    uint16 t;
+    uint8 i;
+    uint8 j;
+    uint8 swapped;
+
+    for(i = 0; i < n - 1; i++)
+    {
+        swapped = 0;
+        for(j = 0; j < n - 1 - i; j++)
+        {
+            bubble_cmp++;
+            if(v[j] > v[j+1])
+            {
+                t = v[j]; v[j] = v[j+1]; v[j+1] = t;
+                bubble_swap++;
+                swapped = 1;
+            }
+        }
+        if(!swapped)
+        {
+            break;
+        }
+    }
+}
+
+static uint8 bench_next_permutation(uint16 *v, uint8 n)
+{
+    int8 i;
+    int8 j;
+    uint16 t;
+
+    i = (int8)n - 2;
+    while(i >= 0 && v[i] >= v[i+1])
+    {
+        i--;
+    }
+    if(i < 0)
+    {
+        return 0;
+    }
+    j = (int8)n - 1;
+    while(v[j] <= v[i])
+    {
+        j--;
+    }
+    t = v[i]; v[i] = v[j]; v[j] = t;
+    for(i++, j = (int8)n - 1; i < j; i++, j--)
+    {
+        t = v[i]; v[i] = v[j]; v[j] = t;
+    }
+    return 1;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     统计一种方法在全部排列上的比较 / 交换次数
+// 参数说明     k               网络序号
+// 参数说明     method          0-排序网络 1-取中值网络 2-冒泡排序
+//-------------------------------------------------------------------------------------------------------------------
+static void bench_median_count(uint8 k, uint8 method)
+{
+    static const char *name[3] = {"sort network", "median network", "bubble sort"};
+    uint16 in[9];
+    uint16 v[9];
+    unsigned long perms;
+    unsigned long cmp_sum, swap_sum, cmp_max, swap_max;
+    unsigned long cmp, swap;
+    uint8 n;
+    uint8 i;
+
+    n = bench_median_n[k];
+    for(i = 0; i < n; i++)
+    {
+        in[i] = i;
+    }
+
+    perms = 0;
+    cmp_sum = 0;
+    swap_sum = 0;
+    cmp_max = 0;
+    swap_max = 0;
+    do
+    {
+        memcpy(v, in, sizeof(v));
+        median_count_cmp = 0;
+        median_count_swap = 0;
+        bubble_cmp = 0;
+        bubble_swap = 0;
+
+        if(method == 0)
+        {
+            bench_count_sort_list[k](v);
+        }
+        else if(method == 1)
+        {
+            bench_count_median_list[k](v);
+        }
+        else
+        {
+            bench_bubble_sort(v, n);
+        }
+
+        cmp = median_count_cmp + bubble_cmp;
+        swap = median_count_swap + bubble_swap;
+        cmp_sum += cmp;
+        swap_sum += swap;
+        if(cmp > cmp_max)
+        {
+            cmp_max = cmp;
+        }
+        if(swap > swap_max)
+        {
+            swap_max = swap;
+        }
+        perms++;
+    }while(bench_next_permutation(in, n));
+
+    printf("  n=%u %-15s cmp avg %6.2f max %3lu   swap avg %6.2f max %3lu\r\n",
+           n, name[method], (double)cmp_sum / perms, cmp_max, (double)swap_sum / perms, swap_max);
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     排序网络 / 取中值网络 / 冒泡排序的比较交换次数和主机耗时
+//-------------------------------------------------------------------------------------------------------------------
+void bench_median_networks(void)
+{
+    static uint16 data[BENCH_MEDIAN_LOOPS / 100][9];
+    uint16 v[9];
+    uint32 seed;
+    uint32 i;
+    uint32 sink;
+    double t0;
+    double t1;
+    char name[40];
+    uint8 k;
+    uint8 j;
+
+    for(k = 0; k < 4; k++)
+    {
+        bench_median_count(k, 0);
+        bench_median_count(k, 1);
+        bench_median_count(k, 2);
+    }
+
+    seed = 1;
+    for(i = 0; i < BENCH_MEDIAN_LOOPS / 100; i++)
+    {
+        for(j = 0; j < 9; j++)
+        {
+            seed = seed * 1103515245u + 12345u;
+            data[i][j] = (uint16)((seed >> 16) % 4096);
+        }
+    }
+
+    sink = 0;
+    for(k = 0; k < 4; k++)
+    {
+        t0 = host_bench_now_ns();
+        for(i = 0; i < BENCH_MEDIAN_LOOPS; i++)
+        {
+            memcpy(v, data[i % (BENCH_MEDIAN_LOOPS / 100)], sizeof(v));
+            bench_sort_list[k](v);
+            sink += v[0];
+        }
+        t1 = host_bench_now_ns();
+        sprintf(name, "sort network %u", bench_median_n[k]);
+        host_bench_report(name, t1 - t0, BENCH_MEDIAN_LOOPS);
+
+        t0 = host_bench_now_ns();
+        for(i = 0; i < BENCH_MEDIAN_LOOPS; i++)
+        {
+            memcpy(v, data[i % (BENCH_MEDIAN_LOOPS / 100)], sizeof(v));
+            sink += bench_median_list[k](v);
+        }
+        t1 = host_bench_now_ns();
+        sprintf(name, "median network %u", bench_median_n[k]);
+        host_bench_report(name, t1 - t0, BENCH_MEDIAN_LOOPS);
+
+        t0 = host_bench_now_ns();
+        for(i = 0; i < BENCH_MEDIAN_LOOPS; i++)
+        {
+            memcpy(v, data[i % (BENCH_MEDIAN_LOOPS / 100)], sizeof(v));
+            bench_bubble_sort(v, bench_median_n[k]);
+            sink += v[0];
+        }
+        t1 = host_bench_now_ns();
+        sprintf(name, "bubble sort %u", bench_median_n[k]);
+        host_bench_report(name, t1 - t0, BENCH_MEDIAN_LOOPS);
+    }
+    printf("  (checksum %u)\r\n", sink);
+}
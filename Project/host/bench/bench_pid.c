@@ -0,0 +1,87 @@
+//-------------------------------------------------------------------------------------------------------------------
+// 头文件包含
+//-------------------------------------------------------------------------------------------------------------------
+#include "host_bench.h"
+
+//-------------------------------------------------------------------------------------------------------------------
+// 说明
+//-------------------------------------------------------------------------------------------------------------------
+// 速度环增量式PID: 浮点与 Q16.16 定点的耗时和输出差
+//   输入为固定种子的编码器值 (目标附近抖动)，两者输入相同
+//   主机有硬件浮点，耗时只用于比较写法的相对变化，车上 (C251 软件浮点) 的耗时用 profiler 测量
+
+//-------------------------------------------------------------------------------------------------------------------
+// 宏定义
+//-------------------------------------------------------------------------------------------------------------------
+#define BENCH_PID_LOOPS         (2000000)
+#define BENCH_PID_INPUTS        (256)
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     浮点 / 定点增量式PID
+//-------------------------------------------------------------------------------------------------------------------
+void bench_pid_increment(void)
+{
+    static int16 input[BENCH_PID_INPUTS];
+    pid_param_t pid;
+    pid_fixed_t fx;
+    uint32 seed;
+    uint32 i;
+    double t0;
+    double t1;
+    double err;
+    double err_sum;
+    double err_max;
+    float sink;
+    q16_t sink_fx;
+
+    seed = 1;
+    for(i = 0; i < BENCH_PID_INPUTS; i++)
+    {
+        seed = seed * 1103515245u + 12345u;
+        input[i] = 30 + (int16)((seed >> 16) % 9) - 4;
+    }
+
+    pid_init(&pid, 1.7f, 0.22f, 0.2f);
+    pid.target = 30.0f;
+    memset(&fx, 0, sizeof(fx));
+    pid_fixed_sync(&fx, &pid);
+
+    sink = 0;
+    t0 = host_bench_now_ns();
+    for(i = 0; i < BENCH_PID_LOOPS; i++)
+    {
+        sink += pid_calc_increment(&pid, input[i % BENCH_PID_INPUTS]);
+    }
+    t1 = host_bench_now_ns();
+    host_bench_report("pid increment float", t1 - t0, BENCH_PID_LOOPS);
+
+    sink_fx = 0;
+    t0 = host_bench_now_ns();
+    for(i = 0; i < BENCH_PID_LOOPS; i++)
+    {
+        sink_fx += pid_fixed_calc_increment(&fx, Q16_FROM_INT(input[i % BENCH_PID_INPUTS]));
+    }
+    t1 = host_bench_now_ns();
+    host_bench_report("pid increment Q16.16", t1 - t0, BENCH_PID_LOOPS);
+
+    // 输出差: 从相同状态开始逐步对照
+    pid_init(&pid, 1.7f, 0.22f, 0.2f);
+    pid.target = 30.0f;
+    memset(&fx, 0, sizeof(fx));
+    pid_fixed_sync(&fx, &pid);
+    err_sum = 0;
+    err_max = 0;
+    for(i = 0; i < BENCH_PID_LOOPS / 10; i++)
+    {
+        err = fabs((double)pid_calc_increment(&pid, input[i % BENCH_PID_INPUTS]) -
+                   q16_to_float(pid_fixed_calc_increment(&fx, Q16_FROM_INT(input[i % BENCH_PID_INPUTS]))));
+        err_sum += err;
+        if(err > err_max)
+        {
+            err_max = err;
+        }
+    }
+    printf("  output error mean %.6f, max %.6f (%lu steps)\r\n", err_sum / (BENCH_PID_LOOPS / 10), err_max,
+           (unsigned long)(BENCH_PID_LOOPS / 10));
+    printf("  (checksum %.1f %d)\r\n", sink, sink_fx);
+}
@@ -0,0 +1,40 @@
+#ifndef _HOST_BENCH_H_
+#define _HOST_BENCH_H_
+
+//-------------------------------------------------------------------------------------------------------------------
+// 头文件包含
+//-------------------------------------------------------------------------------------------------------------------
+#include "mock_hal.h"
+#include <time.h>
+
+//-------------------------------------------------------------------------------------------------------------------
+// 说明
+//-------------------------------------------------------------------------------------------------------------------
+// 性能测试
+//   每个测试是一个 void xxx(void) 函数，在 bench_main.c 的 bench_list 中登记
+//   主机时间只用于比较同一函数的不同实现，不代表 STC32G 上的执行时间
+//   单片机上的实际耗时用 profiler 模块测量，这里更关心与平台无关的计数 (比较次数、ADC 转换次数等)
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数声明
+//-------------------------------------------------------------------------------------------------------------------
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     读取主机时间
+// 参数说明     void
+// 返回参数     double          时间 (ns)
+// 使用示例     t0 = host_bench_now_ns();
+//-------------------------------------------------------------------------------------------------------------------
+double host_bench_now_ns(void);
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     打印一行测试结果
+// 参数说明     name            测试项名称
+// 参数说明     ns              总耗时 (ns)
+// 参数说明     loops           循环次数
+// 返回参数     void
+// 使用示例     host_bench_report("pid float", t1 - t0, loops);
+//-------------------------------------------------------------------------------------------------------------------
+void host_bench_report(const char *name, double ns, uint32 loops);
+
+#endif
@@ -0,0 +1,25 @@
+#ifndef _MEDIAN_COUNT_H_
+#define _MEDIAN_COUNT_H_
+
+//-------------------------------------------------------------------------------------------------------------------
+// 说明
+//-------------------------------------------------------------------------------------------------------------------
+// 统计比较交换次数的 median.c (Makefile 用 -include 本文件再编译一次 median.c)
+//   函数改名为 count_xxx，与正常编译的 median.o 一起链接
+//   MEDIAN_CSWAP 替换为计数版本，比较和交换次数累加到 median_count_cmp / median_count_swap
+
+#define median3             count_median3
+#define median_of_5         count_median_of_5
+#define median_of_7         count_median_of_7
+#define median_of_9         count_median_of_9
+#define sort_network_3      count_sort_network_3
+#define sort_network_5      count_sort_network_5
+#define sort_network_7      count_sort_network_7
+#define sort_network_9      count_sort_network_9
+
+extern unsigned long median_count_cmp;
+extern unsigned long median_count_swap;
+
+#define MEDIAN_CSWAP(a, b)  { median_count_cmp++; if((a) > (b)) { uint16 t_ = (a); (a) = (b); (b) = t_; median_count_swap++; } }
+
+#endif
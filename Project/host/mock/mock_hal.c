@@ -0,0 +1,501 @@
+//-------------------------------------------------------------------------------------------------------------------
+// 头文件包含
+//-------------------------------------------------------------------------------------------------------------------
+#include "mock_hal.h"
+#include "zf_driver_soft_iic.h"
+
+//-------------------------------------------------------------------------------------------------------------------
+// 寄存器
+//-------------------------------------------------------------------------------------------------------------------
+uint8 ADC_CONTR, ADC_RES, ADC_RESL, ADCCFG, ADCTIM, EADC, PADC, PADCH;
+uint8 EA = 1, IE, IE2, IP, IPH, AUXINTIF, P_SW2;
+uint8 T4H, T4L, TM4PS, T4T3M;
+volatile unsigned char TH1, TL1, TF1;
+uint8 TMOD, AUXR, TM1PS, TR1, ET1;
+
+uint32 system_clock = SYSTEM_CLOCK_30M;
+
+//-------------------------------------------------------------------------------------------------------------------
+// 中断回调 (zf_common_typedef.c)
+//-------------------------------------------------------------------------------------------------------------------
+void (*tim1_irq_handler)(void) = NULL;
+void (*tim2_irq_handler)(void) = NULL;
+void (*tim4_irq_handler)(void) = NULL;
+void (*int2_irq_handler)(void) = NULL;
+void (*imu660rb_dma_callback)(void) = NULL;
+
+//-------------------------------------------------------------------------------------------------------------------
+// 模拟外设状态
+//-------------------------------------------------------------------------------------------------------------------
+uint16 mock_adc_value[MOCK_ADC_CHANNEL_MAX];
+uint16 (*mock_adc_source)(adc_channel_enum ch) = NULL;
+uint32 mock_adc_convert_count = 0;
+void (*mock_adc_irq_handler)(void) = NULL;
+int16 mock_encoder_count[MOCK_ENCODER_MAX];
+uint32 mock_pwm_duty[MOCK_PWM_MAX];
+uint8 mock_gpio_level[MOCK_GPIO_MAX];
+uint8 mock_eeprom[MOCK_EEPROM_SIZE];
+uint8 mock_imu_init_result = 0;
+imu660rb_sample_struct mock_imu_sample;
+uint32 mock_assert_count = 0;
+uint8 mock_uart_tx[MOCK_UART_TX_SIZE];
+uint32 mock_uart_tx_len = 0;
+
+int16 imu660rb_gyro_x, imu660rb_gyro_y, imu660rb_gyro_z;
+int16 imu660rb_acc_x, imu660rb_acc_y, imu660rb_acc_z;
+
+static uint32 mock_time_us = 0;
+static imu660rb_sample_struct mock_imu_fifo[MOCK_IMU_FIFO_SIZE];
+static uint16 mock_imu_fifo_head = 0;
+static uint16 mock_imu_fifo_num = 0;
+static uint8 mock_imu_dma_pending = 0;                          // 0-空闲 1-单次读取 2-FIFO读取
+static imu660rb_sample_struct mock_imu_dma_buf[IMU660RB_FIFO_READ_MAX];
+static uint8 mock_imu_dma_num = 0;
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     复位全部模拟外设
+// 参数说明     void
+// 返回参数     void
+// 使用示例     mock_hal_reset();
+// 备注信息
+//-------------------------------------------------------------------------------------------------------------------
+void mock_hal_reset(void)
+{
+    memset(mock_adc_value, 0, sizeof(mock_adc_value));
+    mock_adc_source = NULL;
+    mock_adc_convert_count = 0;
+    mock_adc_irq_handler = NULL;
+    ADC_CONTR = 0;
+    EADC = 0;
+    memset(mock_encoder_count, 0, sizeof(mock_encoder_count));
+    memset(mock_pwm_duty, 0, sizeof(mock_pwm_duty));
+    memset(mock_gpio_level, 0, sizeof(mock_gpio_level));
+    memset(mock_eeprom, 0xFF, sizeof(mock_eeprom));
+    mock_imu_init_result = 0;
+    memset(&mock_imu_sample, 0, sizeof(mock_imu_sample));
+    mock_imu_sample.acc_z = 4098;                                // 水平静止 1g (±8g 量程)
+    mock_imu_fifo_head = 0;
+    mock_imu_fifo_num = 0;
+    mock_imu_dma_pending = 0;
+    mock_assert_count = 0;
+    mock_uart_tx_len = 0;
+
+    mock_time_us = 0;
+    T4H = 0;
+    T4L = 0;
+    AUXINTIF = 0;
+
+    TMOD = 0;
+    AUXR = 0;
+    TM1PS = 0;
+    TH1 = 0;
+    TL1 = 0;
+    TF1 = 0;
+    TR1 = 0;
+    ET1 = 0;
+    system_clock = SYSTEM_CLOCK_30M;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     设置当前时间
+// 参数说明     us              时间 (us，只能增加)
+// 返回参数     void
+// 使用示例     mock_set_time_us(now);
+// 备注信息
+//-------------------------------------------------------------------------------------------------------------------
+void mock_set_time_us(uint32 us)
+{
+    uint32 wraps;
+
+    wraps = (us >> 16) - (mock_time_us >> 16);
+    mock_time_us = us;
+    T4H = (uint8)(us >> 8);
+    T4L = (uint8)us;
+    while(wraps--)
+    {
+        if(tim4_irq_handler != NULL)
+        {
+            tim4_irq_handler();
+        }
+    }
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     读取当前时间
+// 参数说明     void
+// 返回参数     uint32          时间 (us)
+// 使用示例     uint32 now = mock_get_time_us();
+// 备注信息
+//-------------------------------------------------------------------------------------------------------------------
+uint32 mock_get_time_us(void)
+{
+    return mock_time_us;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// zf_common_clock / zf_common_debug
+//-------------------------------------------------------------------------------------------------------------------
+void clock_init(uint32 clock)
+{
+    system_clock = clock;
+}
+
+void debug_init(void)
+{
+}
+
+void debug_assert_handler(uint8 pass, char *file, int line)
+{
+    if(!pass)
+    {
+        mock_assert_count++;
+        printf("assert failed: %s line %d\r\n", file, line);
+    }
+}
+
+void debug_tx_get_stat(debug_tx_stat_struct *stat)
+{
+    memset(stat, 0, sizeof(debug_tx_stat_struct));
+}
+
+void debug_tx_flush(void)
+{
+}
+
+uint16 debug_tx_write(const uint8 *buff, uint16 len)
+{
+    return (uint16)(len - debug_send_buffer(buff, len));
+}
+
+uint32 debug_send_buffer(const uint8 *buff, uint32 len)
+{
+    uint32 n;
+
+    n = MOCK_UART_TX_SIZE - mock_uart_tx_len;
+    if(n > len)
+    {
+        n = len;
+    }
+    memcpy(&mock_uart_tx[mock_uart_tx_len], buff, n);
+    mock_uart_tx_len += n;
+
+    return 0;
+}
+
+uint32 debug_read_buffer(uint8 *buff, uint32 len)
+{
+    return 0;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// zf_driver_adc
+//-------------------------------------------------------------------------------------------------------------------
+void adc_init(adc_channel_enum ch, adc_resolution_enum resolution)
+{
+}
+
+uint16 adc_convert(adc_channel_enum ch)
+{
+    mock_adc_convert_count++;
+    if(mock_adc_source != NULL)
+    {
+        return mock_adc_source(ch);
+    }
+    return mock_adc_value[ch];
+}
+
+uint32 mock_adc_run(uint32 conversions)
+{
+    uint32 done;
+    uint16 value;
+
+    done = 0;
+    while(done < conversions && (ADC_CONTR & 0x40))
+    {
+        value = adc_convert((adc_channel_enum)(ADC_CONTR & 0x0F));
+        ADC_RES = (uint8)(value >> 8);
+        ADC_RESL = (uint8)value;
+        ADC_CONTR = (ADC_CONTR & ~0x40) | 0x20;
+        done++;
+
+        if(EADC && mock_adc_irq_handler != NULL)
+        {
+            mock_adc_irq_handler();
+        }
+    }
+
+    return done;
+}
+
+uint16 adc_mean_filter_convert(adc_channel_enum ch, const uint8 count)
+{
+    uint32 sum;
+    uint8 i;
+
+    sum = 0;
+    for(i = 0; i < count; i++)
+    {
+        sum += adc_convert(ch);
+    }
+    return (uint16)(sum / count);
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// zf_driver_gpio
+//-------------------------------------------------------------------------------------------------------------------
+void gpio_init(int pin, int dir, int dat, int mode)
+{
+    mock_gpio_level[pin & (MOCK_GPIO_MAX - 1)] = (uint8)dat;
+}
+
+uint8 gpio_get_level(int pin)
+{
+    return mock_gpio_level[pin & (MOCK_GPIO_MAX - 1)];
+}
+
+void gpio_set_level(int pin, int dat)
+{
+    mock_gpio_level[pin & (MOCK_GPIO_MAX - 1)] = (uint8)(dat != 0);
+}
+
+void gpio_high(int pin)
+{
+    gpio_set_level(pin, 1);
+}
+
+void gpio_low(int pin)
+{
+    gpio_set_level(pin, 0);
+}
+
+void gpio_toggle_level(int pin)
+{
+    gpio_set_level(pin, !gpio_get_level(pin));
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// zf_driver_encoder
+//-------------------------------------------------------------------------------------------------------------------
+void encoder_dir_init(int encoder_n, int dir_pin, int lsb_pin)
+{
+    mock_encoder_count[encoder_n] = 0;
+}
+
+int16 encoder_get_count(int encoder_n)
+{
+    return mock_encoder_count[encoder_n];
+}
+
+void encoder_clear_count(int encoder_n)
+{
+    mock_encoder_count[encoder_n] = 0;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// zf_driver_pwm
+//-------------------------------------------------------------------------------------------------------------------
+void pwm_init(int pwmch, uint32 freq, uint32 duty)
+{
+    mock_pwm_duty[pwmch] = duty;
+}
+
+void pwm_set_duty(int pwmch, uint32 duty)
+{
+    zf_assert(duty <= PWM_DUTY_MAX);
+    mock_pwm_duty[pwmch] = duty;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// zf_driver_pit / zf_driver_delay / zf_driver_exti
+//-------------------------------------------------------------------------------------------------------------------
+void pit_init(pit_index_enum pit_n, uint32 period)
+{
+}
+
+void system_delay_ms(uint32 time)
+{
+}
+
+void system_delay_us(uint32 time)
+{
+}
+
+void exti_init(exti_pin_enum pin, exti_trigger_enum trigger)
+{
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// zf_driver_soft_iic
+//-------------------------------------------------------------------------------------------------------------------
+void soft_iic_init(soft_iic_info_struct *soft_iic_obj, uint8 addr, uint32 delay, int scl_pin, int sda_pin)
+{
+    soft_iic_obj->addr = addr;
+    soft_iic_obj->delay = delay;
+    soft_iic_obj->scl_pin = scl_pin;
+    soft_iic_obj->sda_pin = sda_pin;
+}
+
+void soft_iic_write_8bit_array(soft_iic_info_struct *soft_iic_obj, const uint8 *data, uint32 len)
+{
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// zf_driver_eeprom (Flash: 擦除为 0xFF，写入只能把1写成0)
+//-------------------------------------------------------------------------------------------------------------------
+void iap_init(void)
+{
+}
+
+uint8 iap_read_byte(uint32 addr)
+{
+    zf_assert(addr < MOCK_EEPROM_SIZE);
+    return mock_eeprom[addr % MOCK_EEPROM_SIZE];
+}
+
+void iap_write_byte(uint32 addr, uint8 dat)
+{
+    zf_assert(addr < MOCK_EEPROM_SIZE);
+    mock_eeprom[addr % MOCK_EEPROM_SIZE] &= dat;
+}
+
+void iap_erase_page(uint32 addr)
+{
+    zf_assert(addr < MOCK_EEPROM_SIZE);
+    memset(&mock_eeprom[(addr % MOCK_EEPROM_SIZE) & ~(uint32)(MOCK_EEPROM_PAGE - 1)], 0xFF, MOCK_EEPROM_PAGE);
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// zf_device_imu660rb
+//-------------------------------------------------------------------------------------------------------------------
+static void mock_imu_latch(const imu660rb_sample_struct *sample)
+{
+    imu660rb_gyro_x = sample->gyro_x;
+    imu660rb_gyro_y = sample->gyro_y;
+    imu660rb_gyro_z = sample->gyro_z;
+    imu660rb_acc_x = sample->acc_x;
+    imu660rb_acc_y = sample->acc_y;
+    imu660rb_acc_z = sample->acc_z;
+}
+
+uint8 imu660rb_init(void)
+{
+    return mock_imu_init_result;
+}
+
+void imu660rb_get_acc(void)
+{
+    mock_imu_latch(&mock_imu_sample);
+}
+
+void imu660rb_get_gyro(void)
+{
+    mock_imu_latch(&mock_imu_sample);
+}
+
+void imu660rb_get_acc_gyro(void)
+{
+    mock_imu_latch(&mock_imu_sample);
+}
+
+float imu660rb_acc_transition(int16 acc_value)
+{
+    return (float)acc_value / 4098;                             // IMU660RB_ACC_SAMPLE 0x3C ±8g
+}
+
+float imu660rb_gyro_transition(int16 gyro_value)
+{
+    return (float)gyro_value / 14.3f;                           // IMU660RB_GYR_SAMPLE 0x5C ±2000dps
+}
+
+uint8 mock_imu_fifo_push(const imu660rb_sample_struct *sample)
+{
+    if(mock_imu_fifo_num >= MOCK_IMU_FIFO_SIZE)
+    {
+        return 0;
+    }
+    mock_imu_fifo[(mock_imu_fifo_head + mock_imu_fifo_num) % MOCK_IMU_FIFO_SIZE] = *sample;
+    mock_imu_fifo_num++;
+    return 1;
+}
+
+void imu660rb_fifo_init(void)
+{
+    mock_imu_fifo_head = 0;
+    mock_imu_fifo_num = 0;
+}
+
+uint16 imu660rb_fifo_count(void)
+{
+    return mock_imu_fifo_num;
+}
+
+uint16 imu660rb_fifo_read(imu660rb_sample_struct *sample, uint8 *sample_num)
+{
+    uint8 n;
+
+    n = 0;
+    while(n < IMU660RB_FIFO_READ_MAX && mock_imu_fifo_num != 0)
+    {
+        sample[n++] = mock_imu_fifo[mock_imu_fifo_head];
+        mock_imu_fifo_head = (mock_imu_fifo_head + 1) % MOCK_IMU_FIFO_SIZE;
+        mock_imu_fifo_num--;
+    }
+    if(n != 0)
+    {
+        mock_imu_latch(&sample[n - 1]);
+    }
+    *sample_num = n;
+
+    return mock_imu_fifo_num;
+}
+
+uint8 imu660rb_dma_busy(void)
+{
+    return mock_imu_dma_pending != 0;
+}
+
+uint8 imu660rb_get_acc_gyro_dma(void)
+{
+    if(mock_imu_dma_pending)
+    {
+        return 1;
+    }
+    mock_imu_dma_pending = 1;
+    return 0;
+}
+
+void imu660rb_get_acc_gyro_dma_finish(void)
+{
+    mock_imu_latch(&mock_imu_sample);
+}
+
+uint8 imu660rb_fifo_read_dma(void)
+{
+    if(mock_imu_dma_pending || mock_imu_fifo_num < IMU660RB_FIFO_WATERMARK)
+    {
+        return 0;
+    }
+    imu660rb_fifo_read(mock_imu_dma_buf, &mock_imu_dma_num);
+    mock_imu_dma_pending = 2;
+    return mock_imu_dma_num;
+}
+
+uint8 imu660rb_fifo_read_dma_finish(imu660rb_sample_struct *sample)
+{
+    memcpy(sample, mock_imu_dma_buf, mock_imu_dma_num * sizeof(imu660rb_sample_struct));
+    return mock_imu_dma_num;
+}
+
+uint8 mock_imu_dma_service(void)
+{
+    if(!mock_imu_dma_pending)
+    {
+        return 0;
+    }
+    mock_imu_dma_pending = 0;
+    if(imu660rb_dma_callback != NULL)
+    {
+        imu660rb_dma_callback();
+    }
+    return 1;
+}
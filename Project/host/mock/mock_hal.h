@@ -0,0 +1,109 @@
+#ifndef _MOCK_HAL_H_
+#define _MOCK_HAL_H_
+
+//-------------------------------------------------------------------------------------------------------------------
+// 头文件包含
+//-------------------------------------------------------------------------------------------------------------------
+#include "zf_common_headfile.h"
+
+//-------------------------------------------------------------------------------------------------------------------
+// 说明
+//-------------------------------------------------------------------------------------------------------------------
+// 主机编译用的库函数实现 (mock HAL)，测试、性能测试和仿真通过这里的变量给模块输入、读取模块输出
+//   ADC: adc_convert() 返回 mock_adc_value[通道]，设置 mock_adc_source 后改为调用该函数 (噪声、仿真传感器)
+//        后台扫描由 mock_adc_run() 模拟: 按 ADC_CONTR 选择的通道完成转换，写 ADC_RES/ADC_RESL 后调用 mock_adc_irq_handler
+//   编码器: encoder_get_count() 返回 mock_encoder_count[编码器]，清零后为0
+//   PWM / GPIO: pwm_set_duty() / gpio_set_level() 写入 mock_pwm_duty[] / mock_gpio_level[]
+//   EEPROM: 按 Flash 行为模拟 (擦除为 0xFF，写入只能把1写成0)
+//   IMU: imu660rb_get_acc_gyro() 等读出 mock_imu_sample，DMA 读取在 mock_imu_dma_service() 中完成
+//   时间: mock_set_time_us() 设置 TIM4 计数并在回绕时调用溢出中断，timebase_now_us() 返回设置的时间
+//   断言: zf_assert 失败时计数，不停止程序
+
+//-------------------------------------------------------------------------------------------------------------------
+// 宏定义
+//-------------------------------------------------------------------------------------------------------------------
+#define MOCK_ADC_CHANNEL_MAX        (16)
+#define MOCK_ENCODER_MAX            (2)
+#define MOCK_PWM_MAX                (3)
+#define MOCK_GPIO_MAX               (0x80)
+#define MOCK_EEPROM_SIZE            (0x1000)
+#define MOCK_EEPROM_PAGE            (512)
+#define MOCK_IMU_FIFO_SIZE          (64)
+#define MOCK_UART_TX_SIZE           (4096)
+
+//-------------------------------------------------------------------------------------------------------------------
+// 全局变量声明
+//-------------------------------------------------------------------------------------------------------------------
+extern uint16 mock_adc_value[MOCK_ADC_CHANNEL_MAX];              // adc_convert() 返回值
+extern uint16 (*mock_adc_source)(adc_channel_enum ch);          // 非 NULL 时 adc_convert() 调用它
+extern uint32 mock_adc_convert_count;                           // adc_convert() 调用次数 + mock_adc_run() 转换次数
+extern void (*mock_adc_irq_handler)(void);                      // ADC 转换完成中断 (isr.c 中为 Adc_Scan_Isr)
+extern int16 mock_encoder_count[MOCK_ENCODER_MAX];              // 编码器计数 (TIM0_ENCOEDER / TIM3_ENCOEDER)
+extern uint32 mock_pwm_duty[MOCK_PWM_MAX];                      // PWM 占空比 (0 ~ PWM_DUTY_MAX)
+extern uint8 mock_gpio_level[MOCK_GPIO_MAX];                    // GPIO 电平
+extern uint8 mock_eeprom[MOCK_EEPROM_SIZE];                     // EEPROM 内容
+extern uint8 mock_imu_init_result;                              // imu660rb_init() 返回值
+extern imu660rb_sample_struct mock_imu_sample;                  // IMU 当前输出 (原始值)
+extern uint32 mock_assert_count;                                // zf_assert 失败次数
+extern uint8 mock_uart_tx[MOCK_UART_TX_SIZE];                   // debug_send_buffer() 发送的数据
+extern uint32 mock_uart_tx_len;
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数声明
+//-------------------------------------------------------------------------------------------------------------------
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     复位全部模拟外设
+// 参数说明     void
+// 返回参数     void
+// 使用示例     mock_hal_reset();
+// 备注信息     ADC 值和计数清零，EEPROM 擦除为 0xFF，IMU 输出静止水平 (az = 1g)，时间回到0
+//              模块自身的静态变量不会复位，需要调用模块的初始化函数
+//-------------------------------------------------------------------------------------------------------------------
+void mock_hal_reset(void);
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     设置当前时间
+// 参数说明     us              时间 (us，只能增加)
+// 返回参数     void
+// 使用示例     mock_set_time_us(now);
+// 备注信息     写 TIM4 计数寄存器，每经过一次 65536us 回绕调用一次 tim4_irq_handler
+//-------------------------------------------------------------------------------------------------------------------
+void mock_set_time_us(uint32 us);
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     读取当前时间
+// 参数说明     void
+// 返回参数     uint32          最近一次 mock_set_time_us() 设置的时间 (us)
+// 使用示例     uint32 now = mock_get_time_us();
+//-------------------------------------------------------------------------------------------------------------------
+uint32 mock_get_time_us(void);
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     模拟 ADC 硬件完成转换
+// 参数说明     conversions     最多完成的转换次数
+// 返回参数     uint32          实际完成的转换次数
+// 使用示例     mock_adc_run(CHANNEL_NUMBER * ADC_SCAN_DEPTH);           // 后台扫描一帧
+// 备注信息     ADC_CONTR 的启动位 (0x40) 置位时完成一次转换: 12位结果右对齐写入 ADC_RES/ADC_RESL，
+//              清启动位、置完成标志 (0x20)，EADC 使能时调用 mock_adc_irq_handler。中断里没有启动下一次转换时提前返回
+//-------------------------------------------------------------------------------------------------------------------
+uint32 mock_adc_run(uint32 conversions);
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     IMU FIFO 写入一个采样
+// 参数说明     sample          采样 (原始值)
+// 返回参数     uint8           1-写入 0-FIFO 已满
+// 使用示例     mock_imu_fifo_push(&sample);
+//-------------------------------------------------------------------------------------------------------------------
+uint8 mock_imu_fifo_push(const imu660rb_sample_struct *sample);
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     完成正在进行的 IMU DMA 读取
+// 参数说明     void
+// 返回参数     uint8           1-完成了一次读取并调用了 imu660rb_dma_callback 0-没有正在进行的读取
+// 使用示例     imu_update(); while(mock_imu_dma_service());
+// 备注信息     相当于 DMA_SPI 传输完成中断
+//-------------------------------------------------------------------------------------------------------------------
+uint8 mock_imu_dma_service(void);
+
+#endif
@@ -0,0 +1,252 @@
+#ifndef __HEADFILE_H_
+#define __HEADFILE_H_
+
+//-------------------------------------------------------------------------------------------------------------------
+// 说明
+//-------------------------------------------------------------------------------------------------------------------
+// 主机编译用的 zf_common_headfile.h 代替文件 (mock HAL)
+//   Project/code 下的模块只通过本文件访问库函数和寄存器，主机上不修改源码直接编译
+//   类型宽度与 C251 一致: int16 为16位，int32/uint32 为32位 (主机 int，不能用64位 long)
+//   库函数在 mock_hal.c 中实现，传感器输入和执行器输出通过 mock_hal.h 中的变量读写
+//   只声明 Project/code 用到的库函数和寄存器，新模块用到其他库函数时在这里补充
+//   库中的编译配置 (如 IMU660RB_USE_DMA) 需要与 Libraries 中的默认值保持一致
+
+//-------------------------------------------------------------------------------------------------------------------
+// 标准库和基本类型 (zf_common_typedef.h)
+//-------------------------------------------------------------------------------------------------------------------
+#include <string.h>
+#include <stdio.h>
+#include <math.h>
+
+typedef unsigned char       uint8;
+typedef unsigned short      uint16;
+typedef unsigned int        uint32;
+typedef signed char         int8;
+typedef short               int16;
+typedef int                 int32;
+
+typedef volatile uint8      vuint8;
+typedef volatile uint16     vuint16;
+typedef volatile uint32     vuint32;
+typedef volatile int8       vint8;
+typedef volatile int16      vint16;
+typedef volatile int32      vint32;
+
+#define interrupt(x)
+#define xdata
+
+#define SYSTEM_CLOCK_30M    (30000000)
+
+//-------------------------------------------------------------------------------------------------------------------
+// 寄存器 (mock_hal.c 中定义为普通变量)
+//-------------------------------------------------------------------------------------------------------------------
+extern uint8 ADC_CONTR, ADC_RES, ADC_RESL, ADCCFG, ADCTIM, EADC, PADC, PADCH;
+extern uint8 EA, IE, IE2, IP, IPH, AUXINTIF, P_SW2;
+extern uint8 T4H, T4L, TM4PS, T4T3M;
+extern volatile unsigned char TH1, TL1, TF1;
+extern uint8 TMOD, AUXR, TM1PS, TR1, ET1;
+
+#define TIM4_CLEAR_FLAG     (AUXINTIF &= ~(1 << 2))
+
+//-------------------------------------------------------------------------------------------------------------------
+// zf_common_clock / zf_common_debug
+//-------------------------------------------------------------------------------------------------------------------
+extern uint32 system_clock;
+void    clock_init          (uint32 clock);
+void    debug_init          (void);
+void    debug_assert_handler(uint8 pass, char *file, int line);
+#define zf_assert(x)        (debug_assert_handler((x), __FILE__, __LINE__))
+
+#define DEBUG_UART_TX_ASYNC (1)
+#define DEBUG_TX_BUFFER_LEN (1024)
+typedef struct
+{
+    uint32 queued;
+    uint32 sent;
+    uint32 dropped;
+    uint32 chunks;
+    uint16 blocked;
+    uint16 peak;
+    uint16 pending;
+}debug_tx_stat_struct;
+
+void    debug_tx_get_stat   (debug_tx_stat_struct *stat);
+void    debug_tx_flush      (void);
+uint16  debug_tx_write      (const uint8 *buff, uint16 len);
+uint32  debug_send_buffer   (const uint8 *buff, uint32 len);
+uint32  debug_read_buffer   (uint8 *buff, uint32 len);
+
+//-------------------------------------------------------------------------------------------------------------------
+// zf_common_typedef 中断回调
+//-------------------------------------------------------------------------------------------------------------------
+extern void (*tim1_irq_handler)(void);
+extern void (*tim2_irq_handler)(void);
+extern void (*tim4_irq_handler)(void);
+extern void (*int2_irq_handler)(void);
+
+//-------------------------------------------------------------------------------------------------------------------
+// zf_driver_adc
+//-------------------------------------------------------------------------------------------------------------------
+typedef enum
+{
+    ADC_CH0_P10 = 0, ADC_CH1_P11, ADC_CH2_P12, ADC_CH3_P13, ADC_CH4_P14, ADC_CH5_P15, ADC_CH6_P16, ADC_CH7_P17,
+    ADC_CH8_P00, ADC_CH9_P01, ADC_CH10_P02, ADC_CH11_P03, ADC_CH12_P04, ADC_CH13_P05, ADC_CH14_P06, ADC_CH15_POWR,
+}adc_channel_enum;
+
+typedef enum
+{
+    ADC_12BIT = 0, ADC_11BIT, ADC_10BIT,
+}adc_resolution_enum;
+
+void    adc_init                (adc_channel_enum ch, adc_resolution_enum resolution);
+uint16  adc_convert             (adc_channel_enum ch);
+uint16  adc_mean_filter_convert (adc_channel_enum ch, const uint8 count);
+
+//-------------------------------------------------------------------------------------------------------------------
+// zf_driver_gpio
+//-------------------------------------------------------------------------------------------------------------------
+typedef enum
+{
+    IO_P00 = 0x00, IO_P01, IO_P04 = 0x04,
+    IO_P32 = 0x32, IO_P33, IO_P34, IO_P35, IO_P36,
+    IO_P46 = 0x46,
+    IO_P53 = 0x53,
+    IO_P60 = 0x60, IO_P61, IO_P65 = 0x65, IO_P67 = 0x67,
+    IO_P75 = 0x75, IO_P76, IO_P77,
+}gpio_pin_enum;
+
+enum { GPI = 0, GPO };
+enum { GPIO_LOW = 0, GPIO_HIGH };
+enum { GPI_FLOATING_IN = 0, GPI_PULL_UP, GPO_PUSH_PULL, GPO_OPEN_DTAIN };
+
+void    gpio_init           (int pin, int dir, int dat, int mode);
+uint8   gpio_get_level      (int pin);
+void    gpio_set_level      (int pin, int dat);
+void    gpio_high           (int pin);
+void    gpio_low            (int pin);
+void    gpio_toggle_level   (int pin);
+
+//-------------------------------------------------------------------------------------------------------------------
+// zf_driver_encoder
+//-------------------------------------------------------------------------------------------------------------------
+typedef enum
+{
+    TIM0_ENCOEDER = 0, TIM3_ENCOEDER,
+}encoder_index_enum;
+
+enum { TIM0_ENCOEDER_P34 = IO_P34, TIM3_ENCOEDER_P04 = IO_P04 };
+
+void    encoder_dir_init    (int encoder_n, int dir_pin, int lsb_pin);
+int16   encoder_get_count   (int encoder_n);
+void    encoder_clear_count (int encoder_n);
+
+//-------------------------------------------------------------------------------------------------------------------
+// zf_driver_pwm
+//-------------------------------------------------------------------------------------------------------------------
+typedef enum
+{
+    PWMA_CH3N_P65 = 0, PWMB_CH2_P75, PWMA_CH4N_P33,
+}pwm_channel_enum;
+
+#define PWM_DUTY_MAX        (10000)
+
+void    pwm_init            (int pwmch, uint32 freq, uint32 duty);
+void    pwm_set_duty        (int pwmch, uint32 duty);
+
+//-------------------------------------------------------------------------------------------------------------------
+// zf_driver_pit / zf_driver_delay
+//-------------------------------------------------------------------------------------------------------------------
+typedef enum
+{
+    TIM0_PIT = 0, TIM1_PIT, TIM2_PIT, TIM3_PIT, TIM4_PIT,
+}pit_index_enum;
+
+void    pit_init            (pit_index_enum pit_n, uint32 period);
+#define pit_ms_init(pit_n, ms)  (pit_init((pit_n), (ms) * (system_clock / 1000)))
+#define pit_us_init(pit_n, us)  (pit_init((pit_n), (us) * (system_clock / 1000000)))
+
+void    system_delay_ms     (uint32 time);
+void    system_delay_us     (uint32 time);
+
+//-------------------------------------------------------------------------------------------------------------------
+// zf_driver_exti
+//-------------------------------------------------------------------------------------------------------------------
+typedef enum
+{
+    INT0_P32 = 0, INT1_P33, INT2_P36, INT3_P37, INT4_P30,
+}exti_pin_enum;
+
+typedef enum
+{
+    EXTI_TRIGGER_FALLING = 0, EXTI_TRIGGER_BOTH,
+}exti_trigger_enum;
+
+void    exti_init           (exti_pin_enum pin, exti_trigger_enum trigger);
+
+//-------------------------------------------------------------------------------------------------------------------
+// zf_driver_eeprom
+//-------------------------------------------------------------------------------------------------------------------
+void    iap_init            (void);
+uint8   iap_read_byte       (uint32 addr);
+void    iap_write_byte      (uint32 addr, uint8 dat);
+void    iap_erase_page      (uint32 addr);
+
+//-------------------------------------------------------------------------------------------------------------------
+// zf_device_imu660rb
+//-------------------------------------------------------------------------------------------------------------------
+#define IMU660RB_USE_DMA            (0)                         // 与库默认的 SOFT_SPI 一致
+#define IMU660RB_FIFO_WATERMARK     (5)
+#define IMU660RB_FIFO_READ_MAX      (16)
+
+typedef struct
+{
+    int16 gyro_x, gyro_y, gyro_z;
+    int16 acc_x, acc_y, acc_z;
+}imu660rb_sample_struct;
+
+extern int16 imu660rb_gyro_x, imu660rb_gyro_y, imu660rb_gyro_z;
+extern int16 imu660rb_acc_x, imu660rb_acc_y, imu660rb_acc_z;
+extern void (*imu660rb_dma_callback)(void);
+
+uint8   imu660rb_init                   (void);
+void    imu660rb_get_acc                (void);
+void    imu660rb_get_gyro               (void);
+void    imu660rb_get_acc_gyro           (void);
+float   imu660rb_acc_transition         (int16 acc_value);
+float   imu660rb_gyro_transition        (int16 gyro_value);
+void    imu660rb_fifo_init              (void);
+uint16  imu660rb_fifo_count             (void);
+uint16  imu660rb_fifo_read              (imu660rb_sample_struct *sample, uint8 *sample_num);
+uint8   imu660rb_dma_busy               (void);
+uint8   imu660rb_get_acc_gyro_dma       (void);
+void    imu660rb_get_acc_gyro_dma_finish(void);
+uint8   imu660rb_fifo_read_dma          (void);
+uint8   imu660rb_fifo_read_dma_finish   (imu660rb_sample_struct *sample);
+
+//-------------------------------------------------------------------------------------------------------------------
+// 用户头文件 (与 Libraries/zf_common/zf_common_headfile.h 的顺序一致)
+//-------------------------------------------------------------------------------------------------------------------
+#include "motor.h"
+#include "key.h"
+#include "adc.h"
+#include "uart.h"
+#include "encoder.h"
+#include "pid.h"
+#include "normalization.h"
+#include "control.h"
+#include "IMU.h"
+#include "task.h"
+#include "quaternion.h"
+#include "oled.h"
+#include "ui.h"
+#include "adc_filter.h"
+#include "median.h"
+#include "snapshot.h"
+#include "track_metrics.h"
+#include "fastmath.h"
+#include "gyro_bias.h"
+#include "scheduler.h"
+#include "timebase.h"
+#include "profiler.h"
+
+#endif
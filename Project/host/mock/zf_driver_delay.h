@@ -0,0 +1 @@
+#include "zf_common_headfile.h"
@@ -0,0 +1,18 @@
+#ifndef _zf_driver_soft_iic_h_
+#define _zf_driver_soft_iic_h_
+
+#include "zf_common_headfile.h"
+
+// 主机编译用的 zf_driver_soft_iic.h 代替文件，只声明 oled.c 用到的接口 (mock_hal.c 中为空实现)
+typedef struct
+{
+    uint32 delay;
+    uint8 addr;
+    int scl_pin;
+    int sda_pin;
+}soft_iic_info_struct;
+
+void soft_iic_init                  (soft_iic_info_struct *soft_iic_obj, uint8 addr, uint32 delay, int scl_pin, int sda_pin);
+void soft_iic_write_8bit_array      (soft_iic_info_struct *soft_iic_obj, const uint8 *data, uint32 len);
+
+#endif
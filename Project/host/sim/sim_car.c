@@ -0,0 +1,180 @@
+//-------------------------------------------------------------------------------------------------------------------
+// 头文件包含
+//-------------------------------------------------------------------------------------------------------------------
+#include "sim_car.h"
+#include "sim_track.h"
+#include "mock_hal.h"
+
+//-------------------------------------------------------------------------------------------------------------------
+// 私有变量
+//-------------------------------------------------------------------------------------------------------------------
+static const float sensor_lateral[5] = {SIM_SENSOR_L1, SIM_SENSOR_L2, SIM_SENSOR_M3, SIM_SENSOR_R4, SIM_SENSOR_R5};
+
+static sim_car_t *sim_car = NULL;                           // ADC 回调读取的车辆
+static float sim_adc_noise = 0;
+static float sim_gyro_bias = 0;
+static uint32 sim_rand_state = 1;
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     高斯噪声
+// 参数说明     sigma           标准差
+// 返回参数     float           噪声
+// 备注信息     固定种子的线性同余发生器，同一场景每次运行结果相同
+//-------------------------------------------------------------------------------------------------------------------
+static float sim_gauss(float sigma)
+{
+    float u1;
+    float u2;
+
+    sim_rand_state = sim_rand_state * 1103515245u + 12345u;
+    u1 = ((sim_rand_state >> 8) + 1.0f) / 16777217.0f;
+    sim_rand_state = sim_rand_state * 1103515245u + 12345u;
+    u2 = (sim_rand_state >> 8) / 16777216.0f;
+
+    return sigma * sqrtf(-2.0f * logf(u1)) * cosf(2.0f * (float)M_PI * u2);
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     ADC 转换回调 (mock_adc_source)
+// 参数说明     ch              ADC 通道
+// 返回参数     uint16          对应电感的读数 + 噪声，不是电感通道时返回0
+//-------------------------------------------------------------------------------------------------------------------
+static uint16 sim_adc_source(adc_channel_enum ch)
+{
+    float val;
+    uint8 i;
+
+    for(i = 0; i < CHANNEL_NUMBER; i++)
+    {
+        if(channel_list[i] == ch)
+        {
+            val = sim_car->adc[i] + sim_gauss(sim_adc_noise) + 0.5f;
+            if(val < 0)
+            {
+                return 0;
+            }
+            return (val > 4095.0f) ? 4095 : (uint16)val;
+        }
+    }
+
+    return 0;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     计算5个电感的读数
+// 参数说明     car             车辆状态
+// 返回参数     void
+//-------------------------------------------------------------------------------------------------------------------
+static void sim_sensor_update(sim_car_t *car)
+{
+    float c;
+    float s;
+    float px;
+    float py;
+    float b[3];
+    float gain;
+    uint8 i;
+
+    // 无限长直导线正上方横向磁场为 2/h
+    gain = SIM_ADC_OVER_WIRE * SIM_SENSOR_HEIGHT * 0.5f;
+    c = cosf(car->heading);
+    s = sinf(car->heading);
+    sim_field_select(car->x, car->y);
+    for(i = 0; i < CHANNEL_NUMBER; i++)
+    {
+        px = car->x + SIM_SENSOR_FORWARD * c - sensor_lateral[i] * s;
+        py = car->y + SIM_SENSOR_FORWARD * s + sensor_lateral[i] * c;
+        sim_field_at(px, py, SIM_SENSOR_HEIGHT, b);
+        car->adc[i] = gain * fabsf(-b[0] * s + b[1] * c);
+    }
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     一个电机的轮速更新
+// 参数说明     v               当前轮速 (m/s)
+// 参数说明     pwm             PWM 通道
+// 参数说明     dir             方向引脚
+// 参数说明     dt              步长 (s)
+// 返回参数     float           新的轮速 (m/s)
+//-------------------------------------------------------------------------------------------------------------------
+static float sim_motor_step(float v, int pwm, int dir, float dt)
+{
+    float u;
+
+    u = (float)mock_pwm_duty[pwm] / PWM_DUTY_MAX;
+    if(mock_gpio_level[dir] == GPIO_LOW)
+    {
+        u = -u;
+    }
+
+    return v + (SIM_MOTOR_VMAX * u - v) * dt / SIM_MOTOR_TAU;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     编码器计数累加
+// 参数说明     acc             未输出的小数计数
+// 参数说明     v               轮速 (m/s)
+// 参数说明     encoder         编码器
+// 参数说明     dt              步长 (s)
+// 返回参数     void
+//-------------------------------------------------------------------------------------------------------------------
+static void sim_encoder_step(float *acc, float v, int encoder, float dt)
+{
+    int16 n;
+
+    *acc += v * SIM_ENCODER_PER_M * dt;
+    n = (int16)*acc;
+    *acc -= n;
+    mock_encoder_count[encoder] += n;
+}
+
+void sim_car_init(sim_car_t *car, float x, float y, float heading, float adc_noise, float gyro_bias, uint32 seed)
+{
+    memset(car, 0, sizeof(*car));
+    car->x = x;
+    car->y = y;
+    car->heading = heading;
+
+    sim_car = car;
+    sim_adc_noise = adc_noise;
+    sim_gyro_bias = gyro_bias;
+    sim_rand_state = seed;
+    mock_adc_source = sim_adc_source;
+
+    sim_sensor_update(car);
+}
+
+void sim_car_step(sim_car_t *car, float dt)
+{
+    float v_left;
+    float v_right;
+    float v_last;
+    float v;
+
+    v_last = (car->v_left + car->v_right) * 0.5f;
+    v_left = sim_motor_step(car->v_left, PWM_L, DIR_L, dt);
+    v_right = sim_motor_step(car->v_right, PWM_R, DIR_R, dt);
+    car->v_left = v_left;
+    car->v_right = v_right;
+
+    // 差速运动学 (不考虑侧滑)
+    v = (v_left + v_right) * 0.5f;
+    car->omega = (v_right - v_left) / SIM_WHEEL_TRACK;
+    car->accel = (v - v_last) / dt;
+    car->heading += car->omega * dt;
+    car->x += v * cosf(car->heading) * dt;
+    car->y += v * sinf(car->heading) * dt;
+
+    sim_encoder_step(&car->enc_left, v_left, ENCODER_DIR_L, dt);
+    sim_encoder_step(&car->enc_right, v_right, ENCODER_DIR_R, dt);
+
+    // IMU 水平安装，Z 轴向上
+    mock_imu_sample.gyro_x = (int16)sim_gauss(2.0f);
+    mock_imu_sample.gyro_y = (int16)sim_gauss(2.0f);
+    mock_imu_sample.gyro_z = (int16)((car->omega * 180.0f / (float)M_PI + sim_gyro_bias) * SIM_GYRO_LSB_PER_DPS + sim_gauss(2.0f));
+    mock_imu_sample.acc_x = (int16)(car->accel / 9.8f * SIM_ACC_LSB_PER_G + sim_gauss(8.0f));
+    mock_imu_sample.acc_y = (int16)(v * car->omega / 9.8f * SIM_ACC_LSB_PER_G + sim_gauss(8.0f));
+    mock_imu_sample.acc_z = (int16)(SIM_ACC_LSB_PER_G + sim_gauss(8.0f));
+
+    sim_sensor_update(car);
+}
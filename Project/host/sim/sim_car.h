@@ -0,0 +1,83 @@
+#ifndef _SIM_CAR_H_
+#define _SIM_CAR_H_
+
+//-------------------------------------------------------------------------------------------------------------------
+// 头文件包含
+//-------------------------------------------------------------------------------------------------------------------
+#include "zf_common_headfile.h"
+
+//-------------------------------------------------------------------------------------------------------------------
+// 说明
+//-------------------------------------------------------------------------------------------------------------------
+// 仿真车辆: 两轮差速运动学 + 一阶电机模型，传感器通过 mock HAL 输入到 Project/code 的控制程序
+//   电机: 读 mock_pwm_duty[] 和方向引脚电平，dv/dt = (SIM_MOTOR_VMAX * 占空比 - v) / SIM_MOTOR_TAU
+//   编码器: 轮速按 SIM_ENCODER_PER_M 换算为计数累加到 mock_encoder_count[] (小数部分保留到下一步)
+//   电感: 5个电感在车头横向排列 (顺序与 adc.c 中 channel_list[] 相同)，线圈轴线沿车身横向，
+//         读数为横向磁场绝对值，导线正上方读数约 SIM_ADC_OVER_WIRE，加高斯噪声后限幅到 0-4095
+//   IMU: 陀螺仪 Z 轴为车身角速度，加速度计为前向/向心加速度 + 1g，原始值写入 mock_imu_sample
+// 以下参数按实际车测量修改
+
+//-------------------------------------------------------------------------------------------------------------------
+// 宏定义
+//-------------------------------------------------------------------------------------------------------------------
+#define SIM_WHEEL_TRACK             (0.16f)     // 轮距 (m)
+#define SIM_MOTOR_VMAX              (5.0f)      // 100% 占空比的空载轮速 (m/s)
+#define SIM_MOTOR_TAU               (0.08f)     // 电机时间常数 (s)
+#define SIM_ENCODER_PER_M           (2000.0f)   // 编码器计数每米
+
+#define SIM_SENSOR_FORWARD          (0.20f)     // 电感排到后轮轴的距离 (m)
+#define SIM_SENSOR_HEIGHT           (0.04f)     // 电感离地高度 (m)
+#define SIM_SENSOR_L1               (0.12f)     // 各电感横向位置 (m，左正)
+#define SIM_SENSOR_L2               (0.06f)
+#define SIM_SENSOR_M3               (0.0f)
+#define SIM_SENSOR_R4               (-0.06f)
+#define SIM_SENSOR_R5               (-0.12f)
+#define SIM_ADC_OVER_WIRE           (3400.0f)   // 长直导线正上方的ADC读数
+
+#define SIM_ACC_LSB_PER_G           (4098.0f)   // 与 imu660rb_acc_transition() 一致
+#define SIM_GYRO_LSB_PER_DPS        (14.3f)     // 与 imu660rb_gyro_transition() 一致
+
+//-------------------------------------------------------------------------------------------------------------------
+// 数据结构
+//-------------------------------------------------------------------------------------------------------------------
+typedef struct
+{
+    float x, y;                           // 后轮轴中点位置 (m)
+    float heading;                        // 航向 (rad，逆时针为正)
+    float v_left;                         // 左轮速度 (m/s)
+    float v_right;                        // 右轮速度 (m/s)
+    float omega;                          // 角速度 (rad/s)
+    float accel;                          // 前向加速度 (m/s^2)
+    float enc_left;                       // 未输出的编码器小数计数
+    float enc_right;
+    float adc[5];                         // 5个电感的无噪声读数 (channel_list[] 顺序)
+} sim_car_t;
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数声明
+//-------------------------------------------------------------------------------------------------------------------
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     车辆和传感器模型初始化
+// 参数说明     car             车辆状态
+// 参数说明     x y heading     起始位置 (m) 和航向 (rad)
+// 参数说明     adc_noise       ADC 噪声标准差 (LSB)
+// 参数说明     gyro_bias       陀螺仪 Z 轴零偏 (°/s)
+// 参数说明     seed            噪声随机数种子
+// 返回参数     void
+// 使用示例     sim_car_init(&car, 0, 0, 0, 8.0f, 0.0f, 1);
+// 备注信息     设置 mock_adc_source，之后 ADC 转换读出电感模型的值
+//-------------------------------------------------------------------------------------------------------------------
+void sim_car_init(sim_car_t *car, float x, float y, float heading, float adc_noise, float gyro_bias, uint32 seed);
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     车辆前进一个仿真步
+// 参数说明     car             车辆状态
+// 参数说明     dt              步长 (s)
+// 返回参数     void
+// 使用示例     sim_car_step(&car, 0.001f);
+// 备注信息     按当前 PWM 输出更新轮速和位置，累加编码器计数，更新 IMU 输出和电感读数
+//-------------------------------------------------------------------------------------------------------------------
+void sim_car_step(sim_car_t *car, float dt);
+
+#endif
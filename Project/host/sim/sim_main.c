@@ -0,0 +1,298 @@
+//-------------------------------------------------------------------------------------------------------------------
+// 头文件包含
+//-------------------------------------------------------------------------------------------------------------------
+#include "zf_common_headfile.h"
+#include "mock_hal.h"
+#include "myeeprom.h"
+#include "sim_track.h"
+#include "sim_car.h"
+
+//-------------------------------------------------------------------------------------------------------------------
+// 说明
+//-------------------------------------------------------------------------------------------------------------------
+// 软件在环仿真: 赛道 + 车辆模型每 1ms 前进一步，Project/code 的控制程序由调度器节拍 (TIM1 中断) 驱动，
+// 与车上相同的初始化顺序和前台任务表，只有后台任务 (显示、按键、串口) 不运行
+//   ./build/sim_runner                      列出场景
+//   ./build/sim_runner 场景名 [trace.csv]   运行一个场景，可选输出每个控制周期的轨迹
+// 每圈输出 Track_Metrics 的统计 (与车上串口输出的格式相同，传感器位置误差) 和几何横向偏差 cte (电感排中心到导线的距离)，
+// 控制效果以 cte 为准。最后输出一行 PASS (跑完全部圈数，返回0) 或 FAIL 和原因 (出线、超时，返回1)，
+// make sim 运行全部场景，有场景 FAIL 时返回非0
+// 仿真编译时 TRACK_METRICS_ENABLE 为1、CONTROL_SELECT_METHOD 为按键切换 (见 Makefile)，场景开始前请求控制模式
+
+//-------------------------------------------------------------------------------------------------------------------
+// 宏定义
+//-------------------------------------------------------------------------------------------------------------------
+#define SIM_STEP_US                 (1000)      // 仿真步长 (us)，与调度器节拍相同
+#define SIM_OFF_TRACK               (0.30f)     // 电感排离导线超过此距离 (m) 视为出线，停止仿真
+
+#if(TRACK_METRICS_ENABLE == 0)
+#error "sim must be built with TRACK_METRICS_ENABLE=1"
+#endif
+#if(CONTROL_SELECT_METHOD != CONTROL_SELECT_METHOD_KEY)
+#error "sim must be built with CONTROL_SELECT_METHOD=CONTROL_SELECT_METHOD_KEY"
+#endif
+#if(IMU_USE_FIFO)
+#error "sim only models the polled IMU (IMU_USE_FIFO 0)"
+#endif
+
+//-------------------------------------------------------------------------------------------------------------------
+// 数据结构
+//-------------------------------------------------------------------------------------------------------------------
+typedef struct
+{
+    const char *name;                     // 场景名称
+    const sim_track_def_t *track;         // 赛道
+    uint8 mode;                           // 控制模式 CONTROL_MODE_xxx
+    float speed;                          // 目标速度 (编码器计数每10ms)
+    uint8 laps;                           // 圈数
+    float adc_noise;                      // ADC 噪声标准差 (LSB)
+    float gyro_bias;                      // 陀螺仪 Z 轴零偏 (°/s，仿真开始前已存入 EEPROM)
+    uint32 time_limit_ms;                 // 最长仿真时间
+} sim_scenario_t;
+
+typedef struct
+{
+    uint32 ticks;                         // 控制周期数
+    float cte_sq_sum;                     // 横向偏差平方和 (m^2)
+    float cte_peak;                       // 横向偏差绝对值最大值 (m)
+} sim_lap_t;
+
+//-------------------------------------------------------------------------------------------------------------------
+// 私有变量
+//-------------------------------------------------------------------------------------------------------------------
+// 前台任务表与 main.c 相同
+static const sched_task_t fg_tasks[] =
+{
+    // 名称        任务函数                  周期(ms)                   相位               优先级  预算(us)
+    {"direction",  direction_control_task,  CONTROL_DIRECTION_PERIOD,  0,                 0,      2000},
+    {"speed",      speed_control_task,      CONTROL_SPEED_PERIOD,      0,                 1,      1000},
+    {"imu",        imu_update_task,         IMU_UPDATE_PERIOD,         IMU_UPDATE_PHASE,  2,      2000},
+};
+
+static const sim_scenario_t scenarios[] =
+{
+    // 名称              赛道                 控制模式                    速度   圈数  ADC噪声  零偏   时间限制(ms)
+    {"oval-sdsd",       &sim_track_oval,     CONTROL_MODE_SDSD,          30.0f, 3,    8.0f,    0.0f,  150000},
+    {"oval-pd",         &sim_track_oval,     CONTROL_MODE_PD_DIRECTION,  30.0f, 3,    8.0f,    0.0f,  150000},
+    {"ring-sdsd",       &sim_track_ring,     CONTROL_MODE_SDSD,          30.0f, 3,    8.0f,    0.0f,  150000},
+    {"ring-pd",         &sim_track_ring,     CONTROL_MODE_PD_DIRECTION,  30.0f, 3,    8.0f,    0.0f,  150000},
+    {"chicane-sdsd",    &sim_track_chicane,  CONTROL_MODE_SDSD,          30.0f, 3,    8.0f,    0.0f,  150000},
+    {"chicane-sdsd-40", &sim_track_chicane,  CONTROL_MODE_SDSD,          40.0f, 3,    8.0f,    0.0f,  150000},
+    {"oval-sdsd-noisy", &sim_track_oval,     CONTROL_MODE_SDSD,          30.0f, 3,   40.0f,    1.0f,  150000},
+};
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     初始化控制程序
+// 参数说明     sc              场景
+// 返回参数     void
+// 备注信息     与 main() 的初始化顺序相同，陀螺仪零偏预先存入 EEPROM (相当于车上已完成过冷启动标定)
+//-------------------------------------------------------------------------------------------------------------------
+static void sim_control_init(const sim_scenario_t *sc)
+{
+    int32 bias[3];
+
+    mock_hal_reset();
+    clock_init(SYSTEM_CLOCK_30M);
+    tim4_irq_handler = timebase_overflow_handler;
+    timebase_init();
+
+    myeeprom_init();
+    bias[0] = 0;
+    bias[1] = 0;
+    bias[2] = (int32)(sc->gyro_bias * SIM_GYRO_LSB_PER_DPS * (1 << GYRO_BIAS_FRAC_BITS));
+    myeeprom_save_gyro_bias(bias);
+
+    Motor_Init();
+    mock_adc_irq_handler = Adc_Scan_Isr;
+    Adc_All_Init();
+    Encoder_Init();
+    imu_init();
+    control_mode_init();
+
+    myeeprom_load_speed_pid(&pid_motor_left, &pid_motor_right);
+    pid_motor_left.target = sc->speed;
+    pid_motor_right.target = sc->speed;
+    pid_fixed_sync_motor();
+
+    // 第一个方向控制周期切换到场景的控制模式
+    control_mode_request(sc->mode);
+
+    tim1_irq_handler = scheduler_tick;
+    sched_overrun_handler = control_overrun_handler;
+    scheduler_init(fg_tasks, sizeof(fg_tasks) / sizeof(fg_tasks[0]), NULL, 0);
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     输出一圈的统计
+// 参数说明     metrics         Track_Metrics 快照
+// 参数说明     lap             几何横向偏差统计
+// 返回参数     void
+//-------------------------------------------------------------------------------------------------------------------
+static void sim_report_lap(const track_metrics_t *metrics, const sim_lap_t *lap)
+{
+    printf("  Lap %d: time=%.2fs, sensor rms=%.2f, sensor peak=%.2f, lost=%u | cte rms=%.1fmm, peak=%.1fmm\r\n",
+           metrics->laps,
+           track_run_time(&metrics->last_lap),
+           track_run_sensor_rms(&metrics->last_lap),
+           metrics->last_lap.sensor_peak,
+           metrics->last_lap.lost_ticks,
+           (lap->ticks ? sqrtf(lap->cte_sq_sum / lap->ticks) : 0.0f) * 1000.0f,
+           lap->cte_peak * 1000.0f);
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     运行一个场景
+// 参数说明     sc              场景
+// 参数说明     trace           轨迹输出文件，NULL 不输出
+// 返回参数     int             0-跑完全部圈数 1-出线或超时
+//-------------------------------------------------------------------------------------------------------------------
+static int sim_run(const sim_scenario_t *sc, FILE *trace)
+{
+    sim_car_t car;
+    sim_track_pos_t pos;
+    sim_lap_t lap;
+    track_metrics_t metrics;
+    uint16 laps_reported;
+    float last_s;
+    float fx;
+    float fy;
+    float len;
+    uint32 t;
+
+    if(sim_track_build(sc->track))
+    {
+        printf("FAIL %s: track %s does not close\r\n", sc->name, sc->track->name);
+        return 1;
+    }
+    len = sim_track_length();
+
+    sim_control_init(sc);
+    sim_car_init(&car, 0, 0, 0, sc->adc_noise, sc->gyro_bias, 1);
+
+    printf("%s: track %s (%.2fm), mode %d, speed %.0f, adc noise %.0f, gyro bias %.1fdps\r\n",
+           sc->name, sc->track->name, len, sc->mode, sc->speed, sc->adc_noise, sc->gyro_bias);
+    if(trace)
+    {
+        fprintf(trace, "t_ms,lap,s,x,y,heading,cte_mm,v_left,v_right,error,valid,duty_left,duty_right,"
+                       "adc0,adc1,adc2,adc3,adc4\n");
+    }
+
+    memset(&lap, 0, sizeof(lap));
+    laps_reported = 0;
+    pos.index = 0;
+    last_s = 0;
+    for(t = 1; t <= sc->time_limit_ms; t++)
+    {
+        // 车辆和传感器前进一步，ADC 后台扫描一帧，然后是调度器节拍
+        sim_car_step(&car, SIM_STEP_US * 1e-6f);
+        mock_set_time_us(t * SIM_STEP_US);
+        mock_adc_run(CHANNEL_NUMBER * ADC_SCAN_DEPTH);
+        tim1_irq_handler();
+#if(IMU660RB_USE_DMA)
+        while(mock_imu_dma_service());
+#endif
+
+        // 电感排中心到导线的几何距离
+        fx = car.x + SIM_SENSOR_FORWARD * cosf(car.heading);
+        fy = car.y + SIM_SENSOR_FORWARD * sinf(car.heading);
+        sim_track_locate(fx, fy, pos.index, &pos);
+        if(fabsf(pos.cte) > SIM_OFF_TRACK)
+        {
+            printf("FAIL %s: off track at t=%.2fs, s=%.2fm (lap %d)\r\n", sc->name, t * 1e-3f, pos.s, laps_reported + 1);
+            return 1;
+        }
+
+        // 过起点 (沿线距离回绕) 时标记一圈结束，与车上过起跑线按 KEY4 相同
+        if(pos.s < last_s - len * 0.5f)
+        {
+            Track_Metrics_Lap();
+        }
+        last_s = pos.s;
+
+        if(t % CONTROL_DIRECTION_PERIOD)
+        {
+            continue;
+        }
+
+        // 每个控制周期统计几何偏差，Track_Metrics 的一圈在标记后的下一个控制周期结束
+        Track_Metrics_Snapshot(&metrics);
+        if(metrics.laps != laps_reported)
+        {
+            laps_reported = metrics.laps;
+            sim_report_lap(&metrics, &lap);
+            memset(&lap, 0, sizeof(lap));
+            if(laps_reported >= sc->laps)
+            {
+                printf("PASS %s: %d laps\r\n", sc->name, laps_reported);
+                return 0;
+            }
+        }
+        lap.ticks++;
+        lap.cte_sq_sum += pos.cte * pos.cte;
+        if(fabsf(pos.cte) > lap.cte_peak)
+        {
+            lap.cte_peak = fabsf(pos.cte);
+        }
+
+        if(trace)
+        {
+            fprintf(trace, "%u,%d,%.3f,%.4f,%.4f,%.2f,%.1f,%.3f,%.3f,%.2f,%d,%d,%d,%d,%d,%d,%d,%d\n",
+                    t, laps_reported, pos.s, car.x, car.y, car.heading * 180.0f / (float)M_PI, pos.cte * 1000.0f,
+                    car.v_left, car.v_right, position_error_calc(), sensor_check_valid(),
+                    (mock_gpio_level[DIR_L] == GPIO_LOW) ? -(int)mock_pwm_duty[PWM_L] : (int)mock_pwm_duty[PWM_L],
+                    (mock_gpio_level[DIR_R] == GPIO_LOW) ? -(int)mock_pwm_duty[PWM_R] : (int)mock_pwm_duty[PWM_R],
+                    (int)car.adc[0], (int)car.adc[1], (int)car.adc[2], (int)car.adc[3], (int)car.adc[4]);
+        }
+    }
+
+    printf("FAIL %s: time limit %.0fs reached after %d laps\r\n", sc->name, sc->time_limit_ms * 1e-3f, laps_reported);
+    return 1;
+}
+
+int main(int argc, char *argv[])
+{
+    FILE *trace;
+    int result;
+    uint8 i;
+
+    if(argc < 2)
+    {
+        for(i = 0; i < sizeof(scenarios) / sizeof(scenarios[0]); i++)
+        {
+            printf("%s\n", scenarios[i].name);
+        }
+        return 0;
+    }
+
+    for(i = 0; i < sizeof(scenarios) / sizeof(scenarios[0]); i++)
+    {
+        if(strcmp(argv[1], scenarios[i].name) == 0)
+        {
+            break;
+        }
+    }
+    if(i == sizeof(scenarios) / sizeof(scenarios[0]))
+    {
+        printf("unknown scenario %s\r\n", argv[1]);
+        return 2;
+    }
+
+    trace = NULL;
+    if(argc > 2)
+    {
+        trace = fopen(argv[2], "w");
+        if(trace == NULL)
+        {
+            printf("cannot open %s\r\n", argv[2]);
+            return 2;
+        }
+    }
+
+    result = sim_run(&scenarios[i], trace);
+
+    if(trace)
+    {
+        fclose(trace);
+    }
+    return result;
+}
@@ -0,0 +1,252 @@
+//-------------------------------------------------------------------------------------------------------------------
+// 头文件包含
+//-------------------------------------------------------------------------------------------------------------------
+#include "sim_track.h"
+
+//-------------------------------------------------------------------------------------------------------------------
+// 赛道定义
+//-------------------------------------------------------------------------------------------------------------------
+static const sim_segment_t oval_seg[] =
+{
+    {SIM_SEG_STRAIGHT,  3.0f, 0.0f,   0.0f},
+    {SIM_SEG_ARC,       0.0f, 0.8f, 180.0f},
+    {SIM_SEG_STRAIGHT,  3.0f, 0.0f,   0.0f},
+    {SIM_SEG_ARC,       0.0f, 0.8f, 180.0f},
+};
+
+static const sim_segment_t ring_seg[] =
+{
+    {SIM_SEG_STRAIGHT,  1.5f, 0.0f,   0.0f},
+    {SIM_SEG_RING,      0.0f, 0.5f, 360.0f},
+    {SIM_SEG_STRAIGHT,  1.5f, 0.0f,   0.0f},
+    {SIM_SEG_ARC,       0.0f, 0.8f, 180.0f},
+    {SIM_SEG_STRAIGHT,  3.0f, 0.0f,   0.0f},
+    {SIM_SEG_ARC,       0.0f, 0.8f, 180.0f},
+};
+
+// S弯: 左30度 + 右60度 + 左30度，出弯后回到原直线
+static const sim_segment_t chicane_seg[] =
+{
+    {SIM_SEG_STRAIGHT,  1.0f, 0.0f,   0.0f},
+    {SIM_SEG_ARC,       0.0f, 1.0f,  30.0f},
+    {SIM_SEG_ARC,       0.0f, 1.0f, -60.0f},
+    {SIM_SEG_ARC,       0.0f, 1.0f,  30.0f},
+    {SIM_SEG_STRAIGHT,  1.0f, 0.0f,   0.0f},
+    {SIM_SEG_ARC,       0.0f, 0.8f, 180.0f},
+    {SIM_SEG_STRAIGHT,  4.0f, 0.0f,   0.0f},
+    {SIM_SEG_ARC,       0.0f, 0.8f, 180.0f},
+};
+
+const sim_track_def_t sim_track_oval    = {"oval",    oval_seg,    sizeof(oval_seg) / sizeof(oval_seg[0])};
+const sim_track_def_t sim_track_ring    = {"ring",    ring_seg,    sizeof(ring_seg) / sizeof(ring_seg[0])};
+const sim_track_def_t sim_track_chicane = {"chicane", chicane_seg, sizeof(chicane_seg) / sizeof(chicane_seg[0])};
+
+//-------------------------------------------------------------------------------------------------------------------
+// 私有变量
+//-------------------------------------------------------------------------------------------------------------------
+static float track_x[SIM_TRACK_POINT_MAX];                  // 导线点 (闭合，最后一点与第一点相连)
+static float track_y[SIM_TRACK_POINT_MAX];
+static float track_h[SIM_TRACK_POINT_MAX];                  // 点 i 到点 i+1 的方向
+static float track_s[SIM_TRACK_POINT_MAX];                  // 点 i 的沿线距离
+static uint16 track_num = 0;
+static float track_len = 0;
+
+static uint16 field_list[SIM_TRACK_POINT_MAX];              // sim_field_select() 选出的线段起点下标
+static uint16 field_num = 0;
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     追加一个导线点
+// 参数说明     x y             坐标 (m)
+// 返回参数     uint8           0-成功 1-点数已满
+//-------------------------------------------------------------------------------------------------------------------
+static uint8 track_add(float x, float y)
+{
+    if(track_num >= SIM_TRACK_POINT_MAX)
+    {
+        return 1;
+    }
+    track_x[track_num] = x;
+    track_y[track_num] = y;
+    track_num++;
+    return 0;
+}
+
+uint8 sim_track_build(const sim_track_def_t *def)
+{
+    const sim_segment_t *seg;
+    float x;
+    float y;
+    float h;
+    float angle;
+    float step;
+    float dx;
+    float dy;
+    uint16 n;
+    uint16 i;
+    uint8 k;
+
+    x = 0;
+    y = 0;
+    h = 0;
+    track_num = 0;
+    track_add(x, y);
+
+    for(k = 0; k < def->seg_num; k++)
+    {
+        seg = &def->seg[k];
+        if(seg->type == SIM_SEG_STRAIGHT)
+        {
+            n = (uint16)(seg->length / SIM_TRACK_STEP + 0.5f);
+            step = seg->length / n;
+            for(i = 0; i < n; i++)
+            {
+                x += step * cosf(h);
+                y += step * sinf(h);
+                if(track_add(x, y))
+                {
+                    return 1;
+                }
+            }
+        }
+        else
+        {
+            // 弯道和圆环按弦长前进，弦的方向为本步起止方向的平均值
+            angle = seg->angle * (float)M_PI / 180.0f;
+            n = (uint16)(fabsf(angle) * seg->radius / SIM_TRACK_STEP + 0.5f);
+            angle /= n;
+            step = 2.0f * seg->radius * sinf(fabsf(angle) * 0.5f);
+            for(i = 0; i < n; i++)
+            {
+                x += step * cosf(h + angle * 0.5f);
+                y += step * sinf(h + angle * 0.5f);
+                h += angle;
+                if(track_add(x, y))
+                {
+                    return 1;
+                }
+            }
+        }
+    }
+
+    // 最后一点应回到起点，去掉后首尾相连
+    if(sqrtf(x * x + y * y) > SIM_TRACK_CLOSE_GAP)
+    {
+        return 2;
+    }
+    track_num--;
+
+    track_len = 0;
+    for(i = 0; i < track_num; i++)
+    {
+        n = (i + 1) % track_num;
+        dx = track_x[n] - track_x[i];
+        dy = track_y[n] - track_y[i];
+        track_h[i] = atan2f(dy, dx);
+        track_s[i] = track_len;
+        track_len += sqrtf(dx * dx + dy * dy);
+    }
+
+    return 0;
+}
+
+float sim_track_length(void)
+{
+    return track_len;
+}
+
+void sim_track_locate(float x, float y, uint16 hint, sim_track_pos_t *out)
+{
+    float best;
+    float d;
+    float dx;
+    float dy;
+    uint16 best_i;
+    uint16 i;
+    int16 k;
+
+    // 只在 hint 之前 0.5m、之后 1.5m 内查找，圆环切点处不会跳到另一段导线
+    best = 1e9f;
+    best_i = hint;
+    for(k = -50; k <= 150; k++)
+    {
+        i = (uint16)(((int32)hint + k + track_num) % track_num);
+        dx = x - track_x[i];
+        dy = y - track_y[i];
+        d = dx * dx + dy * dy;
+        if(d < best)
+        {
+            best = d;
+            best_i = i;
+        }
+    }
+
+    dx = x - track_x[best_i];
+    dy = y - track_y[best_i];
+    out->index = best_i;
+    out->heading = track_h[best_i];
+    out->x = track_x[best_i];
+    out->y = track_y[best_i];
+    out->s = track_s[best_i] + dx * cosf(out->heading) + dy * sinf(out->heading);
+    out->cte = -dx * sinf(out->heading) + dy * cosf(out->heading);
+}
+
+void sim_field_select(float x, float y)
+{
+    float mx;
+    float my;
+    uint16 i;
+    uint16 n;
+
+    field_num = 0;
+    for(i = 0; i < track_num; i++)
+    {
+        n = (i + 1) % track_num;
+        mx = (track_x[i] + track_x[n]) * 0.5f - x;
+        my = (track_y[i] + track_y[n]) * 0.5f - y;
+        if(mx * mx + my * my < SIM_FIELD_RANGE * SIM_FIELD_RANGE)
+        {
+            field_list[field_num++] = i;
+        }
+    }
+}
+
+void sim_field_at(float x, float y, float z, float *b)
+{
+    float ax, ay, az;
+    float bx, by, bz;
+    float na;
+    float nb;
+    float den;
+    float k;
+    uint16 i;
+    uint16 n;
+    uint16 j;
+
+    b[0] = 0;
+    b[1] = 0;
+    b[2] = 0;
+
+    // 有限长直导线 A->B 在 P 点: B = (a x b)(|a|+|b|) / (|a||b|(|a||b| + a.b))，a = A-P，b = B-P
+    for(j = 0; j < field_num; j++)
+    {
+        i = field_list[j];
+        n = (i + 1) % track_num;
+        ax = track_x[i] - x;
+        ay = track_y[i] - y;
+        az = -z;
+        bx = track_x[n] - x;
+        by = track_y[n] - y;
+        bz = -z;
+        na = sqrtf(ax * ax + ay * ay + az * az);
+        nb = sqrtf(bx * bx + by * by + bz * bz);
+        den = na * nb * (na * nb + ax * bx + ay * by + az * bz);
+        if(den < 1e-12f)
+        {
+            continue;
+        }
+        k = (na + nb) / den;
+        b[0] += (ay * bz - az * by) * k;
+        b[1] += (az * bx - ax * bz) * k;
+        b[2] += (ax * by - ay * bx) * k;
+    }
+}
@@ -0,0 +1,114 @@
+#ifndef _SIM_TRACK_H_
+#define _SIM_TRACK_H_
+
+//-------------------------------------------------------------------------------------------------------------------
+// 头文件包含
+//-------------------------------------------------------------------------------------------------------------------
+#include "zf_common_headfile.h"
+
+//-------------------------------------------------------------------------------------------------------------------
+// 说明
+//-------------------------------------------------------------------------------------------------------------------
+// 仿真赛道: 电磁导线由直道、弯道、圆环段首尾相接组成，按 SIM_TRACK_STEP 离散为折线
+//   坐标系: x 向前 (起点方向)、y 向左、z 向上，单位 m；航向角逆时针为正，单位 rad
+//   圆环段: 从切点绕一整圈回到切点后沿原方向继续 (导线在切点处重合)
+//   磁场: 每段折线按有限长直导线 (毕奥-萨伐尔定律) 计算，只累加 SIM_FIELD_RANGE 以内的线段
+//         单位为 μ0I/4π，无限长直导线正上方高度 h 处的磁感应强度为 2/h
+
+//-------------------------------------------------------------------------------------------------------------------
+// 宏定义
+//-------------------------------------------------------------------------------------------------------------------
+#define SIM_TRACK_STEP              (0.01f)     // 导线离散步长 (m)
+#define SIM_TRACK_POINT_MAX         (8192)      // 导线最多点数 (赛道总长不超过 81m)
+#define SIM_FIELD_RANGE             (0.8f)      // 磁场计算范围 (m)，更远的线段忽略
+#define SIM_TRACK_CLOSE_GAP         (0.02f)     // 赛道首尾允许的最大间隙 (m)
+
+#define SIM_SEG_STRAIGHT            (0)         // 直道   length
+#define SIM_SEG_ARC                 (1)         // 弯道   radius, angle (度，正数左转，负数右转)
+#define SIM_SEG_RING                (2)         // 圆环   radius, angle 为 360 (左环) 或 -360 (右环)
+
+//-------------------------------------------------------------------------------------------------------------------
+// 数据结构
+//-------------------------------------------------------------------------------------------------------------------
+typedef struct
+{
+    uint8 type;                           // 段类型 SIM_SEG_xxx
+    float length;                         // 直道长度 (m)
+    float radius;                         // 弯道/圆环半径 (m)
+    float angle;                          // 弯道/圆环转角 (度)
+} sim_segment_t;
+
+typedef struct
+{
+    const char *name;                     // 赛道名称
+    const sim_segment_t *seg;             // 段表
+    uint8 seg_num;                        // 段数
+} sim_track_def_t;
+
+typedef struct
+{
+    float x, y;                           // 最近点坐标
+    float heading;                        // 导线方向 (rad)
+    float s;                              // 沿导线距离 (m)
+    float cte;                            // 横向偏差 (m，车在导线左侧为正)
+    uint16 index;                         // 最近点下标
+} sim_track_pos_t;
+
+//-------------------------------------------------------------------------------------------------------------------
+// 全局变量声明
+//-------------------------------------------------------------------------------------------------------------------
+extern const sim_track_def_t sim_track_oval;          // 椭圆: 两段直道 + 两个180度弯
+extern const sim_track_def_t sim_track_ring;          // 椭圆 + 左圆环
+extern const sim_track_def_t sim_track_chicane;       // 椭圆，一条直道上有S弯
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数声明
+//-------------------------------------------------------------------------------------------------------------------
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     生成赛道导线
+// 参数说明     def             赛道定义
+// 返回参数     uint8           0-成功 1-点数超过 SIM_TRACK_POINT_MAX 2-首尾不闭合
+// 使用示例     if(sim_track_build(&sim_track_oval)) { ... }
+// 备注信息     起点为原点，起点方向为 x 轴正方向
+//-------------------------------------------------------------------------------------------------------------------
+uint8 sim_track_build(const sim_track_def_t *def);
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     赛道总长
+// 参数说明     void
+// 返回参数     float           导线总长 (m)
+// 使用示例     float len = sim_track_length();
+//-------------------------------------------------------------------------------------------------------------------
+float sim_track_length(void);
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     查找车辆在导线上的最近点
+// 参数说明     x y             车辆位置 (m)
+// 参数说明     hint            上一次的最近点下标，只在其前后附近查找
+// 参数说明     out             输出 最近点和横向偏差
+// 返回参数     void
+// 使用示例     sim_track_locate(car.x, car.y, pos.index, &pos);
+// 备注信息     圆环切点处导线重合，按 hint 附近查找保证沿行驶方向前进
+//-------------------------------------------------------------------------------------------------------------------
+void sim_track_locate(float x, float y, uint16 hint, sim_track_pos_t *out);
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     选出车辆附近的导线段
+// 参数说明     x y             车辆位置 (m)
+// 返回参数     void
+// 使用示例     sim_field_select(car.x, car.y);
+// 备注信息     之后的 sim_field_at() 只计算选出的线段，每个仿真步调用一次
+//-------------------------------------------------------------------------------------------------------------------
+void sim_field_select(float x, float y);
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     计算一点的磁感应强度
+// 参数说明     x y z           位置 (m)
+// 参数说明     b               输出 磁感应强度 [bx, by, bz] (μ0I/4π 单位)
+// 返回参数     void
+// 使用示例     sim_field_at(px, py, h, b);
+//-------------------------------------------------------------------------------------------------------------------
+void sim_field_at(float x, float y, float z, float *b);
+
+#endif
@@ -0,0 +1,42 @@
+#ifndef _HOST_TEST_H_
+#define _HOST_TEST_H_
+
+//-------------------------------------------------------------------------------------------------------------------
+// 头文件包含
+//-------------------------------------------------------------------------------------------------------------------
+#include "mock_hal.h"
+
+//-------------------------------------------------------------------------------------------------------------------
+// 说明
+//-------------------------------------------------------------------------------------------------------------------
+// 单元测试用的检查宏
+//   每个测试是一个 void xxx(void) 函数，在 test_main.c 的 test_list 中登记
+//   检查失败时打印文件、行号和数值，计入 host_test_fail，测试继续执行
+//   测试开始前 test_main.c 会调用 mock_hal_reset()，模块自身的状态需要测试自己初始化
+
+//-------------------------------------------------------------------------------------------------------------------
+// 宏定义
+//-------------------------------------------------------------------------------------------------------------------
+#define HOST_CHECK(cond)                                                                        \
+    do{ host_test_check++;                                                                      \
+        if(!(cond)){ host_test_fail++;                                                          \
+            printf("  FAIL %s:%d: %s\r\n", __FILE__, __LINE__, #cond); } }while(0)
+
+#define HOST_CHECK_INT(actual, expect)                                                          \
+    do{ long _a = (long)(actual), _e = (long)(expect); host_test_check++;                      \
+        if(_a != _e){ host_test_fail++;                                                         \
+            printf("  FAIL %s:%d: %s = %ld, expect %ld\r\n", __FILE__, __LINE__, #actual, _a, _e); } }while(0)
+
+#define HOST_CHECK_NEAR(actual, expect, tol)                                                    \
+    do{ double _a = (double)(actual), _e = (double)(expect); host_test_check++;                \
+        if(!(fabs(_a - _e) <= (double)(tol))){ host_test_fail++;                                \
+            printf("  FAIL %s:%d: %s = %g, expect %g +- %g\r\n",                               \
+                   __FILE__, __LINE__, #actual, _a, _e, (double)(tol)); } }while(0)
+
+//-------------------------------------------------------------------------------------------------------------------
+// 全局变量声明
+//-------------------------------------------------------------------------------------------------------------------
+extern uint32 host_test_check;                                  // 检查次数
+extern uint32 host_test_fail;                                   // 失败次数
+
+#endif
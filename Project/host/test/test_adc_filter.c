@@ -0,0 +1,162 @@
+//-------------------------------------------------------------------------------------------------------------------
+// 头文件包含
+//-------------------------------------------------------------------------------------------------------------------
+#include "host_test.h"
+#include <stdlib.h>
+
+//-------------------------------------------------------------------------------------------------------------------
+// 说明
+//-------------------------------------------------------------------------------------------------------------------
+// 滑动窗口滤波器与直接计算的参考值对照
+//   中值 / 去极值平均: 每次写入后对最近 min(已写入数, ADC_FILTER_WINDOW) 个样本重新排序计算，要求完全一致
+//   指数滤波: 与浮点 y += (x - y) / 2^ADC_FILTER_EMA_SHIFT 对照，Q4 截断误差不超过 1 LSB
+//   输入为固定种子的伪随机序列: 全量程随机、带脉冲干扰的慢变信号、大量重复值 (只有8个取值)
+
+//-------------------------------------------------------------------------------------------------------------------
+// 宏定义
+//-------------------------------------------------------------------------------------------------------------------
+#define TEST_FILTER_SAMPLES     (20000)
+
+//-------------------------------------------------------------------------------------------------------------------
+// 私有变量
+//-------------------------------------------------------------------------------------------------------------------
+static uint32 test_filter_seed = 1;
+
+static uint16 test_filter_rand(void)
+{
+    test_filter_seed = test_filter_seed * 1103515245u + 12345u;
+    return (uint16)(test_filter_seed >> 16);
+}
+
+static int test_filter_cmp(const void *a, const void *b)
+{
+    return (int)*(const uint16 *)a - (int)*(const uint16 *)b;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     产生第 n 个测试样本
+// 参数说明     kind            0-全量程随机 1-慢变信号加脉冲 2-重复值
+//-------------------------------------------------------------------------------------------------------------------
+static uint16 test_filter_sample(uint8 kind, uint32 n)
+{
+    int32 v;
+
+    if(kind == 0)
+    {
+        return test_filter_rand() % 4096;
+    }
+    if(kind == 1)
+    {
+        v = 2000 + (int32)(1500.0 * sin(n * 0.01)) + (int32)(test_filter_rand() % 33) - 16;
+        if(test_filter_rand() % 50 == 0)
+        {
+            v = (test_filter_rand() & 1) ? 4095 : 0;
+        }
+        return (uint16)v;
+    }
+    return 1000 + (test_filter_rand() % 8);
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     中值、去极值平均、指数滤波与参考值对照
+//-------------------------------------------------------------------------------------------------------------------
+void test_adc_filter_vs_reference(void)
+{
+    adc_filter_t filter;
+    uint16 history[ADC_FILTER_WINDOW];
+    uint16 sorted[ADC_FILTER_WINDOW];
+    uint32 median_err;
+    uint32 trimmed_err;
+    uint32 order_err;
+    uint32 n;
+    uint32 sum;
+    uint16 x;
+    uint16 expect;
+    uint8 count;
+    uint8 kind;
+    uint8 i;
+    double ema;
+    double ema_err_max;
+
+    test_filter_seed = 1;
+    median_err = 0;
+    trimmed_err = 0;
+    order_err = 0;
+    ema_err_max = 0;
+
+    for(kind = 0; kind < 3; kind++)
+    {
+        adc_filter_reset(&filter);
+        ema = 0;
+
+        for(n = 0; n < TEST_FILTER_SAMPLES; n++)
+        {
+            x = test_filter_sample(kind, n);
+            adc_filter_push(&filter, x);
+            history[n % ADC_FILTER_WINDOW] = x;
+            ema = (n == 0) ? x : ema + (x - ema) / (1 << ADC_FILTER_EMA_SHIFT);
+
+            // 参考值: 最近 count 个样本重新排序
+            count = (n + 1 < ADC_FILTER_WINDOW) ? (uint8)(n + 1) : ADC_FILTER_WINDOW;
+            memcpy(sorted, history, sizeof(sorted));
+            qsort(sorted, count, sizeof(uint16), test_filter_cmp);
+
+            // 有序数组保持有序且与窗口样本相同
+            if(filter.count != count || memcmp(sorted, filter.sorted, count * sizeof(uint16)) != 0)
+            {
+                order_err++;
+            }
+
+            if(adc_filter_median(&filter) != sorted[count >> 1])
+            {
+                median_err++;
+            }
+
+            sum = 0;
+            for(i = 0; i < count; i++)
+            {
+                sum += sorted[i];
+            }
+            expect = (count < 3) ? (uint16)(sum / count) : (uint16)((sum - sorted[0] - sorted[count - 1]) / (count - 2));
+            if(adc_filter_trimmed_mean(&filter) != expect)
+            {
+                trimmed_err++;
+            }
+
+            if(fabs(adc_filter_ema(&filter) - ema) > ema_err_max)
+            {
+                ema_err_max = fabs(adc_filter_ema(&filter) - ema);
+            }
+        }
+    }
+
+    printf("  ema max error %.3f LSB\r\n", ema_err_max);
+    HOST_CHECK_INT(order_err, 0);
+    HOST_CHECK_INT(median_err, 0);
+    HOST_CHECK_INT(trimmed_err, 0);
+    HOST_CHECK(ema_err_max <= 1.0);
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     Adc_Filter_Init 填满窗口后 Adc_Getval_Filter 每通道只转换一次
+//-------------------------------------------------------------------------------------------------------------------
+void test_adc_filter_getval(void)
+{
+    uint8 i;
+
+    for(i = 0; i < CHANNEL_NUMBER; i++)
+    {
+        mock_adc_value[channel_list[i]] = 1000 + 100 * i;
+    }
+
+    Adc_Filter_Init();
+    HOST_CHECK_INT(mock_adc_convert_count, CHANNEL_NUMBER * ADC_FILTER_WINDOW);
+
+    Adc_Getval_Filter();
+    HOST_CHECK_INT(mock_adc_convert_count, CHANNEL_NUMBER * (ADC_FILTER_WINDOW + 1));
+    for(i = 0; i < CHANNEL_NUMBER; i++)
+    {
+        HOST_CHECK_INT(adc_raw_list[i], 1000 + 100 * i);
+        HOST_CHECK_INT(adc_filter_bank[i].count, ADC_FILTER_WINDOW);
+    }
+}
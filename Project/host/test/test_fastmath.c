@@ -0,0 +1,204 @@
+//-------------------------------------------------------------------------------------------------------------------
+// 头文件包含
+//-------------------------------------------------------------------------------------------------------------------
+#include "host_test.h"
+
+//-------------------------------------------------------------------------------------------------------------------
+// 说明
+//-------------------------------------------------------------------------------------------------------------------
+// fastmath 的最大误差与 fastmath.h 备注信息中给出的值对照，参考值为 double 的 math.h 函数
+//   fast_inv_sqrt / fast_sqrt: 1e-6 ~ 1e6 按对数均匀取点，相对误差
+//   fast_sin / fast_cos: -8π ~ 8π 均匀取点 (每个表格段约1000个点)
+//   fast_asin: -1 ~ 1 均匀取点，包含端点
+//   fast_atan2: 绕原点一周均匀取角度，3种半径，包含坐标轴和对角线
+//   fast_atan2_table: 同 fast_atan2，另外在 0 ~ 45° 上按比值均匀取点 (每个表格段约30000个点，包含插值误差最大的段中点)，
+//                     表格节点处只有表格数值的舍入误差
+
+//-------------------------------------------------------------------------------------------------------------------
+// 宏定义
+//-------------------------------------------------------------------------------------------------------------------
+#define TEST_FASTMATH_POINTS    (1000000L)
+
+#if(FAST_INV_SQRT_ITER >= 2)
+#define TEST_FASTMATH_SQRT_MAX  (5e-6)
+#else
+#define TEST_FASTMATH_SQRT_MAX  (1.8e-3)
+#endif
+#define TEST_FASTMATH_SIN_MAX   (7.6e-5)
+#define TEST_FASTMATH_ASIN_MAX  (7.5e-5)
+#define TEST_FASTMATH_ATAN2_MAX (1.2e-5)
+#define TEST_FASTMATH_TABLE_MAX (8e-5)
+#define TEST_FASTMATH_NODE_MAX  (1e-6)                          // 表格节点 (7位小数和 float 舍入)
+
+//-------------------------------------------------------------------------------------------------------------------
+// 私有变量
+//-------------------------------------------------------------------------------------------------------------------
+typedef float (*test_atan2_func)(float y, float x);
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     atan2 绕原点一周的最大误差
+// 参数说明     func            被测函数
+// 返回参数     double          最大误差 (rad)
+//-------------------------------------------------------------------------------------------------------------------
+static double test_fastmath_atan2_sweep(test_atan2_func func)
+{
+    static const double radius[3] = {1e-3, 1.0, 1e3};
+    double angle;
+    double err;
+    double err_max;
+    float y;
+    float x;
+    long i;
+    uint8 k;
+
+    err_max = 0;
+    for(k = 0; k < 3; k++)
+    {
+        // 点数是8的倍数，坐标轴和对角线都会取到
+        for(i = 0; i < TEST_FASTMATH_POINTS; i++)
+        {
+            angle = (double)i * (2 * M_PI / TEST_FASTMATH_POINTS) - M_PI;
+            y = (float)(radius[k] * sin(angle));
+            x = (float)(radius[k] * cos(angle));
+            err = fabs(func(y, x) - atan2((double)y, (double)x));
+            if(err > M_PI)
+            {
+                err = 2 * M_PI - err;                           // ±π 两侧是同一个角度
+            }
+            if(err > err_max)
+            {
+                err_max = err;
+            }
+        }
+    }
+    return err_max;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     fast_inv_sqrt / fast_sqrt 相对误差
+//-------------------------------------------------------------------------------------------------------------------
+void test_fastmath_sqrt(void)
+{
+    double err;
+    double inv_max;
+    double sqrt_max;
+    float x;
+    long i;
+
+    inv_max = 0;
+    sqrt_max = 0;
+    for(i = 0; i <= TEST_FASTMATH_POINTS; i++)
+    {
+        x = (float)pow(10.0, -6.0 + 12.0 * i / TEST_FASTMATH_POINTS);
+        err = fabs(fast_inv_sqrt(x) * sqrt((double)x) - 1);
+        inv_max = (err > inv_max) ? err : inv_max;
+        err = fabs(fast_sqrt(x) / sqrt((double)x) - 1);
+        sqrt_max = (err > sqrt_max) ? err : sqrt_max;
+    }
+    printf("  inv_sqrt %.2e, sqrt %.2e\r\n", inv_max, sqrt_max);
+    HOST_CHECK(inv_max < TEST_FASTMATH_SQRT_MAX);
+    HOST_CHECK(sqrt_max < TEST_FASTMATH_SQRT_MAX);
+
+    HOST_CHECK(fast_inv_sqrt(0.0f) == 0.0f);
+    HOST_CHECK(fast_inv_sqrt(-1.0f) == 0.0f);
+    HOST_CHECK(fast_sqrt(0.0f) == 0.0f);
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     fast_sin / fast_cos 最大误差
+//-------------------------------------------------------------------------------------------------------------------
+void test_fastmath_sin_cos(void)
+{
+    double err;
+    double sin_max;
+    double cos_max;
+    float x;
+    long i;
+
+    sin_max = 0;
+    cos_max = 0;
+    for(i = -TEST_FASTMATH_POINTS; i <= TEST_FASTMATH_POINTS; i++)
+    {
+        x = (float)(i * (8 * M_PI / TEST_FASTMATH_POINTS));
+        err = fabs(fast_sin(x) - sin((double)x));
+        sin_max = (err > sin_max) ? err : sin_max;
+        err = fabs(fast_cos(x) - cos((double)x));
+        cos_max = (err > cos_max) ? err : cos_max;
+    }
+    printf("  sin %.2e, cos %.2e\r\n", sin_max, cos_max);
+    HOST_CHECK(sin_max < TEST_FASTMATH_SIN_MAX);
+    HOST_CHECK(cos_max < TEST_FASTMATH_SIN_MAX);
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     fast_asin 最大误差和限幅
+//-------------------------------------------------------------------------------------------------------------------
+void test_fastmath_asin(void)
+{
+    double err;
+    double err_max;
+    float x;
+    long i;
+
+    err_max = 0;
+    for(i = -TEST_FASTMATH_POINTS; i <= TEST_FASTMATH_POINTS; i++)
+    {
+        x = (float)((double)i / TEST_FASTMATH_POINTS);
+        err = fabs(fast_asin(x) - asin((double)x));
+        err_max = (err > err_max) ? err : err_max;
+    }
+    printf("  asin %.2e rad\r\n", err_max);
+    HOST_CHECK(err_max < TEST_FASTMATH_ASIN_MAX);
+
+    HOST_CHECK_NEAR(fast_asin(1.5f), M_PI / 2, TEST_FASTMATH_ASIN_MAX);
+    HOST_CHECK_NEAR(fast_asin(-1.5f), -M_PI / 2, TEST_FASTMATH_ASIN_MAX);
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     fast_atan2 最大误差
+//-------------------------------------------------------------------------------------------------------------------
+void test_fastmath_atan2(void)
+{
+    double err_max;
+
+    err_max = test_fastmath_atan2_sweep(fast_atan2);
+    printf("  atan2 %.2e rad\r\n", err_max);
+    HOST_CHECK(err_max < TEST_FASTMATH_ATAN2_MAX);
+    HOST_CHECK(fast_atan2(0.0f, 0.0f) == 0.0f);
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     fast_atan2_table 最大误差
+//-------------------------------------------------------------------------------------------------------------------
+void test_fastmath_atan2_table(void)
+{
+    double err;
+    double err_max;
+    double node_max;
+    float r;
+    long i;
+
+    // 0 ~ 45° 比值均匀取点
+    err_max = 0;
+    for(i = 0; i <= TEST_FASTMATH_POINTS; i++)
+    {
+        r = (float)((double)i / TEST_FASTMATH_POINTS);
+        err = fabs(fast_atan2_table(r, 1.0f) - atan((double)r));
+        err_max = (err > err_max) ? err : err_max;
+    }
+
+    // 表格节点 atan(i/32)
+    node_max = 0;
+    for(i = 0; i <= 32; i++)
+    {
+        err = fabs(fast_atan2_table((float)i, 32.0f) - atan(i / 32.0));
+        node_max = (err > node_max) ? err : node_max;
+    }
+
+    err = test_fastmath_atan2_sweep(fast_atan2_table);
+    printf("  atan2_table %.2e rad (0~45 deg), %.2e rad (circle), nodes %.2e rad\r\n", err_max, err, node_max);
+    HOST_CHECK(err_max < TEST_FASTMATH_TABLE_MAX);
+    HOST_CHECK(err < TEST_FASTMATH_TABLE_MAX);
+    HOST_CHECK(node_max < TEST_FASTMATH_NODE_MAX);
+    HOST_CHECK(fast_atan2_table(0.0f, 0.0f) == 0.0f);
+}
@@ -0,0 +1,69 @@
+#ifndef _TEST_LIST_H_
+#define _TEST_LIST_H_
+
+//-------------------------------------------------------------------------------------------------------------------
+// 说明
+//-------------------------------------------------------------------------------------------------------------------
+// 测试登记表，新测试在对应的 test_xxx.c 中实现，在这里声明并加入 HOST_TEST_LIST
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数声明
+//-------------------------------------------------------------------------------------------------------------------
+void test_timebase_wrap(void);
+void test_myeeprom_pid_round_trip(void);
+void test_myeeprom_adc_calib_round_trip(void);
+void test_myeeprom_gyro_bias_round_trip(void);
+void test_normalization_q24_exhaustive(void);
+void test_normalization_q22_fine_exhaustive(void);
+void test_normalization_degenerate_range(void);
+void test_normalization_calib_update(void);
+void test_normalization_frame_stamp(void);
+void test_adc_filter_vs_reference(void);
+void test_adc_filter_getval(void);
+void test_median_zero_one(void);
+void test_median_permutations(void);
+void test_pid_q16_mul(void);
+void test_pid_fixed_vs_float(void);
+void test_pid_fixed_sync_shadow(void);
+void test_mahony_constants(void);
+void test_mahony_fixed_vs_float(void);
+void test_fastmath_sqrt(void);
+void test_fastmath_sin_cos(void);
+void test_fastmath_asin(void);
+void test_fastmath_atan2(void);
+void test_fastmath_atan2_table(void);
+void test_scheduler_timer(void);
+void test_scheduler_overrun(void);
+void test_scheduler_tick_stat(void);
+void test_overrun_recover(void);
+
+#define HOST_TEST_LIST(X)                                       \
+    X(test_timebase_wrap)                                       \
+    X(test_myeeprom_pid_round_trip)                             \
+    X(test_myeeprom_adc_calib_round_trip)                       \
+    X(test_myeeprom_gyro_bias_round_trip)                       \
+    X(test_normalization_q24_exhaustive)                        \
+    X(test_normalization_q22_fine_exhaustive)                   \
+    X(test_normalization_degenerate_range)                      \
+    X(test_normalization_calib_update)                          \
+    X(test_normalization_frame_stamp)                           \
+    X(test_adc_filter_vs_reference)                             \
+    X(test_adc_filter_getval)                                   \
+    X(test_median_zero_one)                                     \
+    X(test_median_permutations)                                 \
+    X(test_pid_q16_mul)                                         \
+    X(test_pid_fixed_vs_float)                                  \
+    X(test_pid_fixed_sync_shadow)                               \
+    X(test_mahony_constants)                                    \
+    X(test_mahony_fixed_vs_float)                               \
+    X(test_fastmath_sqrt)                                       \
+    X(test_fastmath_sin_cos)                                    \
+    X(test_fastmath_asin)                                       \
+    X(test_fastmath_atan2)                                      \
+    X(test_fastmath_atan2_table)                                \
+    X(test_scheduler_timer)                                     \
+    X(test_scheduler_overrun)                                   \
+    X(test_scheduler_tick_stat)                                 \
+    X(test_overrun_recover)
+
+#endif
@@ -0,0 +1,222 @@
+//-------------------------------------------------------------------------------------------------------------------
+// 头文件包含
+//-------------------------------------------------------------------------------------------------------------------
+#include "host_test.h"
+
+//-------------------------------------------------------------------------------------------------------------------
+// 说明
+//-------------------------------------------------------------------------------------------------------------------
+// Q30 定点 Mahony 与浮点 Mahony 对照
+//   输入为固定种子生成的 IMU 原始值序列 (每次运行相同): 静止、原地转圈、带横滚摆动的转弯、反向转圈、长时间静止，
+//   陀螺仪和加速度计都加噪声并量化到 int16，采样周期 DT_US
+//   真实姿态用 double 按真实角速度积分，检查:
+//     定点与浮点的航向差 (两者输入相同，差值只来自定点运算)
+//     定点与真实姿态的航向/横滚误差 (包含传感器噪声和量化，不能由加速度计修正的航向会随机游走)
+//     定点四元数模长
+//   MAHONY_FX_* 整数常量与浮点参数的换算一致
+
+//-------------------------------------------------------------------------------------------------------------------
+// 宏定义
+//-------------------------------------------------------------------------------------------------------------------
+#define TEST_MAHONY_SECONDS     (120)
+#define TEST_MAHONY_STEPS       (TEST_MAHONY_SECONDS * 1000000UL / DT_US)
+#define TEST_MAHONY_ACC_LSB     (4096.0)                        // 加速度计每 g 的计数 (只用方向)
+#define TEST_MAHONY_GYRO_NOISE  (4)                             // 陀螺仪噪声 ±LSB
+#define TEST_MAHONY_ACC_NOISE   (40)                            // 加速度计噪声 ±LSB
+#define TEST_MAHONY_FX_DIFF_MAX (0.01)                          // 定点与浮点航向差 (°)，去掉陀螺仪系数低8位时约 0.2°
+#define TEST_MAHONY_YAW_MAX     (1.5)                           // 定点与真实航向误差 (°)
+#define TEST_MAHONY_ROLL_MAX    (2.5)                           // 定点与真实横滚误差 (°)，转弯时加速度计修正的滞后
+
+//-------------------------------------------------------------------------------------------------------------------
+// 私有变量
+//-------------------------------------------------------------------------------------------------------------------
+static uint32 test_mahony_seed = 1;
+
+static int16 test_mahony_noise(int16 range)
+{
+    test_mahony_seed = test_mahony_seed * 1103515245u + 12345u;
+    return (int16)((test_mahony_seed >> 16) % (2 * range + 1)) - range;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     第 t 秒的真实角速度 (°/s，机体系)
+//-------------------------------------------------------------------------------------------------------------------
+static void test_mahony_rate(double t, double w[3])
+{
+    w[0] = 0;
+    w[1] = 0;
+    w[2] = 0;
+    if(t < 5)
+    {
+        // 静止
+    }
+    else if(t < 23)
+    {
+        w[2] = 200;                                             // 原地转10圈
+    }
+    else if(t < 53)
+    {
+        w[0] = 40 * sin(2 * M_PI * 0.5 * t);                    // 横滚摆动 ±12.7°，同时转弯
+        w[2] = 90;
+    }
+    else if(t < 71)
+    {
+        w[2] = -200;                                            // 反向转10圈
+    }
+    // 之后静止
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     double 四元数积分一步 (一阶，与被测算法相同的形式，之后归一化)
+//-------------------------------------------------------------------------------------------------------------------
+static void test_mahony_truth_step(double q[4], const double w[3], double dt)
+{
+    double s[4];
+    double gx, gy, gz;
+    double n;
+
+    gx = w[0] * M_PI / 180 * dt * 0.5;
+    gy = w[1] * M_PI / 180 * dt * 0.5;
+    gz = w[2] * M_PI / 180 * dt * 0.5;
+    s[0] = q[0] - (q[1] * gx + q[2] * gy + q[3] * gz);
+    s[1] = q[1] + (q[0] * gx + q[2] * gz - q[3] * gy);
+    s[2] = q[2] + (q[0] * gy - q[1] * gz + q[3] * gx);
+    s[3] = q[3] + (q[0] * gz + q[1] * gy - q[2] * gx);
+    n = sqrt(s[0] * s[0] + s[1] * s[1] + s[2] * s[2] + s[3] * s[3]);
+    q[0] = s[0] / n;
+    q[1] = s[1] / n;
+    q[2] = s[2] / n;
+    q[3] = s[3] / n;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     四元数的航向和横滚 (°)
+//-------------------------------------------------------------------------------------------------------------------
+static double test_mahony_yaw(double q0, double q1, double q2, double q3)
+{
+    return atan2(2 * (q0 * q3 + q1 * q2), 1 - 2 * (q2 * q2 + q3 * q3)) * 180 / M_PI;
+}
+
+static double test_mahony_roll(double q0, double q1, double q2, double q3)
+{
+    return atan2(2 * (q0 * q1 + q2 * q3), 1 - 2 * (q1 * q1 + q2 * q2)) * 180 / M_PI;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     角度差 (°, -180 ~ 180)
+//-------------------------------------------------------------------------------------------------------------------
+static double test_mahony_angle_diff(double a, double b)
+{
+    double d;
+
+    d = fmod(a - b, 360.0);
+    if(d > 180)
+    {
+        d -= 360;
+    }
+    if(d < -180)
+    {
+        d += 360;
+    }
+    return fabs(d);
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     MAHONY_FX_* 整数常量与浮点参数的换算
+//-------------------------------------------------------------------------------------------------------------------
+void test_mahony_constants(void)
+{
+    HOST_CHECK_NEAR(MAHONY_FX_GYRO_Q32, (double)DEG_TO_RAD / MAHONY_GYRO_LSB * 4294967296.0, 1);
+    HOST_CHECK_NEAR(MAHONY_FX_KP_Q24, (double)MAHONY_KP * 16777216.0, 1);
+    HOST_CHECK_NEAR(MAHONY_FX_KI_Q30, (double)MAHONY_KI * 1073741824.0, 1);
+    HOST_CHECK_NEAR(MAHONY_FX_HALF_DT_PER_US + MAHONY_FX_HALF_DT_FRAC / 1000.0, 68719476736.0 / 2000000.0, 0.001);
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     定点 / 浮点 Mahony 对照固定的 IMU 序列
+//-------------------------------------------------------------------------------------------------------------------
+void test_mahony_fixed_vs_float(void)
+{
+    struct MahonyAHRS_t fl;
+    struct MahonyAHRS_Fixed_t fx;
+    double truth[4];
+    double w[3];
+    double g[3];
+    double t;
+    double qf[4];
+    double qx[4];
+    double err;
+    double diff_max;
+    double yaw_max;
+    double roll_max;
+    double norm_max;
+    int16 gyro[3];
+    int16 acc[3];
+    uint32 i;
+    uint8 k;
+
+    Mahony_Init(&fl);
+    Mahony_Fixed_Init(&fx);
+    truth[0] = 1;
+    truth[1] = 0;
+    truth[2] = 0;
+    truth[3] = 0;
+    test_mahony_seed = 1;
+
+    diff_max = 0;
+    yaw_max = 0;
+    roll_max = 0;
+    norm_max = 0;
+    for(i = 0; i < TEST_MAHONY_STEPS; i++)
+    {
+        t = (double)i * DT_US / 1000000.0;
+        test_mahony_rate(t, w);
+        test_mahony_truth_step(truth, w, DT_US / 1000000.0);
+
+        // 世界系重力 (0, 0, 1) 旋转到机体系
+        g[0] = 2 * (truth[1] * truth[3] - truth[0] * truth[2]);
+        g[1] = 2 * (truth[0] * truth[1] + truth[2] * truth[3]);
+        g[2] = truth[0] * truth[0] - truth[1] * truth[1] - truth[2] * truth[2] + truth[3] * truth[3];
+        for(k = 0; k < 3; k++)
+        {
+            gyro[k] = (int16)floor(w[k] * MAHONY_GYRO_LSB + 0.5) + test_mahony_noise(TEST_MAHONY_GYRO_NOISE);
+            acc[k] = (int16)floor(g[k] * TEST_MAHONY_ACC_LSB + 0.5) + test_mahony_noise(TEST_MAHONY_ACC_NOISE);
+        }
+
+        // 与 imu_integrate() 相同的输入
+        Mahony_Fixed_Update(&fx, gyro[0], gyro[1], gyro[2], acc[0], acc[1], acc[2], DT_US);
+        Mahony_Update(&fl,
+                      imu660rb_gyro_transition(gyro[0]) * DEG_TO_RAD,
+                      imu660rb_gyro_transition(gyro[1]) * DEG_TO_RAD,
+                      imu660rb_gyro_transition(gyro[2]) * DEG_TO_RAD,
+                      imu660rb_acc_transition(acc[0]), imu660rb_acc_transition(acc[1]),
+                      imu660rb_acc_transition(acc[2]), DT_US * 0.000001f);
+
+        qf[0] = fl.q0;
+        qf[1] = fl.q1;
+        qf[2] = fl.q2;
+        qf[3] = fl.q3;
+        qx[0] = fx.q0 / 1073741824.0;
+        qx[1] = fx.q1 / 1073741824.0;
+        qx[2] = fx.q2 / 1073741824.0;
+        qx[3] = fx.q3 / 1073741824.0;
+
+        err = test_mahony_angle_diff(test_mahony_yaw(qx[0], qx[1], qx[2], qx[3]), test_mahony_yaw(qf[0], qf[1], qf[2], qf[3]));
+        diff_max = (err > diff_max) ? err : diff_max;
+        err = test_mahony_angle_diff(test_mahony_yaw(qx[0], qx[1], qx[2], qx[3]),
+                                     test_mahony_yaw(truth[0], truth[1], truth[2], truth[3]));
+        yaw_max = (err > yaw_max) ? err : yaw_max;
+        err = test_mahony_angle_diff(test_mahony_roll(qx[0], qx[1], qx[2], qx[3]),
+                                     test_mahony_roll(truth[0], truth[1], truth[2], truth[3]));
+        roll_max = (err > roll_max) ? err : roll_max;
+        err = fabs(sqrt(qx[0] * qx[0] + qx[1] * qx[1] + qx[2] * qx[2] + qx[3] * qx[3]) - 1);
+        norm_max = (err > norm_max) ? err : norm_max;
+    }
+
+    printf("  %lu steps: fixed-float yaw %.4f deg, fixed-truth yaw %.3f deg roll %.3f deg, |q|-1 %.2e\r\n",
+           (unsigned long)TEST_MAHONY_STEPS, diff_max, yaw_max, roll_max, norm_max);
+    HOST_CHECK(diff_max < TEST_MAHONY_FX_DIFF_MAX);
+    HOST_CHECK(yaw_max < TEST_MAHONY_YAW_MAX);
+    HOST_CHECK(roll_max < TEST_MAHONY_ROLL_MAX);
+    HOST_CHECK(norm_max < 1e-5);
+}
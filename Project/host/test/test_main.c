@@ -0,0 +1,71 @@
+//-------------------------------------------------------------------------------------------------------------------
+// 头文件包含
+//-------------------------------------------------------------------------------------------------------------------
+#include "host_test.h"
+#include "test_list.h"
+
+//-------------------------------------------------------------------------------------------------------------------
+// 全局变量定义
+//-------------------------------------------------------------------------------------------------------------------
+uint32 host_test_check = 0;
+uint32 host_test_fail = 0;
+
+//-------------------------------------------------------------------------------------------------------------------
+// 私有变量
+//-------------------------------------------------------------------------------------------------------------------
+typedef struct
+{
+    const char *name;
+    void (*func)(void);
+}test_item_struct;
+
+#define HOST_TEST_ITEM(func)    {#func, func},
+static const test_item_struct test_list[] =
+{
+    HOST_TEST_LIST(HOST_TEST_ITEM)
+};
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     运行全部测试
+// 参数说明     argc / argv     可选参数: 只运行名字包含该字符串的测试
+// 返回参数     int             0-全部通过 1-有失败
+// 使用示例     ./build/test_runner [名字]
+//-------------------------------------------------------------------------------------------------------------------
+int main(int argc, char *argv[])
+{
+    uint32 i;
+    uint32 fail;
+    uint32 failed_test;
+    uint32 run;
+
+    failed_test = 0;
+    run = 0;
+    for(i = 0; i < sizeof(test_list) / sizeof(test_list[0]); i++)
+    {
+        if(argc > 1 && strstr(test_list[i].name, argv[1]) == NULL)
+        {
+            continue;
+        }
+
+        mock_hal_reset();
+        tim4_irq_handler = timebase_overflow_handler;
+        fail = host_test_fail;
+        test_list[i].func();
+        run++;
+
+        if(host_test_fail != fail)
+        {
+            failed_test++;
+            printf("[FAIL] %s\r\n", test_list[i].name);
+        }
+        else
+        {
+            printf("[ ok ] %s\r\n", test_list[i].name);
+        }
+    }
+
+    printf("%u tests, %u checks, %u failed checks, %u failed tests\r\n",
+           run, host_test_check, host_test_fail, failed_test);
+
+    return failed_test != 0;
+}
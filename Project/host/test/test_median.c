@@ -0,0 +1,167 @@
+//-------------------------------------------------------------------------------------------------------------------
+// 头文件包含
+//-------------------------------------------------------------------------------------------------------------------
+#include "host_test.h"
+
+//-------------------------------------------------------------------------------------------------------------------
+// 说明
+//-------------------------------------------------------------------------------------------------------------------
+// 排序网络和取中值网络的正确性
+//   0-1 原理: 比较交换网络对全部 2^n 个 0/1 输入排序正确，则对任意输入排序正确
+//   另外对 n = 3/5/7/9 的全部 n! 个排列 (不同值) 直接检查输出
+
+//-------------------------------------------------------------------------------------------------------------------
+// 私有变量
+//-------------------------------------------------------------------------------------------------------------------
+typedef void   (*test_sort_func)(uint16 v[]);
+typedef uint16 (*test_median_func)(uint16 v[]);
+
+static uint16 test_median3_wrap(uint16 v[])
+{
+    return median3(v[0], v[1], v[2]);
+}
+
+static const uint8 test_median_n[4] = {3, 5, 7, 9};
+static const test_sort_func test_sort_list[4] = {sort_network_3, sort_network_5, sort_network_7, sort_network_9};
+static const test_median_func test_median_list[4] = {test_median3_wrap, median_of_5, median_of_7, median_of_9};
+
+static uint32 test_median_err;
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     检查一组输入的排序和中值结果
+// 参数说明     k               网络序号 (0~3 对应 n = 3/5/7/9)
+// 参数说明     in              输入
+// 参数说明     expect_median   正确的中值
+//-------------------------------------------------------------------------------------------------------------------
+static void test_median_check(uint8 k, const uint16 *in, uint16 expect_median)
+{
+    uint16 v[9];
+    uint8 n;
+    uint8 i;
+    uint32 sum_in;
+    uint32 sum_out;
+
+    n = test_median_n[k];
+
+    memcpy(v, in, n * sizeof(uint16));
+    test_sort_list[k](v);
+    sum_in = 0;
+    sum_out = 0;
+    for(i = 0; i < n; i++)
+    {
+        sum_in += in[i];
+        sum_out += v[i];
+        if(i > 0 && v[i-1] > v[i])
+        {
+            test_median_err++;
+        }
+    }
+    if(sum_in != sum_out || v[n >> 1] != expect_median)
+    {
+        test_median_err++;
+    }
+
+    memcpy(v, in, n * sizeof(uint16));
+    if(test_median_list[k](v) != expect_median)
+    {
+        test_median_err++;
+    }
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     生成 v[0..n-1] 的下一个字典序排列
+// 返回参数     uint8           0-已经是最后一个排列
+//-------------------------------------------------------------------------------------------------------------------
+static uint8 test_next_permutation(uint16 *v, uint8 n)
+{
+    int8 i;
+    int8 j;
+    uint16 t;
+
+    i = (int8)n - 2;
+    while(i >= 0 && v[i] >= v[i+1])
+    {
+        i--;
+    }
+    if(i < 0)
+    {
+        return 0;
+    }
+    j = (int8)n - 1;
+    while(v[j] <= v[i])
+    {
+        j--;
+    }
+    t = v[i]; v[i] = v[j]; v[j] = t;
+    for(i++, j = (int8)n - 1; i < j; i++, j--)
+    {
+        t = v[i]; v[i] = v[j]; v[j] = t;
+    }
+    return 1;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     0-1 原理: 全部 0/1 输入
+//-------------------------------------------------------------------------------------------------------------------
+void test_median_zero_one(void)
+{
+    uint16 in[9];
+    uint32 bits;
+    uint8 ones;
+    uint8 n;
+    uint8 k;
+    uint8 i;
+
+    test_median_err = 0;
+    for(k = 0; k < 4; k++)
+    {
+        n = test_median_n[k];
+        for(bits = 0; bits < (1u << n); bits++)
+        {
+            ones = 0;
+            for(i = 0; i < n; i++)
+            {
+                in[i] = (bits >> i) & 1;
+                ones += in[i];
+            }
+            // 排序后第 n/2 个元素: 0 的个数大于 n/2 时为0
+            test_median_check(k, in, (n - ones > (n >> 1)) ? 0 : 1);
+        }
+    }
+    HOST_CHECK_INT(test_median_err, 0);
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     全部排列
+//-------------------------------------------------------------------------------------------------------------------
+void test_median_permutations(void)
+{
+    uint16 in[9];
+    uint32 count;
+    uint32 expect_count;
+    uint8 n;
+    uint8 k;
+    uint8 i;
+
+    test_median_err = 0;
+    for(k = 0; k < 4; k++)
+    {
+        n = test_median_n[k];
+        expect_count = 1;
+        for(i = 0; i < n; i++)
+        {
+            in[i] = 100 * i + 7;                                // 不连续的值，中值为 100*(n/2)+7
+            expect_count *= i + 1;
+        }
+
+        count = 0;
+        do
+        {
+            test_median_check(k, in, 100 * (n >> 1) + 7);
+            count++;
+        }while(test_next_permutation(in, n));
+
+        HOST_CHECK_INT(count, expect_count);
+    }
+    HOST_CHECK_INT(test_median_err, 0);
+}
@@ -0,0 +1,93 @@
+//-------------------------------------------------------------------------------------------------------------------
+// 头文件包含
+//-------------------------------------------------------------------------------------------------------------------
+#include "host_test.h"
+#include "myeeprom.h"
+
+//-------------------------------------------------------------------------------------------------------------------
+// 说明
+//-------------------------------------------------------------------------------------------------------------------
+// myeeprom 保存 / 加载往返，EEPROM 由 mock_hal.c 按 Flash 行为模拟 (擦除为 0xFF，写入只能把1写成0)
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     PID 参数保存后能原样读回，空 EEPROM 加载失败并恢复默认值
+//-------------------------------------------------------------------------------------------------------------------
+void test_myeeprom_pid_round_trip(void)
+{
+    pid_param_t left;
+    pid_param_t right;
+    pid_param_t load_left;
+    pid_param_t load_right;
+
+    memset(&left, 0, sizeof(left));
+    memset(&right, 0, sizeof(right));
+    memset(&load_left, 0, sizeof(load_left));
+    memset(&load_right, 0, sizeof(load_right));
+
+    myeeprom_init();
+    HOST_CHECK_INT(myeeprom_load_speed_pid(&load_left, &load_right), 1);    // 同时写入默认值，下面的保存是覆盖写
+
+    left.kp = 12.5f;
+    left.ki = 0.75f;
+    left.kd = -0.125f;
+    right.kp = 13.0f;
+    right.ki = 0.5f;
+    right.kd = 3.0e-4f;
+    HOST_CHECK_INT(myeeprom_save_speed_pid(&left, &right), 0);
+    HOST_CHECK_INT(myeeprom_load_speed_pid(&load_left, &load_right), 0);
+
+    HOST_CHECK(load_left.kp == left.kp);
+    HOST_CHECK(load_left.ki == left.ki);
+    HOST_CHECK(load_left.kd == left.kd);
+    HOST_CHECK(load_right.kp == right.kp);
+    HOST_CHECK(load_right.ki == right.ki);
+    HOST_CHECK(load_right.kd == right.kd);
+    HOST_CHECK_INT(mock_assert_count, 0);
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     ADC 校准表往返，CRC 错误时不修改输出
+//-------------------------------------------------------------------------------------------------------------------
+void test_myeeprom_adc_calib_round_trip(void)
+{
+    uint16 table[10] = {3532, 12, 3522, 0, 3550, 7, 3516, 0, 3548, 4095};
+    uint16 load[10];
+    uint8 i;
+
+    memset(load, 0, sizeof(load));
+    HOST_CHECK_INT(myeeprom_load_adc_calib(load, 10), 1);
+
+    HOST_CHECK_INT(myeeprom_save_adc_calib(table, 10), 0);
+    HOST_CHECK_INT(myeeprom_load_adc_calib(load, 10), 0);
+    for(i = 0; i < 10; i++)
+    {
+        HOST_CHECK_INT(load[i], table[i]);
+    }
+
+    // 改坏一个数据位，CRC 不匹配
+    mock_eeprom[EEPROM_ADC_CALIB_ADDR + 2] ^= 0x01;
+    memset(load, 0, sizeof(load));
+    HOST_CHECK_INT(myeeprom_load_adc_calib(load, 10), 1);
+    HOST_CHECK_INT(load[0], 0);
+
+    // 重新保存会先擦除页
+    HOST_CHECK_INT(myeeprom_save_adc_calib(table, 10), 0);
+    HOST_CHECK_INT(myeeprom_load_adc_calib(load, 10), 0);
+    HOST_CHECK_INT(load[1], table[1]);
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     陀螺仪零偏往返 (含负数)
+//-------------------------------------------------------------------------------------------------------------------
+void test_myeeprom_gyro_bias_round_trip(void)
+{
+    int32 bias[3] = {-123456, 0, 987654};
+    int32 load[3] = {0, 0, 0};
+
+    HOST_CHECK_INT(myeeprom_load_gyro_bias(load), 1);
+    HOST_CHECK_INT(myeeprom_save_gyro_bias(bias), 0);
+    HOST_CHECK_INT(myeeprom_load_gyro_bias(load), 0);
+    HOST_CHECK_INT(load[0], bias[0]);
+    HOST_CHECK_INT(load[1], bias[1]);
+    HOST_CHECK_INT(load[2], bias[2]);
+}
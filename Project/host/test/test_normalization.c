@@ -0,0 +1,320 @@
+//-------------------------------------------------------------------------------------------------------------------
+// 头文件包含
+//-------------------------------------------------------------------------------------------------------------------
+#include "host_test.h"
+#include "myeeprom.h"
+
+//-------------------------------------------------------------------------------------------------------------------
+// 说明
+//-------------------------------------------------------------------------------------------------------------------
+// 定点归一化与浮点公式的穷举对照，采样帧时间戳
+//   Normalization()      (Q24): 12位 range 1~4095 的每个 range、每个输入 (含低于 min 和高于 max) 与 Normalization_Float() 一致
+//   Normalization_Fine() (Q22): 14位 range 4~16380 (12位 range << 2) 的每个输入与 (uint16)(1000.0f * x / range) 一致
+//   5个通道各自使用不同的 min，每次调用检查5个相邻的输入
+//   校准更新: max_min_adc[] 已改写、缩放表还没有重新计算时 (Adc_Calib_Finish 中途被控制中断打断)，
+//   归一化仍完全按旧校准值计算；Normalization_Update_Scale() 之后的下一次归一化整体换成新校准值
+
+//-------------------------------------------------------------------------------------------------------------------
+// 私有变量
+//-------------------------------------------------------------------------------------------------------------------
+static const uint16 test_norm_min[CHANNEL_NUMBER] = {0, 1, 37, 500, 2048};
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     设置5个通道的校准范围并更新缩放表
+// 参数说明     range           12位 max - min，min 超出时减小 min 保证 max <= 4095
+// 参数说明     min             输出每个通道的 min
+//-------------------------------------------------------------------------------------------------------------------
+static void test_norm_set_range(uint16 range, uint16 *min)
+{
+    uint8 i;
+
+    for(i = 0; i < CHANNEL_NUMBER; i++)
+    {
+        min[i] = test_norm_min[i];
+        if(min[i] + range > 4095)
+        {
+            min[i] = 4095 - range;
+        }
+        max_min_adc[2*i] = min[i] + range;
+        max_min_adc[2*i+1] = min[i];
+    }
+    Normalization_Update_Scale();
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     Q24 归一化与浮点版本穷举对照
+//-------------------------------------------------------------------------------------------------------------------
+void test_normalization_q24_exhaustive(void)
+{
+    uint16 backup[2*CHANNEL_NUMBER];
+    uint16 fixed[CHANNEL_NUMBER];
+    uint16 min[CHANNEL_NUMBER];
+    uint16 range;
+    int32 x;
+    uint32 mismatch;
+    uint8 i;
+
+    memcpy(backup, max_min_adc, sizeof(backup));
+    mismatch = 0;
+
+    for(range = 1; range <= 4095; range++)
+    {
+        test_norm_set_range(range, min);
+
+        // 输入从 min-2 到 max+2，覆盖两端限幅
+        for(x = -2; x <= (int32)range + 2; x += CHANNEL_NUMBER)
+        {
+            for(i = 0; i < CHANNEL_NUMBER; i++)
+            {
+                if((int32)min[i] + x + i < 0)
+                {
+                    adc_val_list[i] = 0;
+                }
+                else if((int32)min[i] + x + i > 4095)
+                {
+                    adc_val_list[i] = 4095;
+                }
+                else
+                {
+                    adc_val_list[i] = (uint16)(min[i] + x + i);
+                }
+            }
+
+            Normalization();
+            memcpy(fixed, adc_normalized_list, sizeof(fixed));
+            Normalization_Float();
+
+            for(i = 0; i < CHANNEL_NUMBER; i++)
+            {
+                if(fixed[i] != adc_normalized_list[i])
+                {
+                    if(mismatch < 10)
+                    {
+                        printf("  range %u min %u adc %u: fixed %u float %u\r\n",
+                               range, min[i], adc_val_list[i], fixed[i], adc_normalized_list[i]);
+                    }
+                    mismatch++;
+                }
+            }
+        }
+    }
+
+    HOST_CHECK_INT(mismatch, 0);
+
+    memcpy(max_min_adc, backup, sizeof(backup));
+    Normalization_Update_Scale();
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     Q22 精细归一化与浮点公式穷举对照
+//-------------------------------------------------------------------------------------------------------------------
+void test_normalization_q22_fine_exhaustive(void)
+{
+    uint16 backup[2*CHANNEL_NUMBER];
+    uint16 min[CHANNEL_NUMBER];
+    uint16 range;
+    uint16 fine_range;
+    uint16 expect;
+    int32 x;
+    int32 v;
+    uint32 mismatch;
+    float ref;
+    uint8 i;
+
+    memcpy(backup, max_min_adc, sizeof(backup));
+    mismatch = 0;
+
+    for(range = 1; range <= 4095; range++)
+    {
+        test_norm_set_range(range, min);
+        fine_range = range << ADC_OVERSAMPLE_BITS;
+
+        for(x = -2; x <= (int32)fine_range + 2; x += CHANNEL_NUMBER)
+        {
+            for(i = 0; i < CHANNEL_NUMBER; i++)
+            {
+                v = ((int32)min[i] << ADC_OVERSAMPLE_BITS) + x + i;
+                if(v < 0)
+                {
+                    v = 0;
+                }
+                else if(v > ADC_FINE_MAX)
+                {
+                    v = ADC_FINE_MAX;
+                }
+                adc_fine_list[i] = (uint16)v;
+            }
+
+            Normalization_Fine();
+
+            for(i = 0; i < CHANNEL_NUMBER; i++)
+            {
+                v = (int32)adc_fine_list[i] - ((int32)min[i] << ADC_OVERSAMPLE_BITS);
+                ref = (float)NORMALIZATION_FINE_MAX * (float)v / (float)fine_range;
+                if(ref < 0.0f)
+                {
+                    ref = 0.0f;
+                }
+                else if(ref > (float)NORMALIZATION_FINE_MAX)
+                {
+                    ref = (float)NORMALIZATION_FINE_MAX;
+                }
+                expect = (uint16)ref;
+
+                if(adc_normalized_fine[i] != expect)
+                {
+                    if(mismatch < 10)
+                    {
+                        printf("  fine range %u min %u adc %u: fixed %u float %u\r\n",
+                               fine_range, min[i] << ADC_OVERSAMPLE_BITS, adc_fine_list[i], adc_normalized_fine[i], expect);
+                    }
+                    mismatch++;
+                }
+            }
+        }
+    }
+
+    HOST_CHECK_INT(mismatch, 0);
+
+    memcpy(max_min_adc, backup, sizeof(backup));
+    Normalization_Update_Scale();
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     max <= min 的校准表按 range = 1 处理，不除零
+//-------------------------------------------------------------------------------------------------------------------
+void test_normalization_degenerate_range(void)
+{
+    uint16 backup[2*CHANNEL_NUMBER];
+    uint8 i;
+
+    memcpy(backup, max_min_adc, sizeof(backup));
+
+    for(i = 0; i < CHANNEL_NUMBER; i++)
+    {
+        max_min_adc[2*i] = 1000;
+        max_min_adc[2*i+1] = 1000 + i;
+        adc_val_list[i] = 1001 + i;
+        adc_fine_list[i] = (1001 + i) << ADC_OVERSAMPLE_BITS;
+    }
+    Normalization_Update_Scale();
+    Normalization();
+    Normalization_Fine();
+
+    for(i = 0; i < CHANNEL_NUMBER; i++)
+    {
+        HOST_CHECK_INT(adc_normalized_list[i], NORMALIZATION_MAX);
+        HOST_CHECK_INT(adc_normalized_fine[i], NORMALIZATION_FINE_MAX);
+    }
+
+    memcpy(max_min_adc, backup, sizeof(backup));
+    Normalization_Update_Scale();
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     校准值更新期间的归一化
+//-------------------------------------------------------------------------------------------------------------------
+void test_normalization_calib_update(void)
+{
+    uint16 backup[2*CHANNEL_NUMBER];
+    uint16 x;
+    uint32 expect;
+    uint32 mismatch;
+    uint8 i;
+
+    memcpy(backup, max_min_adc, sizeof(backup));
+
+    // 旧校准 1000 ~ 1400，新校准 200 ~ 3800
+    for(i = 0; i < CHANNEL_NUMBER; i++)
+    {
+        max_min_adc[2*i] = 1400;
+        max_min_adc[2*i+1] = 1000;
+    }
+    Normalization_Update_Scale();
+
+    for(i = 0; i < CHANNEL_NUMBER; i++)
+    {
+        max_min_adc[2*i] = 3800;
+        max_min_adc[2*i+1] = 200;
+    }
+
+    // 缩放表还没有重新计算: 全部输入按旧校准归一化，输出不超过上限
+    mismatch = 0;
+    for(x = 0; x <= 4095; x++)
+    {
+        for(i = 0; i < CHANNEL_NUMBER; i++)
+        {
+            adc_val_list[i] = x;
+            adc_fine_list[i] = x << ADC_OVERSAMPLE_BITS;
+        }
+        Normalization();
+        Normalization_Fine();
+        expect = (x <= 1000) ? 0 : (x >= 1400) ? 400 : (x - 1000);
+        for(i = 0; i < CHANNEL_NUMBER; i++)
+        {
+            if(adc_normalized_list[i] != expect * NORMALIZATION_MAX / 400 ||
+               adc_normalized_fine[i] != expect * NORMALIZATION_FINE_MAX / 400)
+            {
+                mismatch++;
+            }
+        }
+    }
+    HOST_CHECK_INT(mismatch, 0);
+
+    // 重新计算后下一次归一化使用新校准
+    Normalization_Update_Scale();
+    adc_val_list[0] = 2000;
+    adc_fine_list[0] = 2000 << ADC_OVERSAMPLE_BITS;
+    Normalization();
+    Normalization_Fine();
+    HOST_CHECK_INT(adc_normalized_list[0], 1800 * 50 / 3600);
+    HOST_CHECK_INT(adc_normalized_fine[0], 1800 * 1000 / 3600);
+
+    memcpy(max_min_adc, backup, sizeof(backup));
+    Normalization_Update_Scale();
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     后台扫描时采样帧的时间戳为扫描中断完成该帧的时刻，不是控制任务读取的时刻
+//-------------------------------------------------------------------------------------------------------------------
+void test_normalization_frame_stamp(void)
+{
+#if(ADC_USE_SCAN)
+    adc_frame_t frame;
+    uint16 seq;
+
+    myeeprom_init();
+    mock_adc_irq_handler = Adc_Scan_Isr;
+    Adc_All_Init();
+    Adc_Frame_Update();
+    Adc_Frame_Snapshot(&frame);
+    seq = frame.seq;
+    timebase_init();
+
+    // 两帧分别在 1000us 和 1500us 完成，9000us 读取时使用最近一帧
+    mock_set_time_us(1000);
+    mock_adc_run(CHANNEL_NUMBER * ADC_SCAN_DEPTH);
+    mock_set_time_us(1500);
+    mock_adc_run(CHANNEL_NUMBER * ADC_SCAN_DEPTH);
+    mock_set_time_us(9000);
+    Adc_Frame_Update();
+    Adc_Frame_Snapshot(&frame);
+    HOST_CHECK_INT(frame.seq, (uint16)(seq + 1));
+    HOST_CHECK_INT(frame.stamp, 1500);
+
+    // 没有新帧时不更新
+    mock_set_time_us(19000);
+    Adc_Frame_Update();
+    Adc_Frame_Snapshot(&frame);
+    HOST_CHECK_INT(frame.seq, (uint16)(seq + 1));
+    HOST_CHECK_INT(frame.stamp, 1500);
+
+    // 跨过 TIM4 回绕完成的帧
+    mock_set_time_us(70000);
+    mock_adc_run(CHANNEL_NUMBER * ADC_SCAN_DEPTH);
+    mock_set_time_us(80000);
+    Adc_Frame_Update();
+    Adc_Frame_Snapshot(&frame);
+    HOST_CHECK_INT(frame.stamp, 70000);
+#endif
+}
@@ -0,0 +1,106 @@
+//-------------------------------------------------------------------------------------------------------------------
+// 头文件包含
+//-------------------------------------------------------------------------------------------------------------------
+#include "host_test.h"
+#include "myeeprom.h"
+
+//-------------------------------------------------------------------------------------------------------------------
+// 说明
+//-------------------------------------------------------------------------------------------------------------------
+// 控制任务超时降级: 不在 OVERRUN_CONTROL_TASKS 中的任务超时只计数；每次降级后连续 OVERRUN_RECOVER_TICKS
+// 个方向控制周期没有超时则解除并重新累计，分散的超时不会累计到严重超时；降级期间连续超时才停止电机
+// 最后一次超时由调度器执行一个超过一个节拍的任务产生 (执行时间测量到超时处理的完整路径)
+// 严重超时之后不能恢复，本测试放在测试表最后
+
+//-------------------------------------------------------------------------------------------------------------------
+// 私有变量
+//-------------------------------------------------------------------------------------------------------------------
+static void test_overrun_idle(void)
+{
+}
+
+static void test_overrun_slow_speed(void)
+{
+    mock_set_time_us(mock_get_time_us() + 2300);                // 超出预算，也超过一个节拍
+}
+
+// 与 main.c 前台任务表的下标相同: 0-direction 1-speed
+static const sched_task_t test_overrun_fg[] =
+{
+    {"direction",  test_overrun_idle,        1,  0,  0,  2000},
+    {"speed",      test_overrun_slow_speed,  1,  0,  1,  1000},
+};
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     运行方向控制任务
+// 参数说明     ticks           周期数
+//-------------------------------------------------------------------------------------------------------------------
+static void test_overrun_ticks(uint16 ticks)
+{
+    uint16 i;
+
+    for(i = 0; i < ticks; i++)
+    {
+        direction_control_task();
+    }
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     超时降级、恢复和严重超时
+//-------------------------------------------------------------------------------------------------------------------
+void test_overrun_recover(void)
+{
+    uint16 total;
+    uint8 episode;
+    uint8 i;
+
+    myeeprom_init();
+    Motor_Init();
+    Adc_All_Init();
+    Encoder_Init();
+    imu_init();
+    control_mode_init();
+
+    // imu 任务 (下标2) 超时只计数
+    total = control_overrun_count();
+    control_overrun_handler(2, 2500);
+    HOST_CHECK_INT(control_overrun_count(), total + 1);
+    HOST_CHECK_INT(control_overrun_flags(), 0);
+
+    // 每次3个超时，中间恢复，总数超过 OVERRUN_HARD_COUNT 也不是严重超时
+    for(episode = 0; episode < OVERRUN_HARD_COUNT; episode++)
+    {
+        for(i = 0; i < 3; i++)
+        {
+            control_overrun_handler(episode & 1, 1500);
+        }
+        HOST_CHECK_INT(control_overrun_flags(), OVERRUN_POLICY & (OVERRUN_ACTION_SKIP_OPTIONAL | OVERRUN_ACTION_DEGRADE));
+
+        test_overrun_ticks(OVERRUN_RECOVER_TICKS - 1);
+        HOST_CHECK_INT(control_overrun_flags(), OVERRUN_POLICY & (OVERRUN_ACTION_SKIP_OPTIONAL | OVERRUN_ACTION_DEGRADE));
+        test_overrun_ticks(1);
+        HOST_CHECK_INT(control_overrun_flags(), 0);
+    }
+
+    // 降级期间累计 OVERRUN_HARD_COUNT 次超时停止电机，之后不再恢复
+    for(i = 0; i < OVERRUN_HARD_COUNT - 1; i++)
+    {
+        control_overrun_handler(0, 1500);
+        test_overrun_ticks(1);
+    }
+    HOST_CHECK((control_overrun_flags() & OVERRUN_FLAG_FAULT) == 0);
+    total = control_overrun_count();
+    timebase_init();
+    scheduler_init(test_overrun_fg, 2, NULL, 0);
+    sched_overrun_handler = control_overrun_handler;
+    mock_set_time_us(100);
+    scheduler_tick();
+    sched_overrun_handler = NULL;
+    HOST_CHECK_INT(control_overrun_count(), total + 1);
+    HOST_CHECK(control_overrun_flags() & OVERRUN_FLAG_FAULT);
+    HOST_CHECK_INT(mock_pwm_duty[PWM_L], 0);
+    HOST_CHECK_INT(mock_pwm_duty[PWM_R], 0);
+
+    test_overrun_ticks(OVERRUN_RECOVER_TICKS);
+    HOST_CHECK(control_overrun_flags() & OVERRUN_FLAG_FAULT);
+}
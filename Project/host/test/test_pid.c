@@ -0,0 +1,175 @@
+//-------------------------------------------------------------------------------------------------------------------
+// 头文件包含
+//-------------------------------------------------------------------------------------------------------------------
+#include "host_test.h"
+
+//-------------------------------------------------------------------------------------------------------------------
+// 说明
+//-------------------------------------------------------------------------------------------------------------------
+// Q16.16 定点PID与浮点PID对照
+//   q16_mul: 随机和边界值与 double 乘积向零取整 (溢出饱和) 完全一致
+//   增量式PID: 同一编码器序列 (目标速度附近的随机值、阶跃、反转) 输入浮点和定点PID，输出差不超过 0.01 (PWM 1%的1/100)
+//   参数同步: pid_fixed_sync_motor() 只写影子副本，下一次 motor_pid_control() 开始时应用
+
+//-------------------------------------------------------------------------------------------------------------------
+// 宏定义
+//-------------------------------------------------------------------------------------------------------------------
+#define TEST_PID_MUL_SAMPLES    (200000)
+#define TEST_PID_STEPS          (20000)
+
+//-------------------------------------------------------------------------------------------------------------------
+// 私有变量
+//-------------------------------------------------------------------------------------------------------------------
+static uint32 test_pid_seed = 1;
+
+static uint32 test_pid_rand(void)
+{
+    test_pid_seed = test_pid_seed * 1103515245u + 12345u;
+    return test_pid_seed;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     q16_mul 的参考值
+//-------------------------------------------------------------------------------------------------------------------
+static q16_t test_pid_mul_ref(q16_t a, q16_t b)
+{
+    double p;
+
+    p = (double)a * (double)b / 65536.0;
+    p = (p >= 0) ? floor(p) : ceil(p);
+    if(p > (double)Q16_MAX)
+    {
+        return Q16_MAX;
+    }
+    if(p < (double)Q16_MIN)
+    {
+        return Q16_MIN;
+    }
+    return (q16_t)p;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     第 n 步的编码器输入
+//-------------------------------------------------------------------------------------------------------------------
+static int16 test_pid_input(uint32 n)
+{
+    int16 base;
+
+    // 每2000步切换一次工况: 目标附近抖动 / 停转 / 反转 / 全速
+    switch((n / 2000) % 4)
+    {
+        case 0:  base = 30;  break;
+        case 1:  base = 0;   break;
+        case 2:  base = -20; break;
+        default: base = 80;  break;
+    }
+    return base + (int16)(test_pid_rand() >> 16) % 7 - 3;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     q16_mul 与 double 对照
+//-------------------------------------------------------------------------------------------------------------------
+void test_pid_q16_mul(void)
+{
+    static const q16_t edge[] = {0, 1, -1, Q16_ONE, -Q16_ONE, Q16_MAX, Q16_MIN, 0x7FFF, 0x8000, 0x10001, -0x10001,
+                                 0x7FFFFFFFL / 3, 0x00B504F3L, -0x00B504F3L, 0x00B504F4L};
+    q16_t a;
+    q16_t b;
+    uint32 fail;
+    uint32 i;
+    uint8 j;
+    uint8 k;
+
+    fail = 0;
+    for(j = 0; j < sizeof(edge) / sizeof(edge[0]); j++)
+    {
+        for(k = 0; k < sizeof(edge) / sizeof(edge[0]); k++)
+        {
+            if(q16_mul(edge[j], edge[k]) != test_pid_mul_ref(edge[j], edge[k]))
+            {
+                fail++;
+            }
+        }
+    }
+
+    for(i = 0; i < TEST_PID_MUL_SAMPLES; i++)
+    {
+        // 随机位数，覆盖小数、整数和溢出范围
+        a = (q16_t)test_pid_rand() >> (test_pid_rand() >> 27);
+        b = (q16_t)test_pid_rand() >> (test_pid_rand() >> 27);
+        if(q16_mul(a, b) != test_pid_mul_ref(a, b))
+        {
+            fail++;
+        }
+    }
+    HOST_CHECK_INT(fail, 0);
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     定点增量式PID与浮点对照
+//-------------------------------------------------------------------------------------------------------------------
+void test_pid_fixed_vs_float(void)
+{
+    pid_param_t pid;
+    pid_fixed_t fx;
+    float out;
+    float out_fx;
+    float err;
+    float err_max;
+    int16 input;
+    uint32 i;
+
+    pid_init(&pid, 1.7f, 0.22f, 0.2f);
+    pid.target = 30.0f;
+    memset(&fx, 0, sizeof(fx));
+    pid_fixed_sync(&fx, &pid);
+
+    err_max = 0;
+    for(i = 0; i < TEST_PID_STEPS; i++)
+    {
+        input = test_pid_input(i);
+        out = pid_calc_increment(&pid, input);
+        out_fx = q16_to_float(pid_fixed_calc_increment(&fx, Q16_FROM_INT(input)));
+        err = fabsf(out - out_fx);
+        if(err > err_max)
+        {
+            err_max = err;
+        }
+    }
+    printf("  pid increment max error %.5f\r\n", err_max);
+    HOST_CHECK(err_max < 0.01f);
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     定点PID参数在速度控制中应用
+//-------------------------------------------------------------------------------------------------------------------
+void test_pid_fixed_sync_shadow(void)
+{
+    Motor_Init();
+    pid_init(&pid_motor_left, 1.0f, 0.1f, 0.0f);
+    pid_init(&pid_motor_right, 1.0f, 0.1f, 0.0f);
+    pid_fixed_sync_motor();
+    motor_pid_control(0, 0);
+    HOST_CHECK_INT(pid_fixed_left.kp, Q16_ONE);
+
+    // 主循环修改参数: 速度控制之前定点PID不变，之后左右同时更新
+    pid_motor_left.kp = 2.0f;
+    pid_motor_right.kp = 3.0f;
+    pid_motor_left.target = 30.0f;
+    pid_motor_right.target = 30.0f;
+    pid_fixed_sync_motor();
+    HOST_CHECK_INT(pid_fixed_left.kp, Q16_ONE);
+    HOST_CHECK_INT(pid_fixed_right.kp, Q16_ONE);
+    HOST_CHECK_INT(pid_fixed_left.target, 0);
+
+    motor_pid_control(30, 30);
+    HOST_CHECK_INT(pid_fixed_left.kp, 2 * Q16_ONE);
+    HOST_CHECK_INT(pid_fixed_right.kp, 3 * Q16_ONE);
+    HOST_CHECK_INT(pid_fixed_left.target, Q16_FROM_INT(30));
+    HOST_CHECK_INT(pid_fixed_right.target, Q16_FROM_INT(30));
+
+    // 运行状态保持，再次计算不重复应用
+    pid_motor_left.kp = 5.0f;
+    motor_pid_control(30, 30);
+    HOST_CHECK_INT(pid_fixed_left.kp, 2 * Q16_ONE);
+}
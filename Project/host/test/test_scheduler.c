@@ -0,0 +1,157 @@
+//-------------------------------------------------------------------------------------------------------------------
+// 头文件包含
+//-------------------------------------------------------------------------------------------------------------------
+#include "host_test.h"
+
+//-------------------------------------------------------------------------------------------------------------------
+// 说明
+//-------------------------------------------------------------------------------------------------------------------
+// 调度器节拍定时器: TIM1 为 1T 模式、不分频，重装载值对应 SCHED_TICK_MS，计数不小于 32768 时断言失败
+// 赛道误差统计的周期与方向控制任务周期一致
+// 执行时间测量: 任务推进 mock 时间 (超过一个节拍)，统计和超时回调得到完整的执行时间
+// 节拍统计: 进入中断的延迟 (节拍定时器计数) 加上中断执行时间，超过一个节拍计为节拍超时
+
+//-------------------------------------------------------------------------------------------------------------------
+// 私有变量
+//-------------------------------------------------------------------------------------------------------------------
+static uint32 test_sched_runs = 0;
+
+static void test_sched_task(void)
+{
+    test_sched_runs++;
+}
+
+static const sched_task_t test_sched_fg[] =
+{
+    {"task",  test_sched_task,  CONTROL_DIRECTION_PERIOD,  0,  0,  0},
+};
+
+static uint16 test_sched_busy_us = 0;                           // 下一次执行的时间
+static uint8 test_sched_overrun_index = 0xFF;                   // 最近一次超时回调的参数
+static uint16 test_sched_overrun_us = 0;
+
+static void test_sched_busy_task(void)
+{
+    mock_set_time_us(mock_get_time_us() + test_sched_busy_us);
+}
+
+static void test_sched_overrun(uint8 index, uint16 us)
+{
+    test_sched_overrun_index = index;
+    test_sched_overrun_us = us;
+}
+
+static const sched_task_t test_sched_busy_fg[] =
+{
+    {"idle",  test_sched_task,       1,  0,  0,  0},
+    {"busy",  test_sched_busy_task,  1,  0,  1,  2000},
+};
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     节拍定时器配置
+//-------------------------------------------------------------------------------------------------------------------
+void test_scheduler_timer(void)
+{
+    uint16 reload;
+    uint16 i;
+
+    TM1PS = 0x55;
+    TMOD = 0xF5;
+    scheduler_init(test_sched_fg, 1, NULL, 0);
+    reload = (uint16)(65536UL - SCHED_TICK_MS * (SYSTEM_CLOCK_30M / 1000));
+    HOST_CHECK_INT(mock_assert_count, 0);
+    HOST_CHECK_INT(TM1PS, 0);
+    HOST_CHECK_INT(TMOD, 0x05);
+    HOST_CHECK(AUXR & 0x40);
+    HOST_CHECK_INT(TH1, reload >> 8);
+    HOST_CHECK_INT(TL1, reload & 0xFF);
+    HOST_CHECK(TR1 && ET1);
+
+    // 方向控制周期的节拍数与误差统计周期一致
+    test_sched_runs = 0;
+    for(i = 0; i < 1000; i++)
+    {
+        scheduler_tick();
+    }
+    HOST_CHECK_INT(test_sched_runs * TRACK_METRICS_PERIOD_MS, 1000 * SCHED_TICK_MS);
+
+    // 一个节拍超过 32767 计数 (库函数会设置预分频) 时断言失败
+    clock_init(40000000);
+    scheduler_init(test_sched_fg, 1, NULL, 0);
+    HOST_CHECK_INT(mock_assert_count, 1);
+    clock_init(SYSTEM_CLOCK_30M);
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     超过一个节拍的执行时间和超时回调
+//-------------------------------------------------------------------------------------------------------------------
+void test_scheduler_overrun(void)
+{
+    sched_stat_t stat;
+
+    timebase_init();
+    scheduler_init(test_sched_busy_fg, 2, NULL, 0);
+    sched_overrun_handler = test_sched_overrun;
+
+    // 节拍开始 0.1ms 后执行，预算之内不回调
+    mock_set_time_us(100);
+    test_sched_busy_us = 1800;
+    scheduler_tick();
+    HOST_CHECK_INT(test_sched_overrun_index, 0xFF);
+    scheduler_get_stat(SCHED_FOREGROUND, 1, &stat);
+    HOST_CHECK_INT(stat.last_us, 1800);
+
+    // 2.3ms: 超过一个节拍，按完整时间超出预算
+    test_sched_busy_us = 2300;
+    scheduler_tick();
+    HOST_CHECK_INT(test_sched_overrun_index, 1);
+    HOST_CHECK_INT(test_sched_overrun_us, 2300);
+
+    // 超过 OVERRUN_HARD_US，跨 timebase 低16位回绕
+    mock_set_time_us(65000);
+    test_sched_busy_us = OVERRUN_HARD_US + 300;
+    scheduler_tick();
+    HOST_CHECK_INT(test_sched_overrun_us, OVERRUN_HARD_US + 300);
+    HOST_CHECK(test_sched_overrun_us > OVERRUN_HARD_US);
+
+    scheduler_get_stat(SCHED_FOREGROUND, 1, &stat);
+    HOST_CHECK_INT(stat.runs, 3);
+    HOST_CHECK_INT(stat.overruns, 2);
+    HOST_CHECK_INT(stat.max_us, OVERRUN_HARD_US + 300);
+    scheduler_get_stat(SCHED_FOREGROUND, 0, &stat);
+    HOST_CHECK_INT(stat.overruns, 0);
+
+    sched_overrun_handler = NULL;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     节拍统计
+//-------------------------------------------------------------------------------------------------------------------
+void test_scheduler_tick_stat(void)
+{
+    sched_stat_t stat;
+    uint16 timer;
+
+    timebase_init();
+    scheduler_init(test_sched_busy_fg, 2, NULL, 0);
+
+    // 进入中断延迟 50us (节拍定时器已计数 1500)，前台任务 300us
+    timer = (uint16)(65536UL - SCHED_TICK_MS * (SYSTEM_CLOCK_30M / 1000) + 1500);
+    TH1 = (uint8)(timer >> 8);
+    TL1 = (uint8)timer;
+    mock_set_time_us(1000);
+    test_sched_busy_us = 300;
+    scheduler_tick();
+    scheduler_get_stat(SCHED_TICK, 0, &stat);
+    HOST_CHECK_INT(stat.last_us, 350);
+    HOST_CHECK_INT(stat.overruns, 0);
+
+    // 前台任务 2.3ms: 节拍超时，时间不回绕到一个节拍之内
+    test_sched_busy_us = 2300;
+    scheduler_tick();
+    scheduler_get_stat(SCHED_TICK, 0, &stat);
+    HOST_CHECK_INT(stat.last_us, 2350);
+    HOST_CHECK_INT(stat.max_us, 2350);
+    HOST_CHECK_INT(stat.overruns, 1);
+    HOST_CHECK_INT(stat.runs, 2);
+}
@@ -0,0 +1,29 @@
+//-------------------------------------------------------------------------------------------------------------------
+// 头文件包含
+//-------------------------------------------------------------------------------------------------------------------
+#include "host_test.h"
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     timebase 32位时间经过 TIM4 16位回绕后连续
+//-------------------------------------------------------------------------------------------------------------------
+void test_timebase_wrap(void)
+{
+    uint32 t;
+
+    timebase_init();
+    HOST_CHECK_INT(timebase_now_us(), 0);
+
+    for(t = 0; t < 300000; t += 997)
+    {
+        mock_set_time_us(t);
+        HOST_CHECK_INT(timebase_now_us(), t);
+    }
+
+    // 溢出标志已置位但中断还没执行: 计数值较小时补加高16位
+    mock_set_time_us(0x2FFF0);
+    T4H = 0x00;
+    T4L = 0x10;
+    AUXINTIF |= 0x04;
+    HOST_CHECK_INT(timebase_now_us(), 0x30010);
+    TIM4_CLEAR_FLAG;
+}
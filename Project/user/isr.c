@@ -71,6 +71,16 @@ void DMA_UART1_IRQHandler(void) interrupt 4
         // 如果进入了这个中断，则代表UART的数据在没有取走之前被覆盖!
         // 如果进入了这个中断，则代表UART的数据在没有取走之前被覆盖!
     }
+
+    if ((DMA_UR1T_CFG & 0x80) && (DMA_UR1T_STA & 0x01)) // 发送完成 (只处理 uart_write_buffer_dma 开启的中断)
+    {
+        DMA_UR1T_STA &= ~0x01; // 清标志位
+
+        if (uart1_dma_tx_irq_handler != NULL)
+        {
+            uart1_dma_tx_irq_handler();
+        }
+    }
 }
 
 void DMA_UART2_IRQHandler(void) interrupt 8
@@ -94,6 +104,16 @@ void DMA_UART2_IRQHandler(void) interrupt 8
         // 如果进入了这个中断，则代表UART的数据在没有取走之前被覆盖!
         // 如果进入了这个中断，则代表UART的数据在没有取走之前被覆盖!
     }
+
+    if ((DMA_UR2T_CFG & 0x80) && (DMA_UR2T_STA & 0x01)) // 发送完成 (只处理 uart_write_buffer_dma 开启的中断)
+    {
+        DMA_UR2T_STA &= ~0x01; // 清标志位
+
+        if (uart2_dma_tx_irq_handler != NULL)
+        {
+            uart2_dma_tx_irq_handler();
+        }
+    }
 }
 
 void DMA_UART3_IRQHandler(void) interrupt 17
@@ -117,6 +137,16 @@ void DMA_UART3_IRQHandler(void) interrupt 17
         // 如果进入了这个中断，则代表UART的数据在没有取走之前被覆盖!
         // 如果进入了这个中断，则代表UART的数据在没有取走之前被覆盖!
     }
+
+    if ((DMA_UR3T_CFG & 0x80) && (DMA_UR3T_STA & 0x01)) // 发送完成 (只处理 uart_write_buffer_dma 开启的中断)
+    {
+        DMA_UR3T_STA &= ~0x01; // 清标志位
+
+        if (uart3_dma_tx_irq_handler != NULL)
+        {
+            uart3_dma_tx_irq_handler();
+        }
+    }
 }
 
 void DMA_UART4_IRQHandler(void) interrupt 18
@@ -140,6 +170,37 @@ void DMA_UART4_IRQHandler(void) interrupt 18
         // 如果进入了这个中断，则代表UART的数据在没有取走之前被覆盖!
         // 如果进入了这个中断，则代表UART的数据在没有取走之前被覆盖!
     }
+
+    if ((DMA_UR4T_CFG & 0x80) && (DMA_UR4T_STA & 0x01)) // 发送完成 (只处理 uart_write_buffer_dma 开启的中断)
+    {
+        DMA_UR4T_STA &= ~0x01; // 清标志位
+
+        if (uart4_dma_tx_irq_handler != NULL)
+        {
+            uart4_dma_tx_irq_handler();
+        }
+    }
+}
+
+// SPI DMA 中断 (向量49) 由 stc32g_isr.asm 跳转到 SPI 中断入口
+void DMA_SPI_IRQHandler(void) interrupt 9
+{
+    if (DMA_SPI_STA & 0x01) // 传输完成
+    {
+        DMA_SPI_STA &= ~0x01; // 清标志位
+        DMA_SPI_CR = 0x00;    // 关闭SPI DMA，其他SPI读写恢复查询方式
+
+        if (spi_dma_irq_handler != NULL)
+        {
+            spi_dma_irq_handler();
+        }
+    }
+}
+
+void ADC_IRQHandler(void) interrupt 5
+{
+    // ADC后台扫描: 保存转换结果并启动下一通道 (详见 code/adc.c)
+    Adc_Scan_Isr();
 }
 
 void TM0_IRQHandler() interrupt 1
@@ -192,6 +253,56 @@ void TM4_IRQHandler() interrupt 20
     }
 }
 
+void INT0_IRQHandler() interrupt 0
+{
+    INT0_CLEAR_FLAG;
+
+    if (int0_irq_handler != NULL)
+    {
+        int0_irq_handler();
+    }
+}
+
+void INT1_IRQHandler() interrupt 2
+{
+    INT1_CLEAR_FLAG;
+
+    if (int1_irq_handler != NULL)
+    {
+        int1_irq_handler();
+    }
+}
+
+void INT2_IRQHandler() interrupt 10
+{
+    INT2_CLEAR_FLAG;
+
+    if (int2_irq_handler != NULL)
+    {
+        int2_irq_handler();
+    }
+}
+
+void INT3_IRQHandler() interrupt 11
+{
+    INT3_CLEAR_FLAG;
+
+    if (int3_irq_handler != NULL)
+    {
+        int3_irq_handler();
+    }
+}
+
+void INT4_IRQHandler() interrupt 16
+{
+    INT4_CLEAR_FLAG;
+
+    if (int4_irq_handler != NULL)
+    {
+        int4_irq_handler();
+    }
+}
+
 
 //#define     INT0_VECTOR             0       //0003H
 //#define     TMR0_VECTOR             1       //000BH
@@ -45,21 +45,64 @@
 #include "../code/key.h"
 
 
-#define PIT_CH_1                          (TIM1_PIT)                 // 使用的周期中断编号 如果修改 需要同步对应修改周期中断编号与 isr.c 中的调用
-#define PIT_CH_2                          (TIM2_PIT)                 // 使用的周期中断编号 如果修改 需要同步对应修改周期中断编号与 isr.c 中的调用
+void telemetry_task(void);
+void gyro_bias_save_task(void);
+void exti_handler_imu(void);
 
-void pit_handler_1(void);
-void pit_handler_2(void);
+// 前台任务表: 在 1ms 节拍中断中执行 (同一节拍按优先级依次执行)
+// 执行时间预算为初始值，根据 scheduler_get_stat() 统计的最大执行时间调整
+// 下标 0/1 (direction、speed) 与 task.h 中的 OVERRUN_CONTROL_TASKS 对应，调整顺序时一起修改
+static const sched_task_t fg_tasks[] =
+{
+    // 名称        任务函数                  周期(ms)                   相位               优先级  预算(us)
+    {"direction",  direction_control_task,  CONTROL_DIRECTION_PERIOD,  0,                 0,      2000},
+    {"speed",      speed_control_task,      CONTROL_SPEED_PERIOD,      0,                 1,      1000},
+#if(!IMU_USE_FIFO)
+    {"imu",        imu_update_task,         IMU_UPDATE_PERIOD,         IMU_UPDATE_PHASE,  2,      2000},
+#endif
+};
+
+// 后台任务表: 在主循环中执行 (不阻塞，到期后依次执行)
+static const sched_task_t bg_tasks[] =
+{
+    {"telemetry",  telemetry_task,          100,                       0,                 1,      0},
+    {"ui",         UI_MenuUpdate,           100,                       50,                0,      0},
+    {"gyro_bias",  gyro_bias_save_task,     500,                       250,               2,      0},
+#if(PROFILER_ENABLE)
+    {"profiler",   profiler_service,        20,                        0,                 3,      0},
+#endif
+};
 
 float left_target = 0;										//左轮目标值
 float right_target = 0;								 	//右轮目标值
 uint8 imu_state = 0;                                          // IMU初始化状态
 
+// 主循环显示用的传感器快照 (数据由中断写入，主循环只读快照)
+adc_frame_t adc_frame_view;
+encoder_frame_t encoder_view;
+struct IMUData imu_main_view;
+#if(TRACK_METRICS_ENABLE)
+track_metrics_t metrics_view;
+uint16 metrics_laps_printed = 0;                              // 已输出的圈数
+#endif
+gyro_bias_info_t gyro_bias_view;
+sched_stat_t sched_view;
+#if DEBUG_UART_TX_ASYNC
+debug_tx_stat_struct debug_tx_view;
+#endif
+
 void main()
 {
     clock_init(SYSTEM_CLOCK_30M);
     debug_init();
+
+    // ========== 微秒时间基准 (TIM4 1MHz 自由运行，采样时间戳和执行时间统计使用) ==========
+    tim4_irq_handler = timebase_overflow_handler;
+    timebase_init();
 	
+    // ========== EEPROM 初始化 (Adc_All_Init 需要从 EEPROM 加载校准表，必须先初始化) ==========
+    myeeprom_init();
+
     key_init();
     Motor_Init();
     Adc_All_Init();
@@ -68,9 +111,6 @@ void main()
     // ========== OLED 初始化 ==========
     UI_Init();
 
-    // ========== EEPROM 初始化 ==========
-    myeeprom_init();
-
     // IMU660RB初始化
     imu_state = imu_init();
     if(imu_state == 0)
@@ -82,12 +122,9 @@ void main()
         printf("IMU init failed!\r\n");
     }
 
-    // ========== 控制器初始化 (根据 task.h 中的 CONTROL_MODE_CURRENT 选择模式) ==========
-
-    // SDSD初始化 (用于 SDSD 控制模式)
-    SDSD_init(&SDSD, 1.0f, 1.0f, 1.0f);
-    pid_init(&pid_SDSD, 2.0f, 0.0f, 0.5f);    // SDSD的PID参数: Kp=2.0, Ki=0, Kd=0.5
-    pid_SDSD.target = 0;                      // SDSD期望偏差为0(居中)
+    // ========== 控制器初始化 (根据 task.h 中的 CONTROL_SELECT_METHOD / CONTROL_MODE_CURRENT 选择模式) ==========
+    // SDSD、PD方向环、四元数姿态控制器的参数在 task.c 控制模式表各模式的 init 中初始化
+    control_mode_init();
 
     // ========== 电机速度环PID初始化 (从 EEPROM 加载或使用默认值) ==========
     // 尝试从 EEPROM 加载 PID 参数，如果失败则使用默认值
@@ -107,85 +144,139 @@ void main()
     pid_motor_left.target = 30.0f;   // 左电机目标速度
     pid_motor_right.target = 30.0f;  // 右电机目标速度
 
-    // ========== 姿态控制初始化 ==========
-    // PD方向环+角速度环初始化 (用于 PD方向环控制模式)
-    // Kp=2.5, Kd=0.8 (方向环) | Kp_gyro=1.2, Kd_gyro=0.3 (角速度环)
-    pd_init(&pd_direction, 2.5f, 0.8f, 1.2f, 0.3f);
-
-    // 四元数姿态控制器初始化 (用于 四元数姿态控制模式)
-    // 目标姿态: roll=0, pitch=0, yaw=0 (保持水平直行)
-    // Kp_dir=2.5, Kd_dir=0.8 (方向环) | Kp_gyro=1.2, Kd_gyro=0.3 (角速度环)
-    attitude_init(0.0f, 0.0f, 0.0f, 2.5f, 0.8f, 1.2f, 0.3f);
+    // 速度环定点PID从浮点参数同步 (系数、目标速度、限幅)
+    pid_fixed_sync_motor();
 
     // ========== PID 菜单初始化 ==========
     UI_MenuInit();
 
 // 此处编写用户代码 例如外设初始化代码等
-    tim1_irq_handler = pit_handler_1;					  	//重写tim0中断处理函数
-		tim2_irq_handler = pit_handler_2;					  	//重写tim0中断处理函数
-
-    pit_ms_init(PIT_CH_1,10);                		// 初始化 PIT 为周期中断 10ms 周期
-		pit_ms_init(PIT_CH_2,10);                		// 初始化 PIT 为周期中断 10ms 周期 (100Hz IMU更新)
+    // 控制任务、IMU更新 (非FIFO模式)、显示和按键都由调度器按任务表周期执行，节拍定时器为 TIM1 (1ms)
+    PROFILER_INIT();                            // 执行时间统计 (调试串口发送 'p' 输出报告)
+    tim1_irq_handler = scheduler_tick;
+    sched_overrun_handler = control_overrun_handler;   // 控制任务超时按 task.h 中的 OVERRUN_POLICY 降级
+    scheduler_init(fg_tasks, sizeof(fg_tasks) / sizeof(fg_tasks[0]), bg_tasks, sizeof(bg_tasks) / sizeof(bg_tasks[0]));
+#if(IMU_USE_FIFO)
+    int2_irq_handler = exti_handler_imu;        // IMU660RB INT1 接 IMU_FIFO_INT_PIN (INT2_P36)
+    imu_fifo_start();                           // 清空FIFO并开启外部中断 (FIFO水位中断中更新IMU)
+#endif
 
     while(1)
     {
         // 此处编写需要循环执行的代码
+        // 执行到期的后台任务 (显示、按键、EEPROM保存)，控制任务在节拍中断中执行
+        scheduler_run_background();
+    }
+}
 
-        // 获取ADC值 (使用快速去极值平均滤波 - 推荐)
-        Adc_Getval_Fast();
-        Normalization();
-
-        // 打印当前控制模式和传感器数据
-        printf("模式: %s | ADC: %d,%d,%d,%d,%d\r\n",
-               get_mode_name(get_control_mode()),
-               adc_normalized_list[0],
-               adc_normalized_list[1],
-               adc_normalized_list[2],
-               adc_normalized_list[3],
-               adc_normalized_list[4]);
-
-        // 打印编码器数据
-        printf("Encoder: R=%d, L=%d\r\n", encoder_data_dir_R, encoder_data_dir_L);
-
-        // 打印IMU四元数和欧拉角数据
-        printf("Quaternion: q0=%.3f, q1=%.3f, q2=%.3f, q3=%.3f\r\n",
-               imu.q0, imu.q1, imu.q2, imu.q3);
-        printf("Euler: Roll=%.2f, Pitch=%.2f, Yaw=%.2f\r\n",
-               imu.roll, imu.pitch, imu.yaw);
-
-        // ========== PID 菜单显示 ==========
-        // 显示速度环PID参数，支持按键调节
-        // KEY1: 切换参数项 | KEY2: 减小 | KEY3: 增大 | KEY4: 保存到EEPROM
-        UI_MenuUpdate();
-
-        // 延时避免打印过快
-        system_delay_ms(100);
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     串口数据输出任务
+// 参数说明     void
+// 返回参数     void
+// 使用示例     telemetry_task();
+// 备注信息     后台任务，100ms周期
+//              传感器数据由中断更新，读取快照保证每组数据来自同一次更新
+//              控制任务超时降级期间 (OVERRUN_ACTION_SKIP_OPTIONAL) 只输出超时状态
+//-------------------------------------------------------------------------------------------------------------------
+void telemetry_task (void)
+{
+    uint8 flags;
+    uint8 i;
+
+    // 控制任务超时状态 (降级/严重超时时每次输出)
+    flags = control_overrun_flags();
+    if(flags != 0)
+    {
+        scheduler_get_stat(SCHED_TICK, 0, &sched_view);
+        printf("Overrun: flags=0x%02X, total=%u, tick max=%uus over=%u%s\r\n",
+               (uint16)flags, control_overrun_count(), sched_view.max_us, sched_view.overruns,
+               (flags & OVERRUN_FLAG_FAULT) ? ", MOTOR STOPPED" : "");
+    }
+    if(flags & OVERRUN_ACTION_SKIP_OPTIONAL)
+    {
+        return;                                 // 降级期间跳过欧拉角计算和传感器数据输出
+    }
+
+    Adc_Frame_Snapshot(&adc_frame_view);
+    Encoder_Get_Snapshot(&encoder_view);
+    imu_get_snapshot(&imu_main_view);
+
+    // 打印当前控制模式和传感器数据
+    printf("模式: %s | ADC: %d,%d,%d,%d,%d\r\n",
+           get_mode_name(get_control_mode()),
+           adc_frame_view.normalized[0],
+           adc_frame_view.normalized[1],
+           adc_frame_view.normalized[2],
+           adc_frame_view.normalized[3],
+           adc_frame_view.normalized[4]);
+
+    // 打印编码器数据
+    printf("Encoder: R=%d, L=%d\r\n", encoder_view.right, encoder_view.left);
+
+    // 打印IMU四元数和欧拉角数据 (欧拉角在这里由快照中的四元数计算)
+    imu_get_euler(&imu_main_view);
+    printf("Quaternion: q0=%.3f, q1=%.3f, q2=%.3f, q3=%.3f\r\n",
+           imu_main_view.q0, imu_main_view.q1, imu_main_view.q2, imu_main_view.q3);
+    printf("Euler: Roll=%.2f, Pitch=%.2f, Yaw=%.2f\r\n",
+           imu_main_view.roll, imu_main_view.pitch, imu_main_view.yaw);
+    printf("IMU: stamp=%luus, dt=%uus\r\n", imu_main_view.stamp, imu_main_view.dt_us);
+
+    // 打印前台任务执行时间 (最大值 / 超出预算次数)
+    for(i = 0; scheduler_get_stat(SCHED_FOREGROUND, i, &sched_view) == 0; i++)
+    {
+        printf("Task %s: last=%uus, max=%uus, over=%u\r\n",
+               fg_tasks[i].name, sched_view.last_us, sched_view.max_us, sched_view.overruns);
     }
+
+#if DEBUG_UART_TX_ASYNC
+    // 打印调试串口发送统计 (有丢弃时减少输出或增大 DEBUG_TX_BUFFER_LEN)
+    debug_tx_get_stat(&debug_tx_view);
+    printf("UART TX: sent=%lu, drop=%lu, peak=%u/%u, block=%u\r\n",
+           debug_tx_view.sent, debug_tx_view.dropped, debug_tx_view.peak, DEBUG_TX_BUFFER_LEN, debug_tx_view.blocked);
+#endif
+
+#if(TRACK_METRICS_ENABLE)
+    // 完成一圈后输出圈时和误差统计 (PID菜单界面按 KEY4 标记一圈结束)
+    Track_Metrics_Snapshot(&metrics_view);
+    if(metrics_view.laps != metrics_laps_printed)
+    {
+        metrics_laps_printed = metrics_view.laps;
+        printf("Lap %d: time=%.2fs, sensor rms=%.2f, sensor peak=%.2f, lost=%lu\r\n",
+               metrics_view.laps,
+               track_run_time(&metrics_view.last_lap),
+               track_run_sensor_rms(&metrics_view.last_lap),
+               metrics_view.last_lap.sensor_peak,
+               metrics_view.last_lap.lost_ticks);
+    }
+#endif
 }
+
 //-------------------------------------------------------------------------------------------------------------------
-// 函数简介     PIT 的周期中断处理函数 这个函数将在 PIT 对应的定时器中断调用 详见 isr.c
+// 函数简介     陀螺仪零偏保存任务
 // 参数说明     void
 // 返回参数     void
-// 使用示例     pit_handler();
-// 备注信息     10ms周期中断，处理编码器采集和电机控制
+// 使用示例     gyro_bias_save_task();
+// 备注信息     后台任务，500ms周期，零偏标定完成或漂移较大时在静止状态下保存到 EEPROM
 //-------------------------------------------------------------------------------------------------------------------
-void pit_handler_1 (void)
+void gyro_bias_save_task (void)
 {
-    // 调用电机控制任务 (封装在task.c中)
-    // 功能: 编码器采集 -> ADC判断 -> PD控制 -> 电机输出
-    motor_control_task();
+    if(gyro_bias_service())
+    {
+        gyro_bias_get_snapshot(&gyro_bias_view);
+        printf("Gyro bias saved: %.2f, %.2f, %.2f LSB\r\n",
+               gyro_bias_view.bias[0] / 256.0f, gyro_bias_view.bias[1] / 256.0f, gyro_bias_view.bias[2] / 256.0f);
+    }
 }
 
 //-------------------------------------------------------------------------------------------------------------------
-// 函数简介     PIT 的周期中断处理函数 这个函数将在 PIT 对应的定时器中断调用 详见 isr.c
+// 函数简介     IMU660RB FIFO 水位外部中断处理函数 这个函数将在 INT2 中断调用 详见 isr.c
 // 参数说明     void
 // 返回参数     void
-// 使用示例     pit_handler();
-// 备注信息     10ms周期中断，更新IMU数据 (100Hz)
+// 使用示例     exti_handler_imu();
+// 备注信息     IMU_USE_FIFO 为1时使用，FIFO存满 IMU660RB_FIFO_WATERMARK 个字 (约9.6ms) 触发一次
 //-------------------------------------------------------------------------------------------------------------------
-void pit_handler_2 (void)
+void exti_handler_imu (void)
 {
-    // 调用IMU更新任务 (封装在task.c中)
-    // 功能: 获取IMU原始数据 -> 四元数解算 -> 欧拉角更新
+    // 读空FIFO并逐个采样解算姿态
     imu_update_task();
 }